@@ -1,6 +1,6 @@
 Name:       libcynara-commons
 Summary:    Cynara service with client libraries
-Version:    0.14.10
+Version:    0.14.11
 Release:    1
 Group:      Security/Application Privilege
 License:    Apache-2.0
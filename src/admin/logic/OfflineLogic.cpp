@@ -29,6 +29,7 @@
 
 #include <common.h>
 #include <config/PathConfig.h>
+#include <exceptions/BucketLinkCycleException.h>
 #include <exceptions/BucketNotExistsException.h>
 #include <exceptions/DatabaseBusyException.h>
 #include <exceptions/DatabaseCorruptedException.h>
@@ -91,11 +92,12 @@ int OfflineLogic::setPolicies(const ApiInterface::PoliciesByBucket &insertOrUpda
         acquireDatabase();
         acquirePlugins();
         checkPoliciesTypes(insertOrUpdate, true, false);
-        m_storage->insertPolicies(insertOrUpdate);
-        m_storage->deletePolicies(remove);
+        m_storage->setPolicies(insertOrUpdate, remove);
         onPoliciesChanged();
     } catch (const BucketNotExistsException &) {
         return CYNARA_API_BUCKET_NOT_FOUND;
+    } catch (const BucketLinkCycleException &) {
+        return CYNARA_API_OPERATION_NOT_ALLOWED;
     } catch (const DatabaseException &) {
         return CYNARA_API_OPERATION_FAILED;
     } catch (const DatabaseCorruptedException &) {
@@ -30,6 +30,7 @@
 #include <string>
 #include <unistd.h>
 
+#include <crc32c.h>
 #include <cynara-error.h>
 #include <md5wrapper.h>
 
@@ -48,8 +49,12 @@ enum CommandLineOption {
 const char OptionRequiresParameter = ':';
 const int CommandLineExtraParameter = 1;
 
-const std::string OPTION_MD5   = "md5";
-const std::string OPTION_CRYPT = "crypt";
+const std::string OPTION_MD5    = "md5";
+const std::string OPTION_CRYPT  = "crypt";
+const std::string OPTION_CRC32C = "crc32c";
+
+// Tag telling the algorithm to Cynara's ChecksumValidator
+const std::string CRC32C_TAG = "$crc32c$";
 
 void printHelp(const char *exeName) {
     static int done = 0;
@@ -58,8 +63,8 @@ void printHelp(const char *exeName) {
                "Options:\n"
                "\t-" << static_cast<char>(CommandLineOption::Algorithm) <<
                " ALGORITHM   use selected algorith to count hash. Currently this "
-               "tool supports 'crypt' and 'md5'. 'crypt' is used as the default value " <<
-               "for backward compatibility." << std::endl <<
+               "tool supports 'crypt', 'md5' and 'crc32c'. 'crypt' is used as the default " <<
+               "value for backward compatibility." << std::endl <<
                "\t-" << static_cast<char>(CommandLineOption::Help) <<
                "             print this help" << std::endl;
         done = 1;
@@ -143,6 +148,8 @@ const std::string ChecksumGenerator::generate(const std::string &data) const {
         return generateCrypt(data);
     if (m_algorithm == OPTION_MD5)
         return generateMD5(data);
+    if (m_algorithm == OPTION_CRC32C)
+        return CRC32C_TAG + generateCRC32C(data);
 
     throw std::runtime_error("Unknown option value.");
 };
@@ -23,6 +23,8 @@
  */
 
 #include <new>
+#include <string>
+#include <vector>
 
 #include <common.h>
 #include <exceptions/TryCatch.h>
@@ -226,6 +228,49 @@ int cynara_async_create_simple_request(cynara_async *p_cynara, const char *clien
     });
 }
 
+CYNARA_API
+int cynara_async_create_batch_request(cynara_async *p_cynara, const char *client,
+                                      const char *client_session, const char *user,
+                                      const char *const *privileges, size_t count, int *results,
+                                      cynara_check_id *p_check_id,
+                                      cynara_response_callback callback,
+                                      void *user_response_data) {
+    if (!p_cynara || !p_cynara->impl)
+        return CYNARA_API_INVALID_PARAM;
+    if (!isStringValid(client) || !isStringValid(client_session) || !isStringValid(user))
+        return CYNARA_API_INVALID_PARAM;
+    if (!privileges || !results || !count || count > CYNARA_MAX_VECTOR_SIZE)
+        return CYNARA_API_INVALID_PARAM;
+    for (size_t i = 0; i < count; ++i) {
+        if (!isStringValid(privileges[i]))
+            return CYNARA_API_INVALID_PARAM;
+    }
+
+    return Cynara::tryCatch([&]() {
+        std::string clientStr;
+        std::string clientSessionStr;
+        std::string userStr;
+        std::vector<std::string> privilegesStr;
+
+        try {
+            clientStr = client;
+            clientSessionStr = client_session;
+            userStr = user;
+            privilegesStr.assign(privileges, privileges + count);
+        } catch (const std::length_error &e) {
+            LOGE("%s", e.what());
+            return CYNARA_API_INVALID_PARAM;
+        }
+        cynara_check_id checkId;
+        int ret = p_cynara->impl->createBatchRequest(clientStr, clientSessionStr, userStr,
+                                                     privilegesStr, results, checkId, callback,
+                                                     user_response_data);
+        if (p_check_id && ret == CYNARA_API_SUCCESS)
+            *p_check_id = checkId;
+        return ret;
+    });
+}
+
 CYNARA_API
 int cynara_async_process(cynara_async *p_cynara) {
     if (!p_cynara || !p_cynara->impl)
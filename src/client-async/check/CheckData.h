@@ -24,8 +24,10 @@
 #ifndef SRC_CLIENT_ASYNC_CHECK_CHECKDATA_H_
 #define SRC_CLIENT_ASYNC_CHECK_CHECKDATA_H_
 
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <types/PolicyKey.h>
 
@@ -38,12 +40,23 @@ class CheckData
 public:
     CheckData(const PolicyKey &key, const std::string &session, const ResponseCallback &callback,
               bool simple)
-        : m_key(key), m_session(session), m_callback(callback), m_simple(simple), m_cancelled(false)
+        : m_key(key), m_session(session), m_callback(callback), m_simple(simple), m_cancelled(false),
+          m_batchResults(nullptr)
+    {}
+    // Batch check is simple check of keys missed in cache; key() is the first checked key.
+    // Result of batchKeys()[i] is stored in results[batchIndexes()[i]].
+    CheckData(const PolicyKey &key, std::vector<PolicyKey> &&keys,
+              std::vector<std::size_t> &&indexes, const std::string &session,
+              const ResponseCallback &callback, int *results)
+        : m_key(key), m_session(session), m_callback(callback), m_simple(true),
+          m_cancelled(false), m_batchKeys(std::move(keys)), m_batchIndexes(std::move(indexes)),
+          m_batchResults(results)
     {}
     CheckData(CheckData &&other)
         : m_key(std::move(other.m_key)), m_session(std::move(other.m_session)),
           m_callback(std::move(other.m_callback)), m_simple(other.m_simple),
-          m_cancelled(other.m_cancelled) {
+          m_cancelled(other.m_cancelled), m_batchKeys(std::move(other.m_batchKeys)),
+          m_batchIndexes(std::move(other.m_batchIndexes)), m_batchResults(other.m_batchResults) {
         other.m_cancelled = false;
     }
     ~CheckData() {}
@@ -64,6 +77,27 @@ public:
         return m_simple;
     }
 
+    bool isBatch(void) const {
+        return m_batchResults != nullptr;
+    }
+
+    const std::vector<PolicyKey> &batchKeys(void) const {
+        return m_batchKeys;
+    }
+
+    const std::vector<std::size_t> &batchIndexes(void) const {
+        return m_batchIndexes;
+    }
+
+    // Batch answered whole from cache is not sent to service
+    bool isAnsweredFromCache(void) const {
+        return isBatch() && m_batchKeys.empty();
+    }
+
+    int *batchResults(void) const {
+        return m_batchResults;
+    }
+
     bool cancelled(void) const {
         return m_cancelled;
     }
@@ -78,6 +112,9 @@ private:
     ResponseCallback m_callback;
     bool m_simple;
     bool m_cancelled;
+    std::vector<PolicyKey> m_batchKeys;
+    std::vector<std::size_t> m_batchIndexes;
+    int *m_batchResults;
 };
 
 } // namespace Cynara
@@ -25,6 +25,8 @@
 
 #include <cinttypes>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <cache/CapacityCache.h>
 #include <common.h>
@@ -36,11 +38,13 @@
 #include <plugins/NaiveInterpreter.h>
 #include <protocol/ProtocolClient.h>
 #include <request/CancelRequest.h>
+#include <request/CheckBatchRequest.h>
 #include <request/CheckRequest.h>
 #include <request/MonitorEntriesPutRequest.h>
 #include <request/MonitorEntryPutRequest.h>
 #include <request/SimpleCheckRequest.h>
 #include <response/CancelResponse.h>
+#include <response/CheckBatchResponse.h>
 #include <response/CheckResponse.h>
 #include <response/SimpleCheckResponse.h>
 #include <sockets/Socket.h>
@@ -100,14 +104,15 @@ int Logic::checkCache(const std::string &client, const std::string &session,
     if (!checkCacheValid())
         return CYNARA_API_CACHE_MISS;
 
-    auto ret = m_cache.get(session, PolicyKey(client, user, privilege));
+    PolicyKey key(client, user, privilege, PolicyKeyFeature::Uninterned());
+    auto ret = m_cache.get(session, key);
 
     if (m_monitoringEnabled) {
         // Cache returns only CYNARA_API_ACCESS_ALLOWED, CYNARA_API_ACCESS_DENIED
         // and CYNARA_API_CACHE_MISS. The condition below must be revamped,
         // if this invariant changes.
         if (ret != CYNARA_API_CACHE_MISS) {
-            updateMonitor({client, user, privilege}, ret);
+            updateMonitor(key, ret);
         }
 
         if (m_monitorCache.shouldFlush()) {
@@ -148,14 +153,57 @@ int Logic::createRequest(bool simple, const std::string &client, const std::stri
     if (!m_sequenceContainer.get(sequenceNumber))
         return CYNARA_API_MAX_PENDING_REQUESTS;
 
-    PolicyKey key(client, user, privilege);
+    PolicyKey key(client, user, privilege, PolicyKeyFeature::Uninterned());
     ResponseCallback responseCallback(callback, userResponseData);
-    m_checks.insert(CheckPair(sequenceNumber, CheckData(key, session, responseCallback,
-                                                        simple)));
-    if (simple)
-        m_socketClient.appendRequest(SimpleCheckRequest(key, sequenceNumber));
-    else
-        m_socketClient.appendRequest(CheckRequest(key, sequenceNumber));
+    auto it = m_checks.insert(CheckPair(sequenceNumber, CheckData(key, session, responseCallback,
+                                                                  simple))).first;
+    appendCheckRequest(sequenceNumber, it->second);
+
+    onStatusChange(m_socketClient.getSockFd(), cynara_async_status::CYNARA_STATUS_FOR_RW);
+    checkId = static_cast<cynara_check_id>(sequenceNumber);
+
+    return CYNARA_API_SUCCESS;
+}
+
+int Logic::createBatchRequest(const std::string &client, const std::string &session,
+                              const std::string &user,
+                              const std::vector<std::string> &privileges, int *results,
+                              cynara_check_id &checkId, cynara_response_callback callback,
+                              void *userResponseData) {
+    if (!m_operationPermitted)
+        return CYNARA_API_OPERATION_NOT_ALLOWED;
+
+    if (!ensureConnection())
+        return CYNARA_API_SERVICE_NOT_AVAILABLE;
+
+    ProtocolFrameSequenceNumber sequenceNumber;
+    if (!m_sequenceContainer.get(sequenceNumber))
+        return CYNARA_API_MAX_PENDING_REQUESTS;
+
+    // Privileges found in cache are answered at once, only missed ones are sent to service
+    std::vector<PolicyKey> missedKeys;
+    std::vector<size_t> missedIndexes;
+    for (size_t i = 0; i < privileges.size(); ++i) {
+        PolicyKey key(client, user, privileges[i], PolicyKeyFeature::Uninterned());
+        int ret = m_cache.get(session, key);
+        if (ret != CYNARA_API_CACHE_MISS) {
+            updateMonitor(key, ret);
+            results[i] = ret;
+            continue;
+        }
+        missedKeys.push_back(std::move(key));
+        missedIndexes.push_back(i);
+    }
+
+    ResponseCallback responseCallback(callback, userResponseData);
+    PolicyKey firstKey(client, user, privileges.front(), PolicyKeyFeature::Uninterned());
+    auto it = m_checks.insert(CheckPair(sequenceNumber,
+                                        CheckData(firstKey, std::move(missedKeys),
+                                                  std::move(missedIndexes), session,
+                                                  responseCallback, results))).first;
+    // Batch answered from cache waits for process() to call callback
+    if (!it->second.isAnsweredFromCache())
+        appendCheckRequest(sequenceNumber, it->second);
 
     onStatusChange(m_socketClient.getSockFd(), cynara_async_status::CYNARA_STATUS_FOR_RW);
     checkId = static_cast<cynara_check_id>(sequenceNumber);
@@ -167,6 +215,8 @@ int Logic::process(void) {
     if (!m_operationPermitted)
         return CYNARA_API_OPERATION_NOT_ALLOWED;
 
+    processCachedAnswers();
+
     bool completed;
     while (true) {
         int ret = completeConnection(completed);
@@ -191,7 +241,8 @@ int Logic::cancelRequest(cynara_check_id checkId) {
     if (it == m_checks.end() || it->second.cancelled())
         return CYNARA_API_INVALID_PARAM;
 
-    m_socketClient.appendRequest(CancelRequest(it->first));
+    if (!it->second.isAnsweredFromCache())
+        m_socketClient.appendRequest(CancelRequest(it->first));
 
     it->second.cancel();
 
@@ -219,15 +270,23 @@ void Logic::prepareRequestsToSend(void) {
             m_sequenceContainer.release(it->first);
             it = m_checks.erase(it);
         } else {
-            if (it->second.isSimple())
-                m_socketClient.appendRequest(SimpleCheckRequest(it->second.key(), it->first));
-            else
-                m_socketClient.appendRequest(CheckRequest(it->second.key(), it->first));
+            if (!it->second.isAnsweredFromCache())
+                appendCheckRequest(it->first, it->second);
             ++it;
         }
     }
 }
 
+void Logic::appendCheckRequest(ProtocolFrameSequenceNumber sequenceNumber,
+                               const CheckData &checkData) {
+    if (checkData.isBatch())
+        m_socketClient.appendRequest(CheckBatchRequest(checkData.batchKeys(), sequenceNumber));
+    else if (checkData.isSimple())
+        m_socketClient.appendRequest(SimpleCheckRequest(checkData.key(), sequenceNumber));
+    else
+        m_socketClient.appendRequest(CheckRequest(checkData.key(), sequenceNumber));
+}
+
 bool Logic::processOut(void) {
     switch (m_socketClient.sendToCynara()) {
         case Socket::SendStatus::ALL_DATA_SENT:
@@ -302,6 +361,71 @@ void Logic::processSimpleCheckResponse(const SimpleCheckResponse &response) {
     }
 }
 
+void Logic::processCheckBatchResponse(const CheckBatchResponse &response) {
+    const auto &retValues = response.getReturnValues();
+    const auto &policyResults = response.getResults();
+    LOGD("checkBatchResponse: number of results = [%zu]", policyResults.size());
+
+    auto it = checkResponseValid(response);
+    const auto &keys = it->second.batchKeys();
+    const auto &indexes = it->second.batchIndexes();
+    if (!it->second.isBatch() || retValues.size() != keys.size()
+        || policyResults.size() != keys.size()) {
+        LOGC("Critical error. CheckBatchResponse does not match request: sequenceNumber = "
+             "[%" PRIu16 "]", response.sequenceNumber());
+        throw UnexpectedErrorException("Unexpected response from cynara service");
+    }
+
+    // Results array of cancelled request may be already released by user, so it is not filled
+    int *results = it->second.cancelled() ? nullptr : it->second.batchResults();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        int result = retValues[i];
+        if (result == CYNARA_API_SUCCESS) {
+            result = m_cache.update(it->second.session(), keys[i], policyResults[i]);
+            updateMonitor(keys[i], result);
+        }
+        if (results)
+            results[indexes[i]] = result;
+    }
+
+    CheckData checkData(std::move(it->second));
+    releaseRequest(it);
+
+    if (!checkData.cancelled()) {
+        bool onAnswerCancel = m_inAnswerCancelResponseCallback;
+        m_inAnswerCancelResponseCallback = true;
+        checkData.callback().onAnswer(
+            static_cast<cynara_check_id>(response.sequenceNumber()), CYNARA_API_SUCCESS);
+        m_inAnswerCancelResponseCallback = onAnswerCancel;
+    }
+}
+
+void Logic::processCachedAnswers(void) {
+    // Callbacks may create or drop requests, so checks are looked up one by one
+    std::vector<ProtocolFrameSequenceNumber> answered;
+    for (const auto &kv : m_checks) {
+        if (kv.second.isAnsweredFromCache())
+            answered.push_back(kv.first);
+    }
+
+    for (auto sequenceNumber : answered) {
+        auto it = m_checks.find(sequenceNumber);
+        if (it == m_checks.end() || !it->second.isAnsweredFromCache())
+            continue;
+
+        CheckData checkData(std::move(it->second));
+        releaseRequest(it);
+
+        if (!checkData.cancelled()) {
+            bool onAnswerCancel = m_inAnswerCancelResponseCallback;
+            m_inAnswerCancelResponseCallback = true;
+            checkData.callback().onAnswer(static_cast<cynara_check_id>(sequenceNumber),
+                                          CYNARA_API_SUCCESS);
+            m_inAnswerCancelResponseCallback = onAnswerCancel;
+        }
+    }
+}
+
 void Logic::processCancelResponse(const CancelResponse &cancelResponse) {
 
     auto it = checkResponseValid(cancelResponse);
@@ -318,6 +442,7 @@ void Logic::processResponses(void) {
     CheckResponsePtr checkResponse;
     CancelResponsePtr cancelResponse;
     SimpleCheckResponsePtr simpleResponse;
+    CheckBatchResponsePtr batchResponse;
     while ((response = m_socketClient.getResponse())) {
         checkResponse = std::dynamic_pointer_cast<CheckResponse>(response);
         if (checkResponse) {
@@ -337,6 +462,12 @@ void Logic::processResponses(void) {
             continue;
         }
 
+        batchResponse = std::dynamic_pointer_cast<CheckBatchResponse>(response);
+        if (batchResponse) {
+            processCheckBatchResponse(*batchResponse);
+            continue;
+        }
+
         LOGC("Critical error. Casting Response to known response failed.");
         throw UnexpectedErrorException("Unexpected response from cynara service");
     }
@@ -27,6 +27,8 @@
 #define SRC_CLIENT_ASYNC_LOGIC_LOGIC_H_
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <cache/CacheInterface.h>
 #include <cache/MonitorCache.h>
@@ -61,6 +63,11 @@ public:
                                     const std::string &user, const std::string &privilege,
                                     cynara_check_id &checkId, cynara_response_callback callback,
                                     void *userResponseData);
+    virtual int createBatchRequest(const std::string &client, const std::string &session,
+                                   const std::string &user,
+                                   const std::vector<std::string> &privileges, int *results,
+                                   cynara_check_id &checkId, cynara_response_callback callback,
+                                   void *userResponseData);
     virtual int process(void);
     virtual int cancelRequest(cynara_check_id checkId);
     virtual bool isFinishPermitted(void);
@@ -90,7 +97,11 @@ private:
     bool processOut(void);
     CheckMap::iterator checkResponseValid(const Response &response);
     void releaseRequest(CheckMap::iterator reqIt);
+    void appendCheckRequest(ProtocolFrameSequenceNumber sequenceNumber,
+                            const CheckData &checkData);
     void processCheckResponse(const CheckResponse &checkResponse);
+    void processCheckBatchResponse(const CheckBatchResponse &response);
+    void processCachedAnswers(void);
     void processCancelResponse(const CancelResponse &cancelResponse);
     void processSimpleCheckResponse(const SimpleCheckResponse &response);
     void processResponses(void);
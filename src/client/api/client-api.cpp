@@ -22,7 +22,10 @@
  * @brief       Implementation of external libcynara-client API
  */
 
+#include <algorithm>
 #include <new>
+#include <string>
+#include <vector>
 
 #include <common.h>
 #include <exceptions/TryCatch.h>
@@ -181,3 +184,45 @@ int cynara_simple_check(cynara *p_cynara, const char *client, const char *client
         return p_cynara->impl->simpleCheck(clientStr, clientSessionStr, userStr, privilegeStr);
     });
 }
+
+CYNARA_API
+int cynara_check_batch(cynara *p_cynara, const char *client, const char *client_session,
+                       const char *user, const char *const *privileges, size_t count,
+                       int *results) {
+    if (!p_cynara || !p_cynara->impl)
+        return CYNARA_API_INVALID_PARAM;
+    if (!isStringValid(client) || !isStringValid(client_session) || !isStringValid(user))
+        return CYNARA_API_INVALID_PARAM;
+    if (!privileges || !results || !count || count > CYNARA_MAX_VECTOR_SIZE)
+        return CYNARA_API_INVALID_PARAM;
+    for (size_t i = 0; i < count; ++i) {
+        if (!isStringValid(privileges[i]))
+            return CYNARA_API_INVALID_PARAM;
+    }
+
+    return Cynara::tryCatch([&]() {
+        std::string clientStr;
+        std::string clientSessionStr;
+        std::string userStr;
+        std::vector<std::string> privilegesStr;
+        std::vector<int> resultsVec;
+
+        try {
+            clientStr = client;
+            clientSessionStr = client_session;
+            userStr = user;
+            privilegesStr.assign(privileges, privileges + count);
+        } catch (const std::length_error &e) {
+            LOGE("%s", e.what());
+            return CYNARA_API_INVALID_PARAM;
+        }
+
+        int ret = p_cynara->impl->checkBatch(clientStr, clientSessionStr, userStr, privilegesStr,
+                                             resultsVec);
+        if (ret != CYNARA_API_SUCCESS)
+            return ret;
+
+        std::copy(resultsVec.begin(), resultsVec.end(), results);
+        return CYNARA_API_SUCCESS;
+    });
+}
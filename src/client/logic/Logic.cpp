@@ -24,6 +24,7 @@
 
 #include <cinttypes>
 #include <memory>
+#include <vector>
 
 #include <cache/CapacityCache.h>
 #include <common.h>
@@ -36,9 +37,11 @@
 #include <protocol/Protocol.h>
 #include <protocol/ProtocolClient.h>
 #include <request/MonitorEntriesPutRequest.h>
+#include <request/CheckBatchRequest.h>
 #include <request/CheckRequest.h>
 #include <request/pointers.h>
 #include <request/SimpleCheckRequest.h>
+#include <response/CheckBatchResponse.h>
 #include <response/CheckResponse.h>
 #include <response/pointers.h>
 #include <response/SimpleCheckResponse.h>
@@ -67,7 +70,7 @@ int Logic::check(const std::string &client, const ClientSession &session, const
     if (!ensureConnection())
         return CYNARA_API_SERVICE_NOT_AVAILABLE;
 
-    PolicyKey key(client, user, privilege);
+    PolicyKey key(client, user, privilege, PolicyKeyFeature::Uninterned());
     int ret = m_cache.get(session, key);
     if (ret != CYNARA_API_CACHE_MISS) {
         updateMonitor(key, ret);
@@ -91,7 +94,7 @@ int Logic::simpleCheck(const std::string &client, const ClientSession &session,
     if (!ensureConnection())
         return CYNARA_API_SERVICE_NOT_AVAILABLE;
 
-    PolicyKey key(client, user, privilege);
+    PolicyKey key(client, user, privilege, PolicyKeyFeature::Uninterned());
     int ret = m_cache.get(session, key);
     if (ret != CYNARA_API_CACHE_MISS) {
         return ret;
@@ -109,6 +112,65 @@ int Logic::simpleCheck(const std::string &client, const ClientSession &session,
     return m_cache.update(session, key, result);
 }
 
+int Logic::checkBatch(const std::string &client, const ClientSession &session,
+                      const std::string &user, const std::vector<std::string> &privileges,
+                      std::vector<int> &results) {
+    if (!ensureConnection())
+        return CYNARA_API_SERVICE_NOT_AVAILABLE;
+
+    results.assign(privileges.size(), CYNARA_API_CACHE_MISS);
+    std::vector<PolicyKey> missedKeys;
+    std::vector<size_t> missedIndexes;
+
+    for (size_t i = 0; i < privileges.size(); ++i) {
+        PolicyKey key(client, user, privileges[i], PolicyKeyFeature::Uninterned());
+        int ret = m_cache.get(session, key);
+        if (ret != CYNARA_API_CACHE_MISS) {
+            updateMonitor(key, ret);
+            results[i] = ret;
+            continue;
+        }
+        missedKeys.push_back(std::move(key));
+        missedIndexes.push_back(i);
+    }
+
+    if (missedKeys.empty())
+        return CYNARA_API_SUCCESS;
+
+    auto checkBatchResponse = requestResponse<CheckBatchRequest, CheckBatchResponse>(missedKeys);
+    if (!checkBatchResponse) {
+        LOGC("Critical error. Requesting CheckBatchResponse failed.");
+        return CYNARA_API_SERVICE_NOT_AVAILABLE;
+    }
+
+    const auto &retValues = checkBatchResponse->getReturnValues();
+    const auto &policyResults = checkBatchResponse->getResults();
+    if (retValues.size() != missedKeys.size() || policyResults.size() != missedKeys.size()) {
+        LOGC("Critical error. CheckBatchResponse does not match request.");
+        return CYNARA_API_UNKNOWN_ERROR;
+    }
+
+    for (size_t i = 0; i < missedKeys.size(); ++i) {
+        const auto &key = missedKeys[i];
+        int &result = results[missedIndexes[i]];
+
+        // Keys needing an agent are resolved the same way, as single check does
+        if (retValues[i] == CYNARA_API_ACCESS_NOT_RESOLVED) {
+            result = check(client, session, user, privileges[missedIndexes[i]]);
+        } else if (retValues[i] == CYNARA_API_SUCCESS) {
+            result = m_cache.update(session, key, policyResults[i]);
+            updateMonitor(key, result);
+        } else {
+            result = retValues[i];
+        }
+
+        if (result < CYNARA_API_SUCCESS)
+            return result;
+    }
+
+    return CYNARA_API_SUCCESS;
+}
+
 bool Logic::ensureConnection(void) {
     if (m_socketClient.isConnected())
         return true;
@@ -119,13 +181,13 @@ bool Logic::ensureConnection(void) {
     return false;
 }
 
-template <typename Req, typename Res>
-std::shared_ptr<Res> Logic::requestResponse(const PolicyKey &key) {
+template <typename Req, typename Res, typename Data>
+std::shared_ptr<Res> Logic::requestResponse(const Data &data) {
     ProtocolFrameSequenceNumber sequenceNumber = generateSequenceNumber();
 
     //Ask cynara service
     std::shared_ptr<Res> reqResponse;
-    Req request(key, sequenceNumber);
+    Req request(data, sequenceNumber);
     ResponsePtr response;
     while (!(response = m_socketClient.askCynaraServer(request))) {
         onDisconnected();
@@ -27,6 +27,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <sockets/SocketClient.h>
 #include <types/PolicyKey.h>
@@ -51,6 +52,9 @@ public:
                       const std::string &user, const std::string &privilege);
     virtual int simpleCheck(const std::string &client, const ClientSession &session,
                             const std::string &user, const std::string &privilege);
+    virtual int checkBatch(const std::string &client, const ClientSession &session,
+                           const std::string &user, const std::vector<std::string> &privileges,
+                           std::vector<int> &results);
     virtual void flushMonitor(void);
 private:
     SocketClient m_socketClient;
@@ -60,8 +64,8 @@ private:
 
     void onDisconnected(void);
     bool ensureConnection(void);
-    template <typename Req, typename Res>
-    std::shared_ptr<Res> requestResponse(const PolicyKey &key);
+    template <typename Req, typename Res, typename Data>
+    std::shared_ptr<Res> requestResponse(const Data &data);
     int requestResult(const PolicyKey &key, PolicyResult &result);
     int requestSimpleResult(const PolicyKey &key, PolicyResult &result);
     bool requestMonitorEntriesPut();
@@ -80,6 +80,8 @@ const std::string lockFile(statePath);
 const std::string indexFilename("buckets");
 const std::string guardFilename("guard");
 const std::string checksumFilename("checksum");
+const std::string journalFilename("journal");
+const std::string imageFilename("image");
 const std::string backupFilenameSuffix("~");
 const std::string bucketFilenamePrefix("_");
 const char fieldSeparator(';');
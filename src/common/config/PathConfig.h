@@ -48,6 +48,8 @@ extern const std::string lockFile;
 extern const std::string indexFilename;
 extern const std::string guardFilename;
 extern const std::string checksumFilename;
+extern const std::string journalFilename;
+extern const std::string imageFilename;
 extern const std::string backupFilenameSuffix;
 extern const std::string bucketFilenamePrefix;
 extern const char fieldSeparator;
@@ -22,10 +22,11 @@
  */
 
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
-#include <malloc.h>
 #include <new>
 #include <stddef.h>
+#include <utility>
 
 #include <attributes/attributes.h>
 #include <exceptions/NullPointerException.h>
@@ -33,16 +34,74 @@
 #include "BinaryQueue.h"
 
 namespace Cynara {
-BinaryQueue::BinaryQueue() : m_size(0) {
+
+namespace {
+
+/*
+ * Chunks released by binary queues are kept for reuse by the thread releasing them,
+ * up to POOL_CAPACITY of them. Pool is not used anymore, once it is destroyed at thread exit.
+ */
+class ChunkPool {
+public:
+    static const size_t POOL_CAPACITY = 16;
+
+    ChunkPool() : m_count(0) {}
+
+    ~ChunkPool() {
+        while (m_count > 0)
+            ::operator delete(m_chunks[--m_count]);
+        destroyed() = true;
+    }
+
+    char *take(void) {
+        return m_count > 0 ? m_chunks[--m_count] : nullptr;
+    }
+
+    bool give(char *chunk) {
+        if (m_count == POOL_CAPACITY)
+            return false;
+        m_chunks[m_count++] = chunk;
+        return true;
+    }
+
+    static ChunkPool *instance(void) {
+        if (destroyed())
+            return nullptr;
+        thread_local ChunkPool pool;
+        return &pool;
+    }
+
+private:
+    static bool &destroyed(void) {
+        thread_local bool poolDestroyed = false;
+        return poolDestroyed;
+    }
+
+    char *m_chunks[POOL_CAPACITY];
+    size_t m_count;
+};
+
+} // namespace anonymous
+
+const size_t BinaryQueue::CHUNK_SIZE;
+const size_t BinaryQueue::INLINE_CAPACITY;
+
+BinaryQueue::BinaryQueue() : m_head(0), m_count(0), m_size(0), m_reservation(nullptr),
+                             m_reserved(nullptr), m_reservedCapacity(0), m_inlineUsed(false) {
 }
 
-BinaryQueue::BinaryQueue(const BinaryQueue &other) : m_size(0) {
+BinaryQueue::BinaryQueue(const BinaryQueue &other) : m_head(0), m_count(0), m_size(0),
+                             m_reservation(nullptr), m_reserved(nullptr), m_reservedCapacity(0),
+                             m_inlineUsed(false) {
     appendCopyFrom(other);
 }
 
 BinaryQueue::~BinaryQueue() {
     // Remove all remaining buckets
     clear();
+
+    if (m_reserved != nullptr)
+        releaseBuffer(m_reserved, m_reservedCapacity);
 }
 
 const BinaryQueue &BinaryQueue::operator=(const BinaryQueue &other) {
@@ -54,33 +113,127 @@ const BinaryQueue &BinaryQueue::operator=(const BinaryQueue &other) {
     return *this;
 }
 
-void BinaryQueue::appendCopyFrom(const BinaryQueue &other) {
-    // To speed things up, always copy as one bucket
-    void *bufferCopy = malloc(other.m_size);
+void BinaryQueue::setAppendListener(AppendListener listener) {
+    m_appendListener = std::move(listener);
+}
+
+void BinaryQueue::notifyAppend(void) {
+    if (m_appendListener)
+        m_appendListener();
+}
+
+template <typename Copy>
+void BinaryQueue::appendWith(size_t size, Copy copy) {
+    if (size == 0) {
+        return;
+    }
+
+    Bucket *back = writableBack();
+    size_t backBytes = back != nullptr ? std::min(back->space(), size) : 0;
+    size_t rest = size - backBytes;
+    size_t count = m_count;
 
-    if (bufferCopy == nullptr) {
-        throw std::bad_alloc();
+    reserveBuckets(m_count + (rest + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+    back = writableBack();
+    if (backBytes > 0) {
+        copy(back->end(), backBytes);
+        back->size += backBytes;
+        back->left += backBytes;
     }
 
     try {
-        other.flatten(bufferCopy, other.m_size);
-        appendUnmanaged(bufferCopy, other.m_size, &bufferDeleterFree, nullptr);
+        while (rest > 0) {
+            if (!m_inlineUsed && rest <= INLINE_CAPACITY) {
+                copy(m_inline, rest);
+                Bucket bucket = ownedBucket(m_inline, rest, INLINE_CAPACITY);
+                bucket.kind = Bucket::Kind::Inline;
+                pushBack(bucket);
+                m_inlineUsed = true;
+                break;
+            }
+
+            size_t capacity;
+            size_t chunkBytes = std::min(rest, CHUNK_SIZE);
+            char *chunk = allocateBuffer(chunkBytes, capacity);
+            copy(chunk, chunkBytes);
+            pushBack(ownedBucket(chunk, chunkBytes, capacity));
+            rest -= chunkBytes;
+        }
     } catch (const std::bad_alloc &) {
-        // Free allocated memory
-        free(bufferCopy);
+        // Failure leaves binary queue untouched
+        while (m_count > count) {
+            releaseBucket(bucketAt(m_count - 1));
+            --m_count;
+        }
+        if (backBytes > 0) {
+            back->size -= backBytes;
+            back->left -= backBytes;
+        }
         throw;
     }
+
+    m_size += size;
+}
+
+void BinaryQueue::appendData(const void *buffer, size_t bufferSize) {
+    const char *source = static_cast<const char *>(buffer);
+    appendWith(bufferSize, [&source] (char *destination, size_t count) {
+        memcpy(destination, source, count);
+        source += count;
+    });
+}
+
+void BinaryQueue::appendCopyFrom(const BinaryQueue &other) {
+    if (this == &other) {
+        BinaryQueue copy(other);
+        appendMoveFrom(copy);
+        return;
+    }
+
+    // Data is copied bucket after bucket straight to its place in this binary queue
+    size_t index = 0;
+    size_t offset = 0;
+    appendWith(other.m_size, [&other, &index, &offset] (char *destination, size_t count) {
+        while (count > 0) {
+            const Bucket &bucket = other.bucketAt(index);
+            size_t chunk = std::min(count, bucket.left - offset);
+            memcpy(destination, bucket.ptr + offset, chunk);
+            destination += chunk;
+            count -= chunk;
+            offset += chunk;
+            if (offset == bucket.left) {
+                ++index;
+                offset = 0;
+            }
+        }
+    });
+
+    if (other.m_size > 0)
+        notifyAppend();
 }
 
 void BinaryQueue::appendMoveFrom(BinaryQueue &other) {
-    // Copy all buckets
-    std::copy(other.m_buckets.begin(),
-              other.m_buckets.end(), std::back_inserter(m_buckets));
+    if (this == &other || other.m_count == 0) {
+        return;
+    }
+
+    // Inline storage stays with other binary queue, so its data has to be moved out of it
+    other.detachInline();
+    reserveBuckets(m_count + other.m_count);
+
+    // Move all buckets
+    for (size_t i = 0; i < other.m_count; ++i) {
+        pushBack(other.bucketAt(i));
+    }
     m_size += other.m_size;
 
     // Clear other, but do not free memory
-    other.m_buckets.clear();
+    other.m_head = 0;
+    other.m_count = 0;
     other.m_size = 0;
+
+    notifyAppend();
 }
 
 void BinaryQueue::appendCopyTo(BinaryQueue &other) const {
@@ -92,31 +245,19 @@ void BinaryQueue::appendMoveTo(BinaryQueue &other) {
 }
 
 void BinaryQueue::clear() {
-    std::for_each(m_buckets.begin(), m_buckets.end(), &deleteBucket);
-    m_buckets.clear();
+    for (size_t i = 0; i < m_count; ++i) {
+        releaseBucket(bucketAt(i));
+    }
+    m_head = 0;
+    m_count = 0;
     m_size = 0;
 }
 
 void BinaryQueue::appendCopy(const void* buffer, size_t bufferSize) {
-    // Create data copy with malloc/free
-    void *bufferCopy = malloc(bufferSize);
-
-    // Check if allocation succeded
-    if (bufferCopy == nullptr) {
-        throw std::bad_alloc();
-    }
+    appendData(buffer, bufferSize);
 
-    // Copy user data
-    memcpy(bufferCopy, buffer, bufferSize);
-
-    try {
-        // Try to append new bucket
-        appendUnmanaged(bufferCopy, bufferSize, &bufferDeleterFree, nullptr);
-    } catch (const std::bad_alloc &) {
-        // Free allocated memory
-        free(bufferCopy);
-        throw;
-    }
+    if (bufferSize > 0)
+        notifyAppend();
 }
 
 void BinaryQueue::appendUnmanaged(const void* buffer,
@@ -129,17 +270,84 @@ void BinaryQueue::appendUnmanaged(const void* buffer,
         return;
     }
 
+    if (buffer == nullptr)
+        throw NullPointerException("data");
+
+    if (deleter == nullptr)
+        throw NullPointerException("dataDeleter");
+
     // Just add new bucket with selected deleter
-    Bucket *bucket = new Bucket(buffer, bufferSize, deleter, userParam);
-    try {
-        m_buckets.push_back(bucket);
-    } catch (const std::bad_alloc &) {
-        delete bucket;
-        throw;
-    }
+    reserveBuckets(m_count + 1);
+    const char *data = static_cast<const char *>(buffer);
+    pushBack(Bucket{Bucket::Kind::Unmanaged, data, data, bufferSize, bufferSize, bufferSize,
+                    deleter, userParam});
 
     // Increase total queue size
     m_size += bufferSize;
+
+    notifyAppend();
+}
+
+void *BinaryQueue::appendReserve(size_t size) {
+    Bucket *back = writableBack();
+    if (back != nullptr && back->space() >= size) {
+        m_reservation = back->end();
+        return m_reservation;
+    }
+
+    // Buffer reserved before, but not used, is kept for next reservation
+    if (m_reserved == nullptr || m_reservedCapacity < size) {
+        size_t capacity;
+        char *buffer = allocateBuffer(size, capacity);
+        if (m_reserved != nullptr)
+            releaseBuffer(m_reserved, m_reservedCapacity);
+        m_reserved = buffer;
+        m_reservedCapacity = capacity;
+    }
+
+    m_reservation = m_reserved;
+    return m_reservation;
+}
+
+void BinaryQueue::appendCommit(size_t size) {
+    if (size == 0) {
+        return;
+    }
+
+    if (m_reserved != nullptr && m_reservation == m_reserved) {
+        reserveBuckets(m_count + 1);
+        pushBack(ownedBucket(m_reserved, size, m_reservedCapacity));
+        m_reserved = nullptr;
+    } else {
+        Bucket &back = bucketAt(m_count - 1);
+        back.size += size;
+        back.left += size;
+    }
+
+    m_reservation = nullptr;
+    m_size += size;
+
+    notifyAppend();
+}
+
+void BinaryQueue::detachInline(void) {
+    if (!m_inlineUsed) {
+        return;
+    }
+
+    for (size_t i = 0; i < m_count; ++i) {
+        Bucket &bucket = bucketAt(i);
+        if (bucket.kind != Bucket::Kind::Inline)
+            continue;
+
+        // Bucket takes copy of its data, so inline storage can be reused
+        size_t capacity;
+        char *buffer = allocateBuffer(bucket.left, capacity);
+        memcpy(buffer, bucket.ptr, bucket.left);
+        bucket = ownedBucket(buffer, bucket.left, capacity);
+        m_inlineUsed = false;
+        return;
+    }
 }
 
 size_t BinaryQueue::size() const {
@@ -161,18 +369,23 @@ void BinaryQueue::consume(size_t size) {
     // Consume data and/or remove buckets
     while (bytesLeft > 0) {
         // Get consume size
-        size_t count = std::min(bytesLeft, m_buckets.front()->left);
+        size_t count = std::min(bytesLeft, front().left);
 
-        m_buckets.front()->ptr =
-            static_cast<const char *>(m_buckets.front()->ptr) + count;
-        m_buckets.front()->left -= count;
+        consumeFront(count);
         bytesLeft -= count;
-        m_size -= count;
+    }
+}
 
-        if (m_buckets.front()->left == 0) {
-            deleteBucket(m_buckets.front());
-            m_buckets.pop_front();
-        }
+void BinaryQueue::consumeFront(size_t size) {
+    Bucket &bucket = front();
+    bucket.ptr += size;
+    bucket.left -= size;
+    m_size -= size;
+
+    if (bucket.left == 0) {
+        releaseBucket(bucket);
+        m_head = (m_head + 1) & (m_ring.size() - 1);
+        --m_count;
     }
 }
 
@@ -187,65 +400,160 @@ void BinaryQueue::flatten(void *buffer, size_t bufferSize) const {
     }
 
     size_t bytesLeft = bufferSize;
-    void *ptr = buffer;
-    BucketList::const_iterator bucketIterator = m_buckets.begin();
+    char *ptr = static_cast<char *>(buffer);
 
     // Flatten data
-    while (bytesLeft > 0) {
-        // Get consume size
-        // todo a check is needed if bucketIterator doesn't point to m_buckets.end()
-        size_t count = std::min(bytesLeft, (*bucketIterator)->left);
+    for (size_t i = 0; bytesLeft > 0; ++i) {
+        const Bucket &bucket = bucketAt(i);
+        size_t count = std::min(bytesLeft, bucket.left);
 
         // Copy data to user pointer
-        memcpy(ptr, (*bucketIterator)->ptr, count);
+        memcpy(ptr, bucket.ptr, count);
 
         // Update flattened bytes count
         bytesLeft -= count;
-        ptr = static_cast<char *>(ptr) + count;
-
-        // Take next bucket
-        ++bucketIterator;
+        ptr += count;
     }
 }
 
 void BinaryQueue::flattenConsume(void *buffer, size_t bufferSize) {
-    // FIXME: Optimize
-    flatten(buffer, bufferSize);
-    consume(bufferSize);
+    // Check parameters
+    if (bufferSize > m_size) {
+        throw OutOfDataException(m_size, bufferSize);
+    }
+
+    size_t bytesLeft = bufferSize;
+    char *ptr = static_cast<char *>(buffer);
+
+    // Copy data and remove it at once
+    while (bytesLeft > 0) {
+        size_t count = std::min(bytesLeft, front().left);
+
+        memcpy(ptr, front().ptr, count);
+        consumeFront(count);
+
+        bytesLeft -= count;
+        ptr += count;
+    }
+}
+
+const void *BinaryQueue::linearize(size_t size) {
+    // Check parameters
+    if (size > m_size) {
+        throw OutOfDataException(m_size, size);
+    }
+
+    if (m_count == 0) {
+        return nullptr;
+    }
+
+    if (front().left >= size) {
+        return front().ptr;
+    }
+
+    // Everything is allocated before data is moved, so failure leaves binary queue untouched
+    size_t capacity;
+    char *merged = allocateBuffer(size, capacity);
+    try {
+        reserveBuckets(m_count + 1);
+    } catch (const std::bad_alloc &) {
+        releaseBuffer(merged, capacity);
+        throw;
+    }
+
+    flattenConsume(merged, size);
+    pushFront(ownedBucket(merged, size, capacity));
+    m_size += size;
+
+    return merged;
 }
 
-void BinaryQueue::deleteBucket(BinaryQueue::Bucket *bucket) {
-    delete bucket;
+size_t BinaryQueue::fillIovec(struct iovec *iov, size_t iovCount) const {
+    size_t filled = std::min(m_count, iovCount);
+    for (size_t i = 0; i < filled; ++i) {
+        const Bucket &bucket = bucketAt(i);
+        iov[i].iov_base = const_cast<char *>(bucket.ptr);
+        iov[i].iov_len = bucket.left;
+    }
+
+    return filled;
 }
 
-void BinaryQueue::bufferDeleterFree(const void* data,
-                                    size_t dataSize UNUSED,
-                                    void* userParam UNUSED) {
-    // Default free deleter
-    free(const_cast<void *>(data));
+void BinaryQueue::reserveBuckets(size_t count) {
+    if (count <= m_ring.size()) {
+        return;
+    }
+
+    // Ring size is a power of two, so positions are wrapped with a mask
+    size_t ringSize = std::max(m_ring.size(), static_cast<size_t>(4));
+    while (ringSize < count) {
+        ringSize *= 2;
+    }
+
+    std::vector<Bucket> ring(ringSize);
+    for (size_t i = 0; i < m_count; ++i) {
+        ring[i] = bucketAt(i);
+    }
+    m_ring.swap(ring);
+    m_head = 0;
 }
 
-BinaryQueue::Bucket::Bucket(const void* data,
-                            size_t dataSize,
-                            BufferDeleter dataDeleter,
-                            void* userParam) :
-    buffer(data),
-    ptr(data),
-    size(dataSize),
-    left(dataSize),
-    deleter(dataDeleter),
-    param(userParam) {
+void BinaryQueue::pushBack(const Bucket &bucket) {
+    m_ring[(m_head + m_count) & (m_ring.size() - 1)] = bucket;
+    ++m_count;
+}
 
-    if(data == nullptr)
-        throw NullPointerException("data");
+void BinaryQueue::pushFront(const Bucket &bucket) {
+    m_head = (m_head - 1) & (m_ring.size() - 1);
+    m_ring[m_head] = bucket;
+    ++m_count;
+}
 
-    if(dataDeleter == nullptr)
-        throw NullPointerException("dataDeleter");
+void BinaryQueue::releaseBucket(Bucket &bucket) {
+    switch (bucket.kind) {
+    case Bucket::Kind::Unmanaged:
+        bucket.deleter(bucket.buffer, bucket.size, bucket.param);
+        break;
+    case Bucket::Kind::Owned:
+        releaseBuffer(const_cast<char *>(bucket.buffer), bucket.capacity);
+        break;
+    case Bucket::Kind::Inline:
+        m_inlineUsed = false;
+        break;
+    }
+}
+
+BinaryQueue::Bucket BinaryQueue::ownedBucket(char *buffer, size_t size, size_t capacity) {
+    return Bucket{Bucket::Kind::Owned, buffer, buffer, size, size, capacity, nullptr, nullptr};
+}
+
+char *BinaryQueue::allocateBuffer(size_t size, size_t &capacity) {
+    if (size > CHUNK_SIZE) {
+        capacity = size;
+        return static_cast<char *>(::operator new(size));
+    }
+
+    capacity = CHUNK_SIZE;
+    ChunkPool *pool = ChunkPool::instance();
+    char *chunk = pool != nullptr ? pool->take() : nullptr;
+    return chunk != nullptr ? chunk : static_cast<char *>(::operator new(CHUNK_SIZE));
 }
 
-BinaryQueue::Bucket::~Bucket() {
-    // Invoke deleter on bucket data
-    deleter(buffer, size, param);
+void BinaryQueue::releaseBuffer(char *buffer, size_t capacity) {
+    if (capacity == CHUNK_SIZE) {
+        ChunkPool *pool = ChunkPool::instance();
+        if (pool != nullptr && pool->give(buffer))
+            return;
+    }
+
+    ::operator delete(buffer);
+}
+
+void BinaryQueue::bufferDeleterFree(const void* data,
+                                    size_t dataSize UNUSED,
+                                    void* userParam UNUSED) {
+    // Default free deleter
+    free(const_cast<void *>(data));
 }
 
 } // namespace Cynara
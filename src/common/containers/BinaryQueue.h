@@ -24,8 +24,11 @@
 #ifndef SRC_COMMON_CONTAINERS_BINARYQUEUE_H_
 #define SRC_COMMON_CONTAINERS_BINARYQUEUE_H_
 
+#include <cstddef>
+#include <functional>
 #include <memory>
-#include <list>
+#include <sys/uio.h>
+#include <vector>
 
 namespace Cynara {
 /**
@@ -36,14 +39,16 @@ typedef std::shared_ptr<BinaryQueue> BinaryQueuePtr;
 typedef std::weak_ptr<BinaryQueue> BinaryQueueWeakPtr;
 
 /**
- * Binary stream implemented as constant size bucket list
- *
- * @todo Add optimized implementation for FlattenConsume
+ * Binary stream implemented as ring of buckets. Copied data is kept in fixed size chunks
+ * recycled by per-thread pool (or inside binary queue, if it is small), so steady stream
+ * of messages does not allocate memory. Data once appended is never moved, until it is
+ * consumed.
  */
 class BinaryQueue {
 public:
     typedef void (*BufferDeleter)(const void *buffer, size_t bufferSize,
                                   void *userParam);
+    typedef std::function<void(void)> AppendListener;
     static void bufferDeleterFree(const void *buffer,
                                   size_t bufferSize,
                                   void *userParam);
@@ -73,6 +78,16 @@ public:
      */
     const BinaryQueue &operator=(const BinaryQueue &other);
 
+    /**
+     * Set procedure called whenever data is appended to binary queue, so owner of queue
+     * filled by others learns about new data without polling it.
+     * Listener is not copied with binary queue.
+     *
+     * @return none
+     * @param[in] listener Procedure to call, empty one removes listener
+     */
+    void setAppendListener(AppendListener listener);
+
     /**
      * Append copy of @a bufferSize bytes from memory pointed by @a buffer
      * to the end of binary queue. Uses default deleter based on free.
@@ -106,6 +121,28 @@ public:
             &BinaryQueue::bufferDeleterFree,
         void *userParam = nullptr);
 
+    /**
+     * Reserve memory for at least @a size bytes, which are going to be appended to the end
+     * of binary queue with appendCommit() (e.g. read straight from a socket).
+     * Memory is free space of the last chunk or a new chunk taken from the pool, so
+     * appending this way does not allocate memory in steady state.
+     *
+     * @return Pointer to reserved memory, valid until binary queue is modified
+     * @param[in] size Number of bytes to reserve
+     * @exception std::bad_alloc Cannot allocate memory to hold additional data
+     */
+    void *appendReserve(size_t size);
+
+    /**
+     * Append @a size bytes written to memory returned by the last appendReserve() call.
+     * Binary queue must not be modified between these calls.
+     *
+     * @return none
+     * @param[in] size Number of bytes written, not more than reserved
+     * @exception std::bad_alloc Cannot allocate memory to hold additional data
+     */
+    void appendCommit(size_t size);
+
     /**
      * Append copy of other binary queue to the end of this binary queue
      *
@@ -120,9 +157,9 @@ public:
     /**
      * Move bytes from other binary queue to the end of this binary queue.
      * This also removes all bytes from other binary queue.
-     * This method is designed to be as fast as possible (only pointer swaps)
-     * and is suggested over making copies of binary queues.
-     * Bucket structure is preserved after operation.
+     * This method is designed to be as fast as possible (only pointer swaps, small data
+     * kept inside binary queue is copied) and is suggested over making copies of binary
+     * queues.
      *
      * @return none
      * @param[in] other Reference to other binary queue to move data from
@@ -143,9 +180,9 @@ public:
     /**
      * Move bytes from binary queue to the end of other binary queue.
      * This also removes all bytes from binary queue.
-     * This method is designed to be as fast as possible (only pointer swaps)
-     * and is suggested over making copies of binary queues.
-     * Bucket structure is preserved after operation.
+     * This method is designed to be as fast as possible (only pointer swaps, small data
+     * kept inside binary queue is copied) and is suggested over making copies of binary
+     * queues.
      *
      * @return none
      * @param[in] other Reference to other binary queue to move data to
@@ -208,34 +245,112 @@ public:
      */
     void flattenConsume(void *buffer, size_t bufferSize);
 
+    /**
+     * Make first @a size bytes of binary queue contiguous, so they can be read in place.
+     * Buckets keeping them are merged, unless they are kept by the first bucket already.
+     * Data is not removed from binary queue.
+     *
+     * @return Pointer to data, valid until binary queue is modified
+     * @param[in] size Number of bytes
+     * @exception Cynara::OutOfDataException Number of bytes is larger
+     *            than available bytes in binary queue
+     * @exception std::bad_alloc Cannot allocate memory to merge buckets
+     */
+    const void *linearize(size_t size);
+
+    /**
+     * Describe data from beginning of binary queue with scatter/gather entries, one per
+     * bucket, so it can be written (e.g. with writev) without copying. Data is not removed
+     * from binary queue, written part should be removed with consume().
+     * Described memory stays valid until it is consumed or binary queue is cleared.
+     *
+     * @return Number of entries filled
+     * @param[out] iov Pointer to array of entries to fill
+     * @param[in] iovCount Number of entries available in @a iov
+     */
+    size_t fillIovec(struct iovec *iov, size_t iovCount) const;
+
 private:
-      struct Bucket {
-          const void *buffer;
-          const void *ptr;
-          size_t size;
-          size_t left;
-
-          BufferDeleter deleter;
-          void *param;
-
-          Bucket(const void *buffer,
-                 size_t bufferSize,
-                 BufferDeleter deleter,
-                 void *userParam);
-          ~Bucket();
-          // make it noncopyable
-          Bucket(const Bucket &) = delete;
-          const Bucket &operator=(const Bucket &) = delete;
-          // make it nonmoveable
-          Bucket(Bucket &&) = delete;
-          Bucket &operator=(Bucket &&) = delete;
-      };
-
-      typedef std::list<Bucket *> BucketList;
-      BucketList m_buckets;
-      size_t m_size;
-
-      static void deleteBucket(Bucket *bucket);
+    // Data appended by copying is kept in chunks of this size, recycled by per-thread pool
+    static const size_t CHUNK_SIZE = 16384;
+    // Small messages are kept inside binary queue without allocating a chunk
+    static const size_t INLINE_CAPACITY = 128;
+
+    struct Bucket {
+        enum class Kind {
+            Unmanaged,  // provided by user, freed with its deleter, read only
+            Owned,      // chunk or larger buffer owned by binary queue, free space is writable
+            Inline      // m_inline storage of binary queue, free space is writable
+        };
+
+        Kind kind;
+        const char *buffer;
+        const char *ptr;
+        size_t size;
+        size_t left;
+        size_t capacity;
+
+        BufferDeleter deleter;
+        void *param;
+
+        size_t space(void) const {
+            return kind == Kind::Unmanaged ? 0 : capacity - size;
+        }
+
+        char *end(void) const {
+            return const_cast<char *>(buffer) + size;
+        }
+    };
+
+    // Buckets are kept in ring buffer, which only grows, so appending and consuming
+    // do not allocate anything in steady state
+    std::vector<Bucket> m_ring;
+    size_t m_head;
+    size_t m_count;
+    size_t m_size;
+    AppendListener m_appendListener;
+
+    // Buffer returned by the last appendReserve() call and owned buffer allocated for it
+    char *m_reservation;
+    char *m_reserved;
+    size_t m_reservedCapacity;
+
+    bool m_inlineUsed;
+    char m_inline[INLINE_CAPACITY];
+
+    Bucket &bucketAt(size_t index) {
+        return m_ring[(m_head + index) & (m_ring.size() - 1)];
+    }
+
+    const Bucket &bucketAt(size_t index) const {
+        return m_ring[(m_head + index) & (m_ring.size() - 1)];
+    }
+
+    Bucket &front(void) {
+        return bucketAt(0);
+    }
+
+    Bucket *writableBack(void) {
+        if (m_count == 0 || bucketAt(m_count - 1).space() == 0)
+            return nullptr;
+        return &bucketAt(m_count - 1);
+    }
+
+    void notifyAppend(void);
+    void reserveBuckets(size_t count);
+    void pushBack(const Bucket &bucket);
+    void pushFront(const Bucket &bucket);
+    void consumeFront(size_t size);
+    void releaseBucket(Bucket &bucket);
+    void appendData(const void *buffer, size_t bufferSize);
+    // Appends size bytes written by copy(destination, count) called with consecutive parts
+    template <typename Copy>
+    void appendWith(size_t size, Copy copy);
+    void detachInline(void);
+
+    static Bucket ownedBucket(char *buffer, size_t size, size_t capacity);
+    static char *allocateBuffer(size_t size, size_t &capacity);
+    static void releaseBuffer(char *buffer, size_t capacity);
 };
 
 } // namespace Cynara
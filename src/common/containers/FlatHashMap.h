@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/common/containers/FlatHashMap.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file contains hash map with open addressing
+ */
+
+#ifndef SRC_COMMON_CONTAINERS_FLATHASHMAP_H_
+#define SRC_COMMON_CONTAINERS_FLATHASHMAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Cynara {
+
+/*
+ * Hash map keeping its entries in one contiguous array of slots, probed linearly.
+ * Subset of std::unordered_map interface used for bucket policies is provided.
+ * Erased slots are only marked as deleted, so erasing does not move any entry and iteration
+ * can continue past an erased one (like with std::unordered_map). Deleted slots are dropped
+ * when the map is rehashed. Inserting may rehash, invalidating iterators and references.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap {
+public:
+    typedef Key key_type;
+    typedef Value mapped_type;
+    typedef std::pair<const Key, Value> value_type;
+    typedef std::size_t size_type;
+
+    template<bool IsConst>
+    class Iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename FlatHashMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<IsConst, const value_type, value_type>::type
+            &reference;
+        typedef typename std::conditional<IsConst, const value_type, value_type>::type
+            *pointer;
+        typedef typename std::conditional<IsConst, const FlatHashMap, FlatHashMap>::type
+            Map;
+
+        Iterator() : m_map(nullptr), m_index(0) {}
+        Iterator(Map *map, size_type index) : m_map(map), m_index(index) {}
+        // Mutable iterator converts to constant one
+        template<bool OtherConst,
+                 typename = typename std::enable_if<IsConst && !OtherConst>::type>
+        Iterator(const Iterator<OtherConst> &other)
+            : m_map(other.m_map), m_index(other.m_index) {}
+
+        reference operator*(void) const {
+            return m_map->m_slots[m_index];
+        }
+
+        pointer operator->(void) const {
+            return &m_map->m_slots[m_index];
+        }
+
+        Iterator &operator++(void) {
+            m_index = m_map->nextFull(m_index + 1);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous(*this);
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator &other) const {
+            return m_index == other.m_index;
+        }
+
+        bool operator!=(const Iterator &other) const {
+            return m_index != other.m_index;
+        }
+
+    private:
+        friend class FlatHashMap;
+        friend class Iterator<!IsConst>;
+
+        Map *m_map;
+        size_type m_index;
+    };
+
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
+    FlatHashMap() : m_slots(nullptr), m_size(0), m_used(0) {}
+
+    FlatHashMap(const FlatHashMap &other) : m_slots(nullptr), m_size(0), m_used(0) {
+        rehash(capacityFor(other.m_size));
+        for (const auto &entry : other) {
+            insertNew(entry);
+        }
+    }
+
+    FlatHashMap(FlatHashMap &&other) noexcept : FlatHashMap() {
+        swap(other);
+    }
+
+    FlatHashMap &operator=(FlatHashMap other) {
+        swap(other);
+        return *this;
+    }
+
+    ~FlatHashMap() {
+        clear();
+        ::operator delete(m_slots);
+    }
+
+    void swap(FlatHashMap &other) noexcept {
+        std::swap(m_slots, other.m_slots);
+        m_states.swap(other.m_states);
+        std::swap(m_size, other.m_size);
+        std::swap(m_used, other.m_used);
+    }
+
+    iterator begin(void) {
+        return iterator(this, nextFull(0));
+    }
+
+    iterator end(void) {
+        return iterator(this, capacity());
+    }
+
+    const_iterator begin(void) const {
+        return const_iterator(this, nextFull(0));
+    }
+
+    const_iterator end(void) const {
+        return const_iterator(this, capacity());
+    }
+
+    size_type size(void) const {
+        return m_size;
+    }
+
+    bool empty(void) const {
+        return m_size == 0;
+    }
+
+    size_type capacity(void) const {
+        return m_states.size();
+    }
+
+    iterator find(const Key &key) {
+        return iterator(this, findIndex(key));
+    }
+
+    const_iterator find(const Key &key) const {
+        return const_iterator(this, findIndex(key));
+    }
+
+    size_type count(const Key &key) const {
+        return findIndex(key) != capacity() ? 1 : 0;
+    }
+
+    Value &operator[](const Key &key) {
+        auto index = findIndex(key);
+        if (index == capacity()) {
+            index = insertNew(value_type(key, Value()));
+        }
+        return m_slots[index].second;
+    }
+
+    std::pair<iterator, bool> insert(const value_type &entry) {
+        auto index = findIndex(entry.first);
+        if (index != capacity()) {
+            return { iterator(this, index), false };
+        }
+        return { iterator(this, insertNew(entry)), true };
+    }
+
+    void erase(const_iterator position) {
+        eraseIndex(position.m_index);
+    }
+
+    void erase(iterator position) {
+        eraseIndex(position.m_index);
+    }
+
+    size_type erase(const Key &key) {
+        const auto index = findIndex(key);
+        if (index == capacity()) {
+            return 0;
+        }
+        eraseIndex(index);
+        return 1;
+    }
+
+    void clear(void) {
+        for (size_type i = 0; i < capacity(); ++i) {
+            if (m_states[i] == FULL) {
+                m_slots[i].~value_type();
+            }
+            m_states[i] = EMPTY;
+        }
+        m_size = 0;
+        m_used = 0;
+    }
+
+    void reserve(size_type count) {
+        if (capacityFor(count) > capacity()) {
+            rehash(capacityFor(count));
+        }
+    }
+
+private:
+    enum State : std::uint8_t { EMPTY, FULL, DELETED };
+
+    static const size_type MIN_CAPACITY = 8;
+
+    // Load (including deleted slots) is kept under 3/4, so probe sequences stay short
+    static size_type capacityFor(size_type count) {
+        size_type capacity = MIN_CAPACITY;
+        while (capacity * 3 < count * 4 + 4) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    // Fibonacci hashing spreads keys with poorly mixed low bits over the whole table
+    size_type home(const Key &key) const {
+        const std::uint64_t hash = static_cast<std::uint64_t>(Hash()(key));
+        return static_cast<size_type>((hash * 0x9e3779b97f4a7c15ull) >> 32) & (capacity() - 1);
+    }
+
+    size_type nextFull(size_type index) const {
+        while (index < capacity() && m_states[index] != FULL) {
+            ++index;
+        }
+        return index;
+    }
+
+    size_type findIndex(const Key &key) const {
+        if (m_size == 0) {
+            return capacity();
+        }
+
+        const size_type mask = capacity() - 1;
+        for (size_type index = home(key); ; index = (index + 1) & mask) {
+            if (m_states[index] == EMPTY) {
+                return capacity();
+            }
+            if (m_states[index] == FULL && m_slots[index].first == key) {
+                return index;
+            }
+        }
+    }
+
+    // Entry must not be present in the map yet
+    size_type insertNew(const value_type &entry) {
+        if ((m_used + 1) * 4 > capacity() * 3) {
+            // Deleted slots are dropped, table grows only if live entries need it
+            rehash(capacityFor(m_size + 1));
+        }
+
+        const size_type mask = capacity() - 1;
+        size_type index = home(entry.first);
+        while (m_states[index] == FULL) {
+            index = (index + 1) & mask;
+        }
+
+        if (m_states[index] == EMPTY) {
+            ++m_used;
+        }
+        new (&m_slots[index]) value_type(entry);
+        m_states[index] = FULL;
+        ++m_size;
+        return index;
+    }
+
+    void eraseIndex(size_type index) {
+        m_slots[index].~value_type();
+        --m_size;
+        // Slot followed by an empty one ends no probe sequence, so it can be empty too
+        if (m_states[(index + 1) & (capacity() - 1)] == EMPTY) {
+            m_states[index] = EMPTY;
+            --m_used;
+        } else {
+            m_states[index] = DELETED;
+        }
+    }
+
+    void rehash(size_type newCapacity) {
+        FlatHashMap rehashed;
+        rehashed.m_slots = static_cast<value_type *>(
+            ::operator new(newCapacity * sizeof(value_type)));
+        rehashed.m_states.assign(newCapacity, EMPTY);
+
+        for (size_type i = 0; i < capacity(); ++i) {
+            if (m_states[i] == FULL) {
+                rehashed.moveNew(std::move(m_slots[i]));
+            }
+        }
+        swap(rehashed);
+    }
+
+    void moveNew(value_type &&entry) {
+        const size_type mask = capacity() - 1;
+        size_type index = home(entry.first);
+        while (m_states[index] != EMPTY) {
+            index = (index + 1) & mask;
+        }
+
+        new (&m_slots[index]) value_type(std::move(entry));
+        m_states[index] = FULL;
+        ++m_size;
+        ++m_used;
+    }
+
+    value_type *m_slots;
+    std::vector<State> m_states;
+    size_type m_size;
+    // Slots either full or deleted
+    size_type m_used;
+};
+
+} // namespace Cynara
+
+#endif /* SRC_COMMON_CONTAINERS_FLATHASHMAP_H_ */
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/common/containers/StringView.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file defines non-owning view of characters
+ */
+
+#ifndef SRC_COMMON_CONTAINERS_STRINGVIEW_H_
+#define SRC_COMMON_CONTAINERS_STRINGVIEW_H_
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace Cynara {
+
+/*
+ * Characters kept by someone else (e.g. in a received frame), used instead of std::string,
+ * where its copy is not needed. View is valid as long as viewed memory is.
+ */
+class StringView {
+public:
+    StringView() : m_data(nullptr), m_size(0) {}
+    StringView(const char *data, std::size_t size) : m_data(data), m_size(size) {}
+    StringView(const std::string &str) : m_data(str.data()), m_size(str.size()) {}
+
+    const char *data(void) const {
+        return m_data;
+    }
+
+    std::size_t size(void) const {
+        return m_size;
+    }
+
+    bool empty(void) const {
+        return m_size == 0;
+    }
+
+    std::string str(void) const {
+        return std::string(m_data, m_size);
+    }
+
+    bool operator==(const StringView &other) const {
+        return m_size == other.m_size && (m_size == 0 || memcmp(m_data, other.m_data, m_size) == 0);
+    }
+
+    bool operator!=(const StringView &other) const {
+        return !(*this == other);
+    }
+
+private:
+    const char *m_data;
+    std::size_t m_size;
+};
+
+} // namespace Cynara
+
+#endif /* SRC_COMMON_CONTAINERS_STRINGVIEW_H_ */
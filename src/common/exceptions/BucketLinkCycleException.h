@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/common/exceptions/BucketLinkCycleException.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Implementation of BucketLinkCycleException
+ */
+
+#ifndef SRC_COMMON_EXCEPTIONS_BUCKETLINKCYCLEEXCEPTION_H_
+#define SRC_COMMON_EXCEPTIONS_BUCKETLINKCYCLEEXCEPTION_H_
+
+#include "Exception.h"
+#include "types/PolicyBucketId.h"
+
+#include <exception>
+
+namespace Cynara {
+
+class BucketLinkCycleException : public Exception {
+public:
+    BucketLinkCycleException() = delete;
+    BucketLinkCycleException(const PolicyBucketId &bucketId)
+        : m_bucketId(bucketId), m_message("BucketLinkCycleException") {
+    }
+    virtual ~BucketLinkCycleException() {};
+
+    virtual const std::string &message(void) const {
+        return m_message;
+    }
+
+    const PolicyBucketId &bucketId(void) const {
+        return m_bucketId;
+    }
+
+private:
+    PolicyBucketId m_bucketId;
+    std::string m_message;
+};
+
+} /* namespace Cynara */
+
+#endif /* SRC_COMMON_EXCEPTIONS_BUCKETLINKCYCLEEXCEPTION_H_ */
@@ -25,6 +25,7 @@
 #include <cinttypes>
 #include <memory>
 
+#include <attributes/attributes.h>
 #include <exceptions/InvalidProtocolException.h>
 #include <log/log.h>
 #include <protocol/ProtocolFrame.h>
@@ -57,59 +58,60 @@ ProtocolPtr ProtocolAdmin::clone(void) {
     return std::make_shared<ProtocolAdmin>();
 }
 
-RequestPtr ProtocolAdmin::deserializeAdminCheckRequest(void) {
-    std::string clientId, userId, privilegeId;
+RequestPtr ProtocolAdmin::deserializeAdminCheckRequest(ProtocolFrameBody &body) {
+    StringView clientId, userId, privilegeId;
     PolicyBucketId startBucket;
     bool recursive;
 
-    ProtocolDeserialization::deserialize(m_frameHeader, clientId);
-    ProtocolDeserialization::deserialize(m_frameHeader, userId);
-    ProtocolDeserialization::deserialize(m_frameHeader, privilegeId);
-    ProtocolDeserialization::deserialize(m_frameHeader, startBucket);
-    ProtocolDeserialization::deserialize(m_frameHeader, recursive);
+    ProtocolDeserialization::deserialize(body, clientId);
+    ProtocolDeserialization::deserialize(body, userId);
+    ProtocolDeserialization::deserialize(body, privilegeId);
+    ProtocolDeserialization::deserialize(body, startBucket);
+    ProtocolDeserialization::deserialize(body, recursive);
 
     LOGD("Deserialized AdminCheckRequest: clientId <%s>, userId <%s>, privilegeId <%s>, "
-         "startBucket <%s>, recursive [%d]", clientId.c_str(), userId.c_str(),
-         privilegeId.c_str(), startBucket.c_str(), recursive);
+         "startBucket <%s>, recursive [%d]", clientId.str().c_str(), userId.str().c_str(),
+         privilegeId.str().c_str(), startBucket.c_str(), recursive);
 
     return std::make_shared<AdminCheckRequest>(PolicyKey(clientId, userId, privilegeId),
                                                startBucket, recursive,
                                                m_frameHeader.sequenceNumber());
 }
 
-RequestPtr ProtocolAdmin::deserializeDescriptionListRequest(void) {
+RequestPtr ProtocolAdmin::deserializeDescriptionListRequest(ProtocolFrameBody &body UNUSED) {
     LOGD("Deserialized DescriptionListRequest");
     return std::make_shared<DescriptionListRequest>(m_frameHeader.sequenceNumber());
 }
 
-RequestPtr ProtocolAdmin::deserializeEraseRequest(void) {
+RequestPtr ProtocolAdmin::deserializeEraseRequest(ProtocolFrameBody &body) {
     PolicyBucketId startBucket;
     bool recursive;
-    PolicyKeyFeature::ValueType client, user, privilege;
+    StringView client, user, privilege;
 
-    ProtocolDeserialization::deserialize(m_frameHeader, startBucket);
-    ProtocolDeserialization::deserialize(m_frameHeader, recursive);
-    ProtocolDeserialization::deserialize(m_frameHeader, client);
-    ProtocolDeserialization::deserialize(m_frameHeader, user);
-    ProtocolDeserialization::deserialize(m_frameHeader, privilege);
+    ProtocolDeserialization::deserialize(body, startBucket);
+    ProtocolDeserialization::deserialize(body, recursive);
+    ProtocolDeserialization::deserialize(body, client);
+    ProtocolDeserialization::deserialize(body, user);
+    ProtocolDeserialization::deserialize(body, privilege);
 
     LOGD("Deserialized EraseRequest: startBucket <%s>, recursive [%d], filter client <%s> "
          "filter user <%s>, filter privilege <%s>", startBucket.c_str(),
-         static_cast<int>(recursive), client.c_str(), user.c_str(), privilege.c_str());
+         static_cast<int>(recursive), client.str().c_str(), user.str().c_str(),
+         privilege.str().c_str());
 
     return std::make_shared<EraseRequest>(startBucket, recursive,
                                           PolicyKey(client, user, privilege),
                                           m_frameHeader.sequenceNumber());
 }
 
-RequestPtr ProtocolAdmin::deserializeInsertOrUpdateBucketRequest(void) {
+RequestPtr ProtocolAdmin::deserializeInsertOrUpdateBucketRequest(ProtocolFrameBody &body) {
     PolicyBucketId policyBucketId;
     PolicyType policyType;
     PolicyResult::PolicyMetadata policyMetaData;
 
-    ProtocolDeserialization::deserialize(m_frameHeader, policyBucketId);
-    ProtocolDeserialization::deserialize(m_frameHeader, policyType);
-    ProtocolDeserialization::deserialize(m_frameHeader, policyMetaData);
+    ProtocolDeserialization::deserialize(body, policyBucketId);
+    ProtocolDeserialization::deserialize(body, policyType);
+    ProtocolDeserialization::deserialize(body, policyMetaData);
 
     LOGD("Deserialized InsertOrUpdateBucketRequest: bucketId <%s>, "
          "result.type [%" PRIu16 "], result.meta <%s>", policyBucketId.c_str(),
@@ -119,54 +121,55 @@ RequestPtr ProtocolAdmin::deserializeInsertOrUpdateBucketRequest(void) {
             PolicyResult(policyType, policyMetaData), m_frameHeader.sequenceNumber());
 }
 
-RequestPtr ProtocolAdmin::deserializeListRequest(void) {
+RequestPtr ProtocolAdmin::deserializeListRequest(ProtocolFrameBody &body) {
     PolicyBucketId bucketId;
-    PolicyKeyFeature::ValueType client, user, privilege;
+    StringView client, user, privilege;
 
-    ProtocolDeserialization::deserialize(m_frameHeader, bucketId);
-    ProtocolDeserialization::deserialize(m_frameHeader, client);
-    ProtocolDeserialization::deserialize(m_frameHeader, user);
-    ProtocolDeserialization::deserialize(m_frameHeader, privilege);
+    ProtocolDeserialization::deserialize(body, bucketId);
+    ProtocolDeserialization::deserialize(body, client);
+    ProtocolDeserialization::deserialize(body, user);
+    ProtocolDeserialization::deserialize(body, privilege);
 
     LOGD("Deserialized ListRequest: bucketId <%s>, filter client <%s> filter user <%s>, filter "
-         "privilege <%s>", bucketId.c_str(), client.c_str(), user.c_str(), privilege.c_str());
+         "privilege <%s>", bucketId.c_str(), client.str().c_str(), user.str().c_str(),
+         privilege.str().c_str());
 
     return std::make_shared<ListRequest>(bucketId, PolicyKey(client, user, privilege),
                                          m_frameHeader.sequenceNumber());
 }
 
-RequestPtr ProtocolAdmin::deserializeRemoveBucketRequest(void) {
+RequestPtr ProtocolAdmin::deserializeRemoveBucketRequest(ProtocolFrameBody &body) {
     PolicyBucketId policyBucketId;
 
-    ProtocolDeserialization::deserialize(m_frameHeader, policyBucketId);
+    ProtocolDeserialization::deserialize(body, policyBucketId);
 
     LOGD("Deserialized RemoveBucketRequest: bucketId <%s>", policyBucketId.c_str());
 
     return std::make_shared<RemoveBucketRequest>(policyBucketId, m_frameHeader.sequenceNumber());
 }
 
-RequestPtr ProtocolAdmin::deserializeSetPoliciesRequest(void) {
+RequestPtr ProtocolAdmin::deserializeSetPoliciesRequest(ProtocolFrameBody &body) {
     ProtocolFrameFieldsCount toBeInsertedOrUpdatedCount, toBeRemovedCount;
     ProtocolFrameFieldsCount policyCount;
-    PolicyKeyFeature::ValueType clientId, user, privilege;
+    StringView clientId, user, privilege;
     PolicyType policyType;
     PolicyResult::PolicyMetadata metadata;
     std::map<PolicyBucketId, std::vector<Policy>> toBeInsertedOrUpdatedPolicies;
     std::map<PolicyBucketId, std::vector<PolicyKey>> toBeRemovedPolicies;
 
-    ProtocolDeserialization::deserialize(m_frameHeader, toBeInsertedOrUpdatedCount);
+    ProtocolDeserialization::deserialize(body, toBeInsertedOrUpdatedCount);
     for (ProtocolFrameFieldsCount b = 0; b < toBeInsertedOrUpdatedCount; ++b) {
         PolicyBucketId policyBucketId;
-        ProtocolDeserialization::deserialize(m_frameHeader, policyBucketId);
-        ProtocolDeserialization::deserialize(m_frameHeader, policyCount);
+        ProtocolDeserialization::deserialize(body, policyBucketId);
+        ProtocolDeserialization::deserialize(body, policyCount);
         for (ProtocolFrameFieldsCount p = 0; p < policyCount; ++p) {
             // PolicyKey
-            ProtocolDeserialization::deserialize(m_frameHeader, clientId);
-            ProtocolDeserialization::deserialize(m_frameHeader, user);
-            ProtocolDeserialization::deserialize(m_frameHeader, privilege);
+            ProtocolDeserialization::deserialize(body, clientId);
+            ProtocolDeserialization::deserialize(body, user);
+            ProtocolDeserialization::deserialize(body, privilege);
             // PolicyResult
-            ProtocolDeserialization::deserialize(m_frameHeader, policyType);
-            ProtocolDeserialization::deserialize(m_frameHeader, metadata);
+            ProtocolDeserialization::deserialize(body, policyType);
+            ProtocolDeserialization::deserialize(body, metadata);
 
             toBeInsertedOrUpdatedPolicies[policyBucketId].push_back(
                     Policy(PolicyKey(clientId, user, privilege),
@@ -174,16 +177,16 @@ RequestPtr ProtocolAdmin::deserializeSetPoliciesRequest(void) {
         }
     }
 
-    ProtocolDeserialization::deserialize(m_frameHeader, toBeRemovedCount);
+    ProtocolDeserialization::deserialize(body, toBeRemovedCount);
     for (ProtocolFrameFieldsCount b = 0; b < toBeRemovedCount; ++b) {
         PolicyBucketId policyBucketId;
-        ProtocolDeserialization::deserialize(m_frameHeader, policyBucketId);
-        ProtocolDeserialization::deserialize(m_frameHeader, policyCount);
+        ProtocolDeserialization::deserialize(body, policyBucketId);
+        ProtocolDeserialization::deserialize(body, policyCount);
         for (ProtocolFrameFieldsCount p = 0; p < policyCount; ++p) {
             // PolicyKey
-            ProtocolDeserialization::deserialize(m_frameHeader, clientId);
-            ProtocolDeserialization::deserialize(m_frameHeader, user);
-            ProtocolDeserialization::deserialize(m_frameHeader, privilege);
+            ProtocolDeserialization::deserialize(body, clientId);
+            ProtocolDeserialization::deserialize(body, user);
+            ProtocolDeserialization::deserialize(body, privilege);
 
             toBeRemovedPolicies[policyBucketId].push_back(PolicyKey(clientId, user, privilege));
         }
@@ -202,29 +205,41 @@ RequestPtr ProtocolAdmin::extractRequestFromBuffer(BinaryQueuePtr bufferQueue) {
 
     if (m_frameHeader.isFrameComplete()) {
         ProtocolOpCode opCode;
+        RequestPtr request;
 
         m_frameHeader.resetState();
-        ProtocolDeserialization::deserialize(m_frameHeader, opCode);
+        auto body = ProtocolFrameSerializer::deserializeBody(m_frameHeader, *bufferQueue);
+        ProtocolDeserialization::deserialize(body, opCode);
         LOGD("Deserialized opCode [%" PRIu8 "]", opCode);
         switch (opCode) {
         case OpAdminCheckRequest:
-            return deserializeAdminCheckRequest();
+            request = deserializeAdminCheckRequest(body);
+            break;
         case OpDescriptionListRequest:
-            return deserializeDescriptionListRequest();
+            request = deserializeDescriptionListRequest(body);
+            break;
         case OpEraseRequest:
-            return deserializeEraseRequest();
+            request = deserializeEraseRequest(body);
+            break;
         case OpInsertOrUpdateBucket:
-            return deserializeInsertOrUpdateBucketRequest();
+            request = deserializeInsertOrUpdateBucketRequest(body);
+            break;
         case OpListRequest:
-            return deserializeListRequest();
+            request = deserializeListRequest(body);
+            break;
         case OpRemoveBucket:
-            return deserializeRemoveBucketRequest();
+            request = deserializeRemoveBucketRequest(body);
+            break;
         case OpSetPolicies:
-            return deserializeSetPoliciesRequest();
+            request = deserializeSetPoliciesRequest(body);
+            break;
         default:
             throw InvalidProtocolException(InvalidProtocolException::WrongOpCode);
             break;
         }
+
+        bufferQueue->consume(body.size());
+        return request;
     }
 
     return nullptr;
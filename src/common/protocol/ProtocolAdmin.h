@@ -24,6 +24,8 @@
 #ifndef SRC_COMMON_PROTOCOL_PROTOCOLADMIN_H_
 #define SRC_COMMON_PROTOCOL_PROTOCOLADMIN_H_
 
+#include <protocol/ProtocolFrameBody.h>
+
 #include "Protocol.h"
 
 namespace Cynara {
@@ -54,13 +56,13 @@ public:
     virtual void execute(const RequestContext &context, const ListResponse &response);
 
 private:
-    RequestPtr deserializeAdminCheckRequest(void);
-    RequestPtr deserializeDescriptionListRequest(void);
-    RequestPtr deserializeEraseRequest(void);
-    RequestPtr deserializeInsertOrUpdateBucketRequest(void);
-    RequestPtr deserializeListRequest(void);
-    RequestPtr deserializeRemoveBucketRequest(void);
-    RequestPtr deserializeSetPoliciesRequest(void);
+    RequestPtr deserializeAdminCheckRequest(ProtocolFrameBody &body);
+    RequestPtr deserializeDescriptionListRequest(ProtocolFrameBody &body);
+    RequestPtr deserializeEraseRequest(ProtocolFrameBody &body);
+    RequestPtr deserializeInsertOrUpdateBucketRequest(ProtocolFrameBody &body);
+    RequestPtr deserializeListRequest(ProtocolFrameBody &body);
+    RequestPtr deserializeRemoveBucketRequest(ProtocolFrameBody &body);
+    RequestPtr deserializeSetPoliciesRequest(ProtocolFrameBody &body);
 
     ResponsePtr deserializeAdminCheckResponse(void);
     ResponsePtr deserializeCodeResponse(void);
@@ -48,12 +48,12 @@ ProtocolPtr ProtocolAgent::clone(void) {
     return std::make_shared<ProtocolAgent>();
 }
 
-RequestPtr ProtocolAgent::deserializeActionRequest(void) {
+RequestPtr ProtocolAgent::deserializeActionRequest(ProtocolFrameBody &body) {
     AgentRequestType requestType;
     RawBuffer data;
 
-    ProtocolDeserialization::deserialize(m_frameHeader, requestType);
-    ProtocolDeserialization::deserialize(m_frameHeader, data);
+    ProtocolDeserialization::deserialize(body, requestType);
+    ProtocolDeserialization::deserialize(body, data);
 
     LOGD("Deserialized AgentActionRequest: requestType [%" PRIu8 "], data lengtgh <%zu>",
          requestType, data.size());
@@ -61,10 +61,10 @@ RequestPtr ProtocolAgent::deserializeActionRequest(void) {
     return std::make_shared<AgentActionRequest>(requestType, data, m_frameHeader.sequenceNumber());
 }
 
-RequestPtr ProtocolAgent::deserializeRegisterRequest(void) {
+RequestPtr ProtocolAgent::deserializeRegisterRequest(ProtocolFrameBody &body) {
     AgentType agentType;
 
-    ProtocolDeserialization::deserialize(m_frameHeader, agentType);
+    ProtocolDeserialization::deserialize(body, agentType);
 
     LOGD("Deserialized AgentRegisterRequest: agent type <%s>", agentType.c_str());
 
@@ -76,19 +76,26 @@ RequestPtr ProtocolAgent::extractRequestFromBuffer(BinaryQueuePtr bufferQueue) {
 
     if (m_frameHeader.isFrameComplete()) {
         ProtocolOpCode opCode;
+        RequestPtr request;
 
         m_frameHeader.resetState();
-        ProtocolDeserialization::deserialize(m_frameHeader, opCode);
+        auto body = ProtocolFrameSerializer::deserializeBody(m_frameHeader, *bufferQueue);
+        ProtocolDeserialization::deserialize(body, opCode);
         LOGD("Deserialized opCode [%" PRIu8 "]", opCode);
         switch (opCode) {
             case OpAgentActionRequest:
-                return deserializeActionRequest();
+                request = deserializeActionRequest(body);
+                break;
             case OpAgentRegisterRequest:
-                return deserializeRegisterRequest();
+                request = deserializeRegisterRequest(body);
+                break;
             default:
                 throw InvalidProtocolException(InvalidProtocolException::WrongOpCode);
                 break;
         }
+
+        bufferQueue->consume(body.size());
+        return request;
     }
 
     return nullptr;
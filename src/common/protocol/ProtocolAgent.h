@@ -23,6 +23,7 @@
 #ifndef SRC_COMMON_PROTOCOL_PROTOCOLAGENT_H_
 #define SRC_COMMON_PROTOCOL_PROTOCOLAGENT_H_
 
+#include <protocol/ProtocolFrameBody.h>
 #include <protocol/ProtocolFrameHeader.h>
 #include <request/pointers.h>
 #include <response/pointers.h>
@@ -49,8 +50,8 @@ public:
     virtual void execute(const RequestContext &context, const AgentRegisterResponse &request);
 
 private:
-    RequestPtr deserializeActionRequest(void);
-    RequestPtr deserializeRegisterRequest(void);
+    RequestPtr deserializeActionRequest(ProtocolFrameBody &body);
+    RequestPtr deserializeRegisterRequest(ProtocolFrameBody &body);
     ResponsePtr deserializeActionResponse(void);
     ResponsePtr deserializeRegisterResponse(void);
 };
@@ -24,8 +24,10 @@
 
 #include <cinttypes>
 #include <memory>
+#include <vector>
 
 #include <common.h>
+#include <cynara-limits.h>
 #include <exceptions/InvalidProtocolException.h>
 #include <exceptions/OutOfDataException.h>
 #include <log/log.h>
@@ -33,12 +35,14 @@
 #include <protocol/ProtocolOpCode.h>
 #include <protocol/ProtocolSerialization.h>
 #include <request/CancelRequest.h>
+#include <request/CheckBatchRequest.h>
 #include <request/CheckRequest.h>
 #include <request/MonitorEntriesPutRequest.h>
 #include <request/MonitorEntryPutRequest.h>
 #include <request/RequestContext.h>
 #include <request/SimpleCheckRequest.h>
 #include <response/CancelResponse.h>
+#include <response/CheckBatchResponse.h>
 #include <response/CheckResponse.h>
 #include <response/SimpleCheckResponse.h>
 #include <types/MonitorEntry.h>
@@ -60,56 +64,81 @@ ProtocolPtr ProtocolClient::clone(void) {
     return std::make_shared<ProtocolClient>();
 }
 
-RequestPtr ProtocolClient::deserializeCancelRequest(void) {
+RequestPtr ProtocolClient::deserializeCancelRequest(ProtocolFrameBody &body UNUSED) {
     LOGD("Deserialized CancelRequest");
     return std::make_shared<CancelRequest>(m_frameHeader.sequenceNumber());
 }
 
-RequestPtr ProtocolClient::deserializeCheckRequest(void) {
-    std::string clientId, userId, privilegeId;
+RequestPtr ProtocolClient::deserializeCheckBatchRequest(ProtocolFrameBody &body) {
+    ProtocolFrameFieldsCount keysCount;
 
-    ProtocolDeserialization::deserialize(m_frameHeader, clientId);
-    ProtocolDeserialization::deserialize(m_frameHeader, userId);
-    ProtocolDeserialization::deserialize(m_frameHeader, privilegeId);
+    ProtocolDeserialization::deserialize(body, keysCount);
+    if (keysCount > CYNARA_MAX_VECTOR_SIZE)
+        throw InvalidProtocolException(InvalidProtocolException::IdentifierTooLong);
+
+    std::vector<PolicyKey> keys;
+    keys.reserve(keysCount);
+
+    for (ProtocolFrameFieldsCount fields = 0; fields < keysCount; fields++) {
+        StringView clientId, userId, privilegeId;
+
+        ProtocolDeserialization::deserialize(body, clientId);
+        ProtocolDeserialization::deserialize(body, userId);
+        ProtocolDeserialization::deserialize(body, privilegeId);
+
+        keys.emplace_back(clientId, userId, privilegeId);
+    }
+
+    LOGD("Deserialized CheckBatchRequest: number of keys [%" PRIu16 "]", keysCount);
+
+    return std::make_shared<CheckBatchRequest>(keys, m_frameHeader.sequenceNumber());
+}
+
+RequestPtr ProtocolClient::deserializeCheckRequest(ProtocolFrameBody &body) {
+    StringView clientId, userId, privilegeId;
+
+    ProtocolDeserialization::deserialize(body, clientId);
+    ProtocolDeserialization::deserialize(body, userId);
+    ProtocolDeserialization::deserialize(body, privilegeId);
 
     LOGD("Deserialized CheckRequest: client <%s>, user <%s>, privilege <%s>",
-         clientId.c_str(), userId.c_str(), privilegeId.c_str());
+         clientId.str().c_str(), userId.str().c_str(), privilegeId.str().c_str());
 
     return std::make_shared<CheckRequest>(PolicyKey(clientId, userId, privilegeId),
                                           m_frameHeader.sequenceNumber());
 }
 
-RequestPtr ProtocolClient::deserializeSimpleCheckRequest(void) {
-    std::string clientId, userId, privilegeId;
+RequestPtr ProtocolClient::deserializeSimpleCheckRequest(ProtocolFrameBody &body) {
+    StringView clientId, userId, privilegeId;
 
-    ProtocolDeserialization::deserialize(m_frameHeader, clientId);
-    ProtocolDeserialization::deserialize(m_frameHeader, userId);
-    ProtocolDeserialization::deserialize(m_frameHeader, privilegeId);
+    ProtocolDeserialization::deserialize(body, clientId);
+    ProtocolDeserialization::deserialize(body, userId);
+    ProtocolDeserialization::deserialize(body, privilegeId);
 
     LOGD("Deserialized SimpleCheckRequest: client <%s>, user <%s>, privilege <%s>",
-         clientId.c_str(), userId.c_str(), privilegeId.c_str());
+         clientId.str().c_str(), userId.str().c_str(), privilegeId.str().c_str());
 
     return std::make_shared<SimpleCheckRequest>(PolicyKey(clientId, userId, privilegeId),
                                                 m_frameHeader.sequenceNumber());
 }
 
-RequestPtr ProtocolClient::deserializeMonitorEntriesPutRequest(void) {
+RequestPtr ProtocolClient::deserializeMonitorEntriesPutRequest(ProtocolFrameBody &body) {
     ProtocolFrameFieldsCount entriesCount;
 
-    ProtocolDeserialization::deserialize(m_frameHeader, entriesCount);
+    ProtocolDeserialization::deserialize(body, entriesCount);
     std::vector<MonitorEntry> entries;
     entries.reserve(entriesCount);
 
     for (ProtocolFrameFieldsCount fields = 0; fields < entriesCount; fields++) {
-        std::string clientId, userId, privilegeId;
+        StringView clientId, userId, privilegeId;
         int64_t result, tv_sec, tv_nsec;
 
-        ProtocolDeserialization::deserialize(m_frameHeader, clientId);
-        ProtocolDeserialization::deserialize(m_frameHeader, userId);
-        ProtocolDeserialization::deserialize(m_frameHeader, privilegeId);
-        ProtocolDeserialization::deserialize(m_frameHeader, result);
-        ProtocolDeserialization::deserialize(m_frameHeader, tv_sec);
-        ProtocolDeserialization::deserialize(m_frameHeader, tv_nsec);
+        ProtocolDeserialization::deserialize(body, clientId);
+        ProtocolDeserialization::deserialize(body, userId);
+        ProtocolDeserialization::deserialize(body, privilegeId);
+        ProtocolDeserialization::deserialize(body, result);
+        ProtocolDeserialization::deserialize(body, tv_sec);
+        ProtocolDeserialization::deserialize(body, tv_nsec);
 
         PolicyKey key(clientId, userId, privilegeId);
         struct timespec timestamp;
@@ -123,16 +152,16 @@ RequestPtr ProtocolClient::deserializeMonitorEntriesPutRequest(void) {
     return std::make_shared<MonitorEntriesPutRequest>(entries, m_frameHeader.sequenceNumber());
 }
 
-RequestPtr ProtocolClient::deserializeMonitorEntryPutRequest(void) {
-    std::string clientId, userId, privilegeId;
+RequestPtr ProtocolClient::deserializeMonitorEntryPutRequest(ProtocolFrameBody &body) {
+    StringView clientId, userId, privilegeId;
     int64_t result, tv_sec, tv_nsec;
 
-    ProtocolDeserialization::deserialize(m_frameHeader, clientId);
-    ProtocolDeserialization::deserialize(m_frameHeader, userId);
-    ProtocolDeserialization::deserialize(m_frameHeader, privilegeId);
-    ProtocolDeserialization::deserialize(m_frameHeader, result);
-    ProtocolDeserialization::deserialize(m_frameHeader, tv_sec);
-    ProtocolDeserialization::deserialize(m_frameHeader, tv_nsec);
+    ProtocolDeserialization::deserialize(body, clientId);
+    ProtocolDeserialization::deserialize(body, userId);
+    ProtocolDeserialization::deserialize(body, privilegeId);
+    ProtocolDeserialization::deserialize(body, result);
+    ProtocolDeserialization::deserialize(body, tv_sec);
+    ProtocolDeserialization::deserialize(body, tv_nsec);
 
     PolicyKey key(clientId, userId, privilegeId);
     struct timespec timestamp;
@@ -140,7 +169,7 @@ RequestPtr ProtocolClient::deserializeMonitorEntryPutRequest(void) {
     timestamp.tv_nsec = static_cast<__syscall_slong_t>(tv_nsec);
 
     LOGD("Deserialized MonitorEntryPutRequest: client <%s>, user <%s>, privilege <%s>",
-         clientId.c_str(), userId.c_str(), privilegeId.c_str());
+         clientId.str().c_str(), userId.str().c_str(), privilegeId.str().c_str());
 
     return std::make_shared<MonitorEntryPutRequest>(MonitorEntry(key, static_cast<size_t>(result),
                                                                  timestamp),
@@ -152,26 +181,39 @@ RequestPtr ProtocolClient::extractRequestFromBuffer(BinaryQueuePtr bufferQueue)
 
     if (m_frameHeader.isFrameComplete()) {
         ProtocolOpCode opCode;
+        RequestPtr request;
 
         m_frameHeader.resetState();
-        ProtocolDeserialization::deserialize(m_frameHeader, opCode);
+        auto body = ProtocolFrameSerializer::deserializeBody(m_frameHeader, *bufferQueue);
+        ProtocolDeserialization::deserialize(body, opCode);
 
         LOGD("Deserialized opCode [%" PRIu8 "]", opCode);
         switch (opCode) {
         case OpCheckPolicyRequest:
-            return deserializeCheckRequest();
+            request = deserializeCheckRequest(body);
+            break;
         case OpCancelRequest:
-            return deserializeCancelRequest();
+            request = deserializeCancelRequest(body);
+            break;
+        case OpCheckBatchPolicyRequest:
+            request = deserializeCheckBatchRequest(body);
+            break;
         case OpSimpleCheckPolicyRequest:
-            return deserializeSimpleCheckRequest();
+            request = deserializeSimpleCheckRequest(body);
+            break;
         case OpMonitorEntriesPutRequest:
-            return deserializeMonitorEntriesPutRequest();
+            request = deserializeMonitorEntriesPutRequest(body);
+            break;
         case OpMonitorEntryPutRequest:
-            return deserializeMonitorEntryPutRequest();
+            request = deserializeMonitorEntryPutRequest(body);
+            break;
         default:
             throw InvalidProtocolException(InvalidProtocolException::WrongOpCode);
             break;
         }
+
+        bufferQueue->consume(body.size());
+        return request;
     }
 
     return nullptr;
@@ -182,6 +224,37 @@ ResponsePtr ProtocolClient::deserializeCancelResponse(void) {
     return std::make_shared<CancelResponse>(m_frameHeader.sequenceNumber());
 }
 
+ResponsePtr ProtocolClient::deserializeCheckBatchResponse(void) {
+    ProtocolFrameFieldsCount resultsCount;
+
+    ProtocolDeserialization::deserialize(m_frameHeader, resultsCount);
+    if (resultsCount > CYNARA_MAX_VECTOR_SIZE)
+        throw InvalidProtocolException(InvalidProtocolException::IdentifierTooLong);
+
+    std::vector<int32_t> retValues;
+    std::vector<PolicyResult> results;
+    retValues.reserve(resultsCount);
+    results.reserve(resultsCount);
+
+    for (ProtocolFrameFieldsCount fields = 0; fields < resultsCount; fields++) {
+        int32_t retValue;
+        PolicyType result;
+        PolicyResult::PolicyMetadata additionalInfo;
+
+        ProtocolDeserialization::deserialize(m_frameHeader, retValue);
+        ProtocolDeserialization::deserialize(m_frameHeader, result);
+        ProtocolDeserialization::deserialize(m_frameHeader, additionalInfo);
+
+        retValues.push_back(retValue);
+        results.emplace_back(result, additionalInfo);
+    }
+
+    LOGD("Deserialized CheckBatchResponse: number of results [%" PRIu16 "]", resultsCount);
+
+    return std::make_shared<CheckBatchResponse>(retValues, results,
+                                                m_frameHeader.sequenceNumber());
+}
+
 ResponsePtr ProtocolClient::deserializeCheckResponse(void) {
     PolicyType result;
     PolicyResult::PolicyMetadata additionalInfo;
@@ -229,6 +302,8 @@ ResponsePtr ProtocolClient::extractResponseFromBuffer(BinaryQueuePtr bufferQueue
             return deserializeCheckResponse();
         case OpCancelResponse:
             return deserializeCancelResponse();
+        case OpCheckBatchPolicyResponse:
+            return deserializeCheckBatchResponse();
         case OpSimpleCheckPolicyResponse:
             return deserializeSimpleCheckResponse();
         default:
@@ -250,6 +325,29 @@ void ProtocolClient::execute(const RequestContext &context, const CancelRequest
     ProtocolFrameSerializer::finishSerialization(frame, *(context.responseQueue()));
 }
 
+void ProtocolClient::execute(const RequestContext &context, const CheckBatchRequest &request) {
+    if (request.keys().size() > CYNARA_MAX_VECTOR_SIZE)
+        throw InvalidProtocolException(InvalidProtocolException::IdentifierTooLong);
+
+    ProtocolFrameFieldsCount keysCount
+            = static_cast<ProtocolFrameFieldsCount>(request.keys().size());
+    LOGD("Serializing CheckBatchRequest: op [%" PRIu8 "], sequenceNumber [%" PRIu16 "], "
+            "number of keys [%" PRIu16 "]",
+         OpCheckBatchPolicyRequest, request.sequenceNumber(), keysCount);
+
+    ProtocolFrame frame = ProtocolFrameSerializer::startSerialization(request.sequenceNumber());
+
+    ProtocolSerialization::serialize(frame, OpCheckBatchPolicyRequest);
+    ProtocolSerialization::serialize(frame, keysCount);
+    for (const auto &key : request.keys()) {
+        ProtocolSerialization::serialize(frame, key.client().value());
+        ProtocolSerialization::serialize(frame, key.user().value());
+        ProtocolSerialization::serialize(frame, key.privilege().value());
+    }
+
+    ProtocolFrameSerializer::finishSerialization(frame, *(context.responseQueue()));
+}
+
 void ProtocolClient::execute(const RequestContext &context, const CheckRequest &request) {
     ProtocolFrame frame = ProtocolFrameSerializer::startSerialization(request.sequenceNumber());
 
@@ -331,6 +429,30 @@ void ProtocolClient::execute(const RequestContext &context, const CancelResponse
     ProtocolFrameSerializer::finishSerialization(frame, *(context.responseQueue()));
 }
 
+void ProtocolClient::execute(const RequestContext &context, const CheckBatchResponse &response) {
+    const auto &retValues = response.getReturnValues();
+    const auto &results = response.getResults();
+    if (retValues.size() != results.size() || results.size() > CYNARA_MAX_VECTOR_SIZE)
+        throw InvalidProtocolException(InvalidProtocolException::Other);
+
+    ProtocolFrameFieldsCount resultsCount = static_cast<ProtocolFrameFieldsCount>(results.size());
+    LOGD("Serializing CheckBatchResponse: op [%" PRIu8 "], sequenceNumber [%" PRIu16 "], "
+            "number of results [%" PRIu16 "]",
+         OpCheckBatchPolicyResponse, response.sequenceNumber(), resultsCount);
+
+    ProtocolFrame frame = ProtocolFrameSerializer::startSerialization(response.sequenceNumber());
+
+    ProtocolSerialization::serialize(frame, OpCheckBatchPolicyResponse);
+    ProtocolSerialization::serialize(frame, resultsCount);
+    for (ProtocolFrameFieldsCount i = 0; i < resultsCount; i++) {
+        ProtocolSerialization::serialize(frame, retValues[i]);
+        ProtocolSerialization::serialize(frame, results[i].policyType());
+        ProtocolSerialization::serialize(frame, results[i].metadata());
+    }
+
+    ProtocolFrameSerializer::finishSerialization(frame, *(context.responseQueue()));
+}
+
 void ProtocolClient::execute(const RequestContext &context, const CheckResponse &response) {
     ProtocolFrame frame = ProtocolFrameSerializer::startSerialization(
             response.sequenceNumber());
@@ -23,6 +23,7 @@
 #ifndef SRC_COMMON_PROTOCOL_PROTOCOLCLIENT_H_
 #define SRC_COMMON_PROTOCOL_PROTOCOLCLIENT_H_
 
+#include <protocol/ProtocolFrameBody.h>
 #include <protocol/ProtocolFrameHeader.h>
 #include <request/pointers.h>
 #include <response/pointers.h>
@@ -44,23 +45,27 @@ public:
     using Protocol::execute;
 
     virtual void execute(const RequestContext &context, const CancelRequest &request);
+    virtual void execute(const RequestContext &context, const CheckBatchRequest &request);
     virtual void execute(const RequestContext &context, const CheckRequest &request);
     virtual void execute(const RequestContext &context, const SimpleCheckRequest &request);
     virtual void execute(const RequestContext &context, const MonitorEntriesPutRequest &request);
     virtual void execute(const RequestContext &context, const MonitorEntryPutRequest &request);
 
     virtual void execute(const RequestContext &context, const CancelResponse &response);
+    virtual void execute(const RequestContext &context, const CheckBatchResponse &response);
     virtual void execute(const RequestContext &context, const CheckResponse &response);
     virtual void execute(const RequestContext &context, const SimpleCheckResponse &request);
 
 private:
-    RequestPtr deserializeCancelRequest(void);
-    RequestPtr deserializeCheckRequest(void);
-    RequestPtr deserializeSimpleCheckRequest(void);
-    RequestPtr deserializeMonitorEntriesPutRequest(void);
-    RequestPtr deserializeMonitorEntryPutRequest(void);
+    RequestPtr deserializeCancelRequest(ProtocolFrameBody &body);
+    RequestPtr deserializeCheckBatchRequest(ProtocolFrameBody &body);
+    RequestPtr deserializeCheckRequest(ProtocolFrameBody &body);
+    RequestPtr deserializeSimpleCheckRequest(ProtocolFrameBody &body);
+    RequestPtr deserializeMonitorEntriesPutRequest(ProtocolFrameBody &body);
+    RequestPtr deserializeMonitorEntryPutRequest(ProtocolFrameBody &body);
 
     ResponsePtr deserializeCancelResponse(void);
+    ResponsePtr deserializeCheckBatchResponse(void);
     ResponsePtr deserializeCheckResponse(void);
     ResponsePtr deserializeSimpleCheckResponse(void);
 };
@@ -22,22 +22,70 @@
  * @brief       Implementation of ProtocolFrame class.
  */
 
+#include <algorithm>
+#include <cstdlib>
+#include <new>
 #include <string.h>
 
+#include <exceptions/OutOfDataException.h>
+
 #include "ProtocolFrame.h"
 
 namespace Cynara {
 
-ProtocolFrame::ProtocolFrame(ProtocolFrameHeader frameHeader, BinaryQueuePtr data) :
-        m_frameHeader(frameHeader), m_frameBodyContent(data) {
+ProtocolFrame::ProtocolFrame(ProtocolFrameHeader frameHeader, size_t headerLength) :
+        m_frameHeader(frameHeader), m_buffer(nullptr), m_capacity(0), m_size(0),
+        m_readPosition(headerLength) {
+    reserve(headerLength + INITIAL_BODY_CAPACITY);
+    m_size = headerLength;
+}
+
+ProtocolFrame::ProtocolFrame(ProtocolFrame &&other) :
+        m_frameHeader(other.m_frameHeader), m_buffer(other.m_buffer),
+        m_capacity(other.m_capacity), m_size(other.m_size),
+        m_readPosition(other.m_readPosition) {
+    other.m_buffer = nullptr;
+    other.m_capacity = 0;
+    other.m_size = 0;
+}
+
+ProtocolFrame::~ProtocolFrame() {
+    free(m_buffer);
+}
+
+void ProtocolFrame::reserve(size_t size) {
+    if (size <= m_capacity)
+        return;
+
+    size_t capacity = std::max(size, 2 * m_capacity);
+    char *buffer = static_cast<char *>(realloc(m_buffer, capacity));
+    if (buffer == nullptr)
+        throw std::bad_alloc();
+
+    m_buffer = buffer;
+    m_capacity = capacity;
+}
+
+char *ProtocolFrame::release(void) {
+    char *buffer = m_buffer;
+    m_buffer = nullptr;
+    m_capacity = 0;
+    m_size = 0;
+    return buffer;
 }
 
 void ProtocolFrame::read(size_t num, void *bytes) {
-    m_frameBodyContent->flattenConsume(bytes, num);
+    if (num > m_size - m_readPosition)
+        throw OutOfDataException(m_size - m_readPosition, num);
+
+    memcpy(bytes, m_buffer + m_readPosition, num);
+    m_readPosition += num;
 }
 
 void ProtocolFrame::write(size_t num, const void *bytes) {
-    m_frameBodyContent->appendCopy(bytes, num);
+    reserve(m_size + num);
+    memcpy(m_buffer + m_size, bytes, num);
+    m_size += num;
     m_frameHeader.increaseFrameLength(num);
 }
 
@@ -28,7 +28,6 @@
 #include <cstddef>
 #include <memory>
 
-#include <containers/BinaryQueue.h>
 #include <protocol/ProtocolFrameHeader.h>
 #include <protocol/ProtocolSerialization.h>
 
@@ -36,11 +35,20 @@ namespace Cynara {
 
 class ProtocolFrameSerializer;
 
+/*
+ * Frame is built in one contiguous buffer. Space for header is reserved at its beginning
+ * and filled by ProtocolFrameSerializer, when frame length is known, so whole frame is
+ * passed to binary queue as a single bucket.
+ */
 class ProtocolFrame: public IStream {
 
 public:
-    ProtocolFrame(ProtocolFrameHeader frameHeader, BinaryQueuePtr headerContent);
-    virtual ~ProtocolFrame() {};
+    ProtocolFrame(ProtocolFrameHeader frameHeader, size_t headerLength);
+    ProtocolFrame(ProtocolFrame &&other);
+    virtual ~ProtocolFrame();
+
+    ProtocolFrame(const ProtocolFrame &) = delete;
+    ProtocolFrame &operator=(const ProtocolFrame &) = delete;
 
     ProtocolFrameHeader &frameHeader(void) {
         return m_frameHeader;
@@ -50,13 +58,27 @@ public:
     virtual void write(size_t num, const void *bytes);
 
 private:
+    static const size_t INITIAL_BODY_CAPACITY = 64;
+
     ProtocolFrameHeader m_frameHeader;
-    BinaryQueuePtr m_frameBodyContent;
+    char *m_buffer;
+    size_t m_capacity;
+    size_t m_size;
+    size_t m_readPosition;
 
-    BinaryQueue &bodyContent(void) {
-        return *m_frameBodyContent;
+    void reserve(size_t size);
+
+    char *buffer(void) {
+        return m_buffer;
+    }
+
+    size_t size(void) const {
+        return m_size;
     }
 
+    // Buffer allocated with malloc is handed over to caller
+    char *release(void);
+
     friend class ProtocolFrameSerializer;
 };
 
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/common/protocol/ProtocolFrameBody.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file defines stream reading body of received frame in place
+ */
+
+#ifndef SRC_COMMON_PROTOCOL_PROTOCOLFRAMEBODY_H_
+#define SRC_COMMON_PROTOCOL_PROTOCOLFRAMEBODY_H_
+
+#include <cstddef>
+#include <cstring>
+
+#include <containers/StringView.h>
+#include <exceptions/OutOfDataException.h>
+
+namespace Cynara {
+
+/*
+ * Stream for ProtocolDeserialization, reading fields of frame body kept in contiguous memory.
+ * Strings can be deserialized as StringView, which views body memory instead of copying it.
+ * Reading past the body throws OutOfDataException.
+ */
+class ProtocolFrameBody {
+public:
+    ProtocolFrameBody(const void *data, size_t size)
+        : m_data(static_cast<const char *>(data)), m_size(size), m_position(0) {}
+
+    void read(size_t num, void *bytes) {
+        memcpy(bytes, take(num), num);
+    }
+
+    StringView view(size_t num) {
+        return StringView(take(num), num);
+    }
+
+    size_t size(void) const {
+        return m_size;
+    }
+
+private:
+    const char *take(size_t num) {
+        if (num > m_size - m_position)
+            throw OutOfDataException(m_size, m_position + num);
+
+        const char *data = m_data + m_position;
+        m_position += num;
+        return data;
+    }
+
+    const char *m_data;
+    size_t m_size;
+    size_t m_position;
+};
+
+} /* namespace Cynara */
+
+#endif /* SRC_COMMON_PROTOCOL_PROTOCOLFRAMEBODY_H_ */
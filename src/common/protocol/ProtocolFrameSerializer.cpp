@@ -22,6 +22,11 @@
  * @brief       Implementation of protocol frame (de)serializer class.
  */
 
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <attributes/attributes.h>
 #include <exceptions/InvalidProtocolException.h>
 #include <exceptions/OutOfDataException.h>
 #include <log/log.h>
@@ -30,6 +35,34 @@
 
 namespace Cynara {
 
+namespace {
+
+// Fills space reserved for header at the beginning of contiguous frame
+class FrameHeaderWriter : public IStream {
+public:
+    FrameHeaderWriter(char *header, size_t length) : m_header(header), m_length(length),
+                                                     m_position(0) {}
+
+    virtual void read(size_t num, void *bytes UNUSED) {
+        throw OutOfDataException(0, num);
+    }
+
+    virtual void write(size_t num, const void *bytes) {
+        if (num > m_length - m_position)
+            throw OutOfDataException(m_length - m_position, num);
+
+        memcpy(m_header + m_position, bytes, num);
+        m_position += num;
+    }
+
+private:
+    char *m_header;
+    size_t m_length;
+    size_t m_position;
+};
+
+} // namespace anonymous
+
 void ProtocolFrameSerializer::deserializeHeader(ProtocolFrameHeader &frameHeader,
                                                 BinaryQueuePtr data) {
     if (!frameHeader.isHeaderComplete()) {
@@ -41,18 +74,21 @@ void ProtocolFrameSerializer::deserializeHeader(ProtocolFrameHeader &frameHeader
 
         frameHeader.setHeaderContent(data);
 
-        ProtocolFrameSignature signature;
-        ProtocolDeserialization::deserialize(frameHeader, frameHeader.m_signature.length(),
-                signature);
+        // Header is peeked in place and consumed, when it is parsed
+        size_t headerLength = ProtocolFrameHeader::frameHeaderLength();
+        ProtocolFrameBody header(data->linearize(headerLength), headerLength);
+
+        StringView signature = header.view(ProtocolFrameHeader::m_signature.length());
 
-        LOGD("Deserialized signature = %s", signature.c_str());
+        LOGD("Deserialized signature = %s", signature.str().c_str());
 
-        if (ProtocolFrameHeader::m_signature != signature) {
+        if (StringView(ProtocolFrameHeader::m_signature) != signature) {
             throw InvalidProtocolException(InvalidProtocolException::InvalidSignature);
         }
 
-        ProtocolDeserialization::deserialize(frameHeader, frameHeader.m_frameLength);
-        ProtocolDeserialization::deserialize(frameHeader, frameHeader.m_sequenceNumber);
+        ProtocolDeserialization::deserialize(header, frameHeader.m_frameLength);
+        ProtocolDeserialization::deserialize(header, frameHeader.m_sequenceNumber);
+        data->consume(headerLength);
 
         LOGD("Deserialized frameLength = %d, sequenceNumber = %d",
              (int)frameHeader.m_frameLength, (int)frameHeader.m_sequenceNumber);
@@ -65,29 +101,40 @@ void ProtocolFrameSerializer::deserializeHeader(ProtocolFrameHeader &frameHeader
     }
 }
 
+ProtocolFrameBody ProtocolFrameSerializer::deserializeBody(ProtocolFrameHeader &frameHeader,
+                                                         BinaryQueue &data) {
+    size_t bodyLength = frameHeader.frameLength() - ProtocolFrameHeader::frameHeaderLength();
+    return ProtocolFrameBody(data.linearize(bodyLength), bodyLength);
+}
+
 ProtocolFrame ProtocolFrameSerializer::startSerialization(ProtocolFrameSequenceNumber sequenceNumber) {
     LOGD("Serialization started");
 
-    BinaryQueuePtr headerQueue = std::make_shared<BinaryQueue>();
-    BinaryQueuePtr bodyQueue = std::make_shared<BinaryQueue>();
-    ProtocolFrameHeader header(headerQueue);
+    ProtocolFrameHeader header;
     header.setSequenceNumber(sequenceNumber);
     header.increaseFrameLength(ProtocolFrameHeader::frameHeaderLength());
-    return ProtocolFrame(header, bodyQueue);
+    return ProtocolFrame(header, ProtocolFrameHeader::frameHeaderLength());
 }
 
 void ProtocolFrameSerializer::finishSerialization(ProtocolFrame &frame, BinaryQueue &data) {
     ProtocolFrameHeader &frameHeader = frame.frameHeader();
-    ProtocolSerialization::serializeNoSize(frameHeader, ProtocolFrameHeader::m_signature);
-    ProtocolSerialization::serialize(frameHeader, frameHeader.m_frameLength);
-    ProtocolSerialization::serialize(frameHeader, frameHeader.m_sequenceNumber);
+    FrameHeaderWriter headerWriter(frame.buffer(), ProtocolFrameHeader::frameHeaderLength());
+    ProtocolSerialization::serializeNoSize(headerWriter, ProtocolFrameHeader::m_signature);
+    ProtocolSerialization::serialize(headerWriter, frameHeader.m_frameLength);
+    ProtocolSerialization::serialize(headerWriter, frameHeader.m_sequenceNumber);
 
     LOGD("Serialize frameHeader: signature = %s, frameLength = %d, sequenceNumber = %d",
          ProtocolFrameHeader::m_signature.c_str(), (int)frameHeader.m_frameLength,
          (int)frameHeader.m_sequenceNumber);
 
-    data.appendMoveFrom(frameHeader.headerContent());
-    data.appendMoveFrom(frame.bodyContent());
+    size_t frameSize = frame.size();
+    char *buffer = frame.release();
+    try {
+        data.appendUnmanaged(buffer, frameSize, &BinaryQueue::bufferDeleterFree, nullptr);
+    } catch (const std::bad_alloc &) {
+        free(buffer);
+        throw;
+    }
 }
 
 } /* namespace Cynara */
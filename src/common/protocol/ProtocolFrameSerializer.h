@@ -27,6 +27,7 @@
 
 #include <containers/BinaryQueue.h>
 #include <protocol/ProtocolFrame.h>
+#include <protocol/ProtocolFrameBody.h>
 
 namespace Cynara {
 
@@ -34,6 +35,8 @@ class ProtocolFrameSerializer {
 
 public:
     static void deserializeHeader(ProtocolFrameHeader &frameHeader, BinaryQueuePtr data);
+    // Body of complete frame is read in place and has to be consumed from data afterwards
+    static ProtocolFrameBody deserializeBody(ProtocolFrameHeader &frameHeader, BinaryQueue &data);
     static ProtocolFrame startSerialization(ProtocolFrameSequenceNumber sequenceNumber);
     static void finishSerialization(ProtocolFrame &frame, BinaryQueue &data);
 };
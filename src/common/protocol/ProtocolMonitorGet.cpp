@@ -24,6 +24,7 @@
 #include <cinttypes>
 #include <memory>
 
+#include <attributes/attributes.h>
 #include <exceptions/InvalidProtocolException.h>
 #include <log/log.h>
 #include <protocol/ProtocolFrameSerializer.h>
@@ -48,10 +49,10 @@ ProtocolPtr ProtocolMonitorGet::clone(void) {
     return std::make_shared<ProtocolMonitorGet>();
 }
 
-RequestPtr ProtocolMonitorGet::deserializeMonitorGetEntriesRequest(void) {
+RequestPtr ProtocolMonitorGet::deserializeMonitorGetEntriesRequest(ProtocolFrameBody &body) {
     uint64_t bufferSize;
 
-    ProtocolDeserialization::deserialize(m_frameHeader, bufferSize);
+    ProtocolDeserialization::deserialize(body, bufferSize);
 
     LOGD("Deserialized MonitorGetEntriesRequest: bufferSize [%" PRIu16 "]", bufferSize);
 
@@ -59,7 +60,7 @@ RequestPtr ProtocolMonitorGet::deserializeMonitorGetEntriesRequest(void) {
             m_frameHeader.sequenceNumber());
 }
 
-RequestPtr ProtocolMonitorGet::deserializeMonitorGetFlushRequest(void) {
+RequestPtr ProtocolMonitorGet::deserializeMonitorGetFlushRequest(ProtocolFrameBody &body UNUSED) {
     LOGD("Deserialized MonitorGetFlushRequest");
 
     return std::make_shared<MonitorGetFlushRequest>(m_frameHeader.sequenceNumber());
@@ -72,18 +73,25 @@ RequestPtr ProtocolMonitorGet::extractRequestFromBuffer(BinaryQueuePtr bufferQue
         return nullptr;
     }
     ProtocolOpCode opCode;
+    RequestPtr request;
 
     m_frameHeader.resetState();
-    ProtocolDeserialization::deserialize(m_frameHeader, opCode);
+    auto body = ProtocolFrameSerializer::deserializeBody(m_frameHeader, *bufferQueue);
+    ProtocolDeserialization::deserialize(body, opCode);
     LOGD("Deserialized opCode [%" PRIu8 "]", opCode);
     switch (opCode) {
         case OpMonitorGetEntriesRequest:
-            return deserializeMonitorGetEntriesRequest();
+            request = deserializeMonitorGetEntriesRequest(body);
+            break;
         case OpMonitorGetFlushRequest:
-            return deserializeMonitorGetFlushRequest();
+            request = deserializeMonitorGetFlushRequest(body);
+            break;
         default:
             throw InvalidProtocolException(InvalidProtocolException::WrongOpCode);
     }
+
+    bufferQueue->consume(body.size());
+    return request;
 }
 
 ResponsePtr ProtocolMonitorGet::deserializeMonitorGetEntriesResponse(void) {
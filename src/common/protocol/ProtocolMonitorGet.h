@@ -24,6 +24,7 @@
 #ifndef SRC_COMMON_PROTOCOL_PROTOCOLMONITORGET_H_
 #define SRC_COMMON_PROTOCOL_PROTOCOLMONITORGET_H_
 
+#include <protocol/ProtocolFrameBody.h>
 #include <protocol/ProtocolFrameHeader.h>
 #include <request/pointers.h>
 #include <response/pointers.h>
@@ -49,8 +50,8 @@ public:
     virtual void execute(const RequestContext &context, const MonitorGetEntriesResponse &response);
 
 private:
-    RequestPtr deserializeMonitorGetEntriesRequest(void);
-    RequestPtr deserializeMonitorGetFlushRequest(void);
+    RequestPtr deserializeMonitorGetEntriesRequest(ProtocolFrameBody &body);
+    RequestPtr deserializeMonitorGetFlushRequest(ProtocolFrameBody &body);
     ResponsePtr deserializeMonitorGetEntriesResponse(void);
 };
 
@@ -41,8 +41,10 @@ enum ProtocolOpCode : uint8_t {
     OpSimpleCheckPolicyResponse,
     OpMonitorEntriesPutRequest,
     OpMonitorEntryPutRequest,
+    OpCheckBatchPolicyRequest,
+    OpCheckBatchPolicyResponse,
 
-    /** Opcodes 6 - 19 are reserved for future use */
+    /** Opcodes 10 - 19 are reserved for future use */
 
     /** Admin operations */
     OpInsertOrUpdateBucket = 20,
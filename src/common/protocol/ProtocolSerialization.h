@@ -32,6 +32,7 @@
 #include <vector>
 
 #include <cynara-limits.h>
+#include <containers/StringView.h>
 #include <exceptions/InvalidProtocolException.h>
 #include <protocol/ProtocolOpCode.h>
 
@@ -129,67 +130,79 @@ struct ProtocolSerialization {
     }
 }; // struct ProtocolSerialization
 
+// Streams are template parameters, so streams reading frames in place are not called virtually
 struct ProtocolDeserialization {
     // char
-    static void deserialize(IStream &stream, char &value) {
+    template<typename Stream>
+    static void deserialize(Stream &stream, char &value) {
         stream.read(sizeof(value), &value);
     }
 
     // unsigned char
-    static void deserialize(IStream &stream, unsigned char &value) {
+    template<typename Stream>
+    static void deserialize(Stream &stream, unsigned char &value) {
         stream.read(sizeof(value), &value);
     }
 
     // 16-bit int
-    static void deserialize(IStream &stream, int16_t &value) {
+    template<typename Stream>
+    static void deserialize(Stream &stream, int16_t &value) {
         stream.read(sizeof(value), &value);
         value = le16toh(value);
     }
 
     // unsigned 16-bit int
-    static void deserialize(IStream &stream, uint16_t &value) {
+    template<typename Stream>
+    static void deserialize(Stream &stream, uint16_t &value) {
         stream.read(sizeof(value), &value);
         value = le16toh(value);
     }
 
     // 32-bit int
-    static void deserialize(IStream &stream, int32_t &value) {
+    template<typename Stream>
+    static void deserialize(Stream &stream, int32_t &value) {
         stream.read(sizeof(value), &value);
         value = le32toh(value);
     }
 
     // unsigned 32-bit int
-    static void deserialize(IStream &stream, uint32_t &value) {
+    template<typename Stream>
+    static void deserialize(Stream &stream, uint32_t &value) {
         stream.read(sizeof(value), &value);
         value = le32toh(value);
     }
 
     // 64-bit int
-    static void deserialize(IStream &stream, int64_t &value) {
+    template<typename Stream>
+    static void deserialize(Stream &stream, int64_t &value) {
         stream.read(sizeof(value), &value);
         value = le64toh(value);
     }
 
     // unsigned 64-bit int
-    static void deserialize(IStream &stream, uint64_t &value) {
+    template<typename Stream>
+    static void deserialize(Stream &stream, uint64_t &value) {
         stream.read(sizeof(value), &value);
         value = le64toh(value);
     }
 
     // bool
-    static void deserialize(IStream &stream, bool &value) {
+    template<typename Stream>
+    static void deserialize(Stream &stream, bool &value) {
         uint8_t bVal;
         stream.read(sizeof(bVal), &bVal);
         value = static_cast<bool>(bVal);
     }
 
     // PrtocolOpCode
-    static void deserialize(IStream &stream, ProtocolOpCode &value) {
+    template<typename Stream>
+    static void deserialize(Stream &stream, ProtocolOpCode &value) {
         stream.read(sizeof(value), &value);
     }
 
     // std::string
-    static void deserialize(IStream &stream, std::string &str) {
+    template<typename Stream>
+    static void deserialize(Stream &stream, std::string &str) {
         uint32_t length;
         stream.read(sizeof(length), &length);
         length = le32toh(length);
@@ -198,16 +211,28 @@ struct ProtocolDeserialization {
         str.resize(length);
         stream.read(length, &str[0]);
     }
-    static void deserialize(IStream &stream, int length, std::string &str) {
+    template<typename Stream>
+    static void deserialize(Stream &stream, int length, std::string &str) {
         if (length > CYNARA_MAX_ID_LENGTH)
             throw InvalidProtocolException(InvalidProtocolException::IdentifierTooLong);
         str.resize(length);
         stream.read(length, &str[0]);
     }
 
+    // StringView - only streams keeping whole frame in memory (like ProtocolFrameBody) can view
+    template<typename Stream>
+    static void deserialize(Stream &stream, StringView &str) {
+        uint32_t length;
+        stream.read(sizeof(length), &length);
+        length = le32toh(length);
+        if (length > CYNARA_MAX_ID_LENGTH)
+            throw InvalidProtocolException(InvalidProtocolException::IdentifierTooLong);
+        str = stream.view(length);
+    }
+
     // std::vector
-    template<typename T>
-    static void deserialize(IStream &stream, std::vector<T> &vec) {
+    template<typename Stream, typename T>
+    static void deserialize(Stream &stream, std::vector<T> &vec) {
         uint32_t length;
         stream.read(sizeof(length), &length);
         length = le32toh(length);
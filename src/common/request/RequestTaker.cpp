@@ -49,6 +49,11 @@ void RequestTaker::execute(const RequestContext &context UNUSED,
     throw NotImplementedException();
 }
 
+void RequestTaker::execute(const RequestContext &context UNUSED,
+                           const CheckBatchRequest &request UNUSED) {
+    throw NotImplementedException();
+}
+
 void RequestTaker::execute(const RequestContext &context UNUSED,
                            const CheckRequest &request UNUSED) {
     throw NotImplementedException();
@@ -37,6 +37,7 @@ public:
     virtual void execute(const RequestContext &context, const AgentActionRequest &request);
     virtual void execute(const RequestContext &context, const AgentRegisterRequest &request);
     virtual void execute(const RequestContext &context, const CancelRequest &request);
+    virtual void execute(const RequestContext &context, const CheckBatchRequest &request);
     virtual void execute(const RequestContext &context, const CheckRequest &request);
     virtual void execute(const RequestContext &context, const DescriptionListRequest &request);
     virtual void execute(const RequestContext &context, const EraseRequest &request);
@@ -40,6 +40,9 @@ typedef std::shared_ptr<AgentRegisterRequest> AgentRegisterRequestPtr;
 class CancelRequest;
 typedef std::shared_ptr<CancelRequest> CancelRequestPtr;
 
+class CheckBatchRequest;
+typedef std::shared_ptr<CheckBatchRequest> CheckBatchRequestPtr;
+
 class CheckRequest;
 typedef std::shared_ptr<CheckRequest> CheckRequestPtr;
 
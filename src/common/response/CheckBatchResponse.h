@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/common/response/CheckBatchResponse.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file defines response class for batch check request
+ */
+
+#ifndef SRC_COMMON_RESPONSE_CHECKBATCHRESPONSE_H_
+#define SRC_COMMON_RESPONSE_CHECKBATCHRESPONSE_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include <types/PolicyResult.h>
+
+#include <request/pointers.h>
+#include <response/pointers.h>
+#include <response/Response.h>
+
+namespace Cynara {
+
+/*
+ * Return value and result at the same index answer key at that index of batch request.
+ * Result is valid only, when its return value is CYNARA_API_SUCCESS.
+ */
+class CheckBatchResponse : public Response {
+public:
+    CheckBatchResponse(const std::vector<int32_t> &retValues,
+                       const std::vector<PolicyResult> &results,
+                       ProtocolFrameSequenceNumber sequenceNumber) :
+        Response(sequenceNumber), m_retValues(retValues), m_results(results) {
+    }
+
+    virtual ~CheckBatchResponse() {}
+
+    const std::vector<int32_t> &getReturnValues(void) const {
+        return m_retValues;
+    }
+
+    const std::vector<PolicyResult> &getResults(void) const {
+        return m_results;
+    }
+
+    virtual void execute(ResponseTaker &taker, const RequestContext &context) const;
+
+private:
+    const std::vector<int32_t> m_retValues;
+    const std::vector<PolicyResult> m_results;
+};
+
+} // namespace Cynara
+
+#endif /* SRC_COMMON_RESPONSE_CHECKBATCHRESPONSE_H_ */
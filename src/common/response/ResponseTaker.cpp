@@ -49,6 +49,11 @@ void ResponseTaker::execute(const RequestContext &context UNUSED,
     throw NotImplementedException();
 }
 
+void ResponseTaker::execute(const RequestContext &context UNUSED,
+                            const CheckBatchResponse &response UNUSED) {
+    throw NotImplementedException();
+}
+
 void ResponseTaker::execute(const RequestContext &context UNUSED,
                             const CheckResponse &response UNUSED) {
     throw NotImplementedException();
@@ -38,6 +38,7 @@ public:
     virtual void execute(const RequestContext &context, const AgentActionResponse &response);
     virtual void execute(const RequestContext &context, const AgentRegisterResponse &response);
     virtual void execute(const RequestContext &context, const CancelResponse &response);
+    virtual void execute(const RequestContext &context, const CheckBatchResponse &response);
     virtual void execute(const RequestContext &context, const CheckResponse &response);
     virtual void execute(const RequestContext &context, const CodeResponse &response);
     virtual void execute(const RequestContext &context, const DescriptionListResponse &response);
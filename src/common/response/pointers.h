@@ -40,6 +40,9 @@ typedef std::shared_ptr<AgentRegisterResponse> AgentRegisterResponsePtr;
 class CancelResponse;
 typedef std::shared_ptr<CancelResponse> CancelResponsePtr;
 
+class CheckBatchResponse;
+typedef std::shared_ptr<CheckBatchResponse> CheckBatchResponsePtr;
+
 class CheckResponse;
 typedef std::shared_ptr<CheckResponse> CheckResponsePtr;
 
@@ -20,8 +20,9 @@
  * @brief       Implementation of Cynara::PolicyBucket methods
  */
 
+#include <atomic>
 #include <cstring>
-#include <sstream>
+#include <utility>
 
 #include <exceptions/InvalidBucketIdException.h>
 #include <types/PolicyCollection.h>
@@ -34,91 +35,319 @@ namespace Cynara {
 const char PolicyBucket::m_idSeparators[] = "-_";
 
 PolicyBucket::PolicyBucket(const PolicyBucketId &id, const PolicyResult &defaultPolicy)
-    : m_defaultPolicy(defaultPolicy), m_id(id) {
+    : m_contents(std::make_shared<Contents>()), m_defaultPolicy(defaultPolicy), m_id(id) {
     idValidator(id);
 }
 
 PolicyBucket::PolicyBucket(const PolicyBucketId &id, const PolicyCollection &policies)
-    : m_policyCollection(makePolicyMap(policies)), m_defaultPolicy(PredefinedPolicyType::DENY),
+    : m_contents(std::make_shared<Contents>()), m_defaultPolicy(PredefinedPolicyType::DENY),
       m_id(id) {
     idValidator(id);
+    m_contents->policies = makePolicyMap(policies);
+    indexPolicies();
 }
 
 PolicyBucket::PolicyBucket(const PolicyBucketId &id, const PolicyResult &defaultPolicy,
                            const PolicyCollection &policies)
-    : m_policyCollection(makePolicyMap(policies)), m_defaultPolicy(defaultPolicy), m_id(id) {
+    : m_contents(std::make_shared<Contents>()), m_defaultPolicy(defaultPolicy), m_id(id) {
     idValidator(id);
+    m_contents->policies = makePolicyMap(policies);
+    indexPolicies();
 }
 
-PolicyBucket PolicyBucket::filtered(const PolicyKey &key) const {
-    PolicyBucket result(m_id + "_filtered");
+PolicyBucket::Contents &PolicyBucket::ownContents(void) {
+    if (m_contents.use_count() != 1) {
+        m_contents = std::make_shared<Contents>(*m_contents);
+    } else {
+        // Contents may have been just released by another thread, which read them before
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return *m_contents;
+}
 
-    const auto &policies = m_policyCollection;
-    const auto variants = PolicyKeyHelpers::keyVariants(key);
+template<typename Visitor>
+void PolicyBucket::visitMatching(const PolicyKeyVariants &variants, Visitor visitor) const {
+    const auto &contents = *m_contents;
+    for (std::size_t i = 0; i < variants.size(); ++i) {
+        // No policy of this shape, so the variant cannot match
+        if (!(contents.shapes & (1u << variants.shape(i)))) {
+            continue;
+        }
 
-    for (const auto &variant : variants) {
-        const auto policyIter = policies.find(variant);
-        if (policyIter != policies.end()) {
-            result.m_policyCollection[policyIter->first] = policyIter->second;
+        const auto policyIter = contents.policies.find(variants[i]);
+        if (policyIter != contents.policies.end()) {
+            visitor(*policyIter);
         }
     }
+}
+
+PolicyBucket PolicyBucket::filtered(const PolicyKey &key) const {
+    PolicyBucket result(m_id + "_filtered");
+
+    visitMatching(PolicyKeyVariants(key), [&result] (const PolicyMap::value_type &entry) {
+        result.m_contents->policies.insert(entry);
+        result.addShape(PolicyKeyHelpers::wildcardShape(entry.second->key()));
+        result.addLink(entry.first, *entry.second);
+    });
 
     // Inherit original policy
     result.setDefaultPolicy(defaultPolicy());
     return result;
 }
 
-void PolicyBucket::insertPolicy(PolicyPtr policy) {
-    const auto gluedKey = PolicyKeyHelpers::glueKey(policy->key());
-    m_policyCollection[gluedKey] = policy;
+void PolicyBucket::match(const PolicyKey &key, PolicyMatches &matches) const {
+    match(PolicyKeyVariants(key), matches);
 }
 
-void PolicyBucket::deletePolicy(const PolicyKey &key) {
-    const auto gluedKey = PolicyKeyHelpers::glueKey(key);
-    m_policyCollection.erase(gluedKey);
+void PolicyBucket::match(const PolicyKeyVariants &variants, PolicyMatches &matches) const {
+    matches.reset(m_defaultPolicy);
+    visitMatching(variants, [&matches] (const PolicyMap::value_type &entry) {
+        matches.add(*entry.second);
+    });
 }
 
-void PolicyBucket::deletePolicy(std::function<bool(PolicyPtr)> predicate) {
-    auto &policies = m_policyCollection;
+PolicyPtr PolicyBucket::insertPolicy(PolicyPtr policy) {
+    const auto mapKey = PolicyKeyHelpers::mapKey(policy->key());
+    // Replacing policy holds the same features, so ids in map key stay valid
+    auto &mapped = ownContents().policies[mapKey];
+    if (mapped) {
+        removeLink(mapKey, *mapped);
+    } else {
+        addShape(PolicyKeyHelpers::wildcardShape(policy->key()));
+        addFeatures(mapKey, *policy);
+    }
+    addLink(mapKey, *policy);
 
-    for (auto iter = policies.begin(); iter != policies.end(); ) {
-        if (predicate(iter->second)) {
-            policies.erase(iter++);
-        } else {
-            ++iter;
+    PolicyPtr replaced = std::move(mapped);
+    mapped = std::move(policy);
+    return replaced;
+}
+
+// Contents are copied (if shared) only, when there is something to delete
+PolicyPtr PolicyBucket::deletePolicy(const PolicyKey &key) {
+    const auto mapKey = PolicyKeyHelpers::mapKey(key);
+    if (!m_contents->policies.count(mapKey)) {
+        return nullptr;
+    }
+
+    const auto policyIter = ownContents().policies.find(mapKey);
+    PolicyPtr deleted = policyIter->second;
+    erasePolicy(policyIter);
+    return deleted;
+}
+
+void PolicyBucket::deletePolicy(std::function<bool(PolicyPtr)> predicate) {
+    std::vector<PolicyMapKey> mapKeys;
+    for (const auto &entry : m_contents->policies) {
+        if (predicate(entry.second)) {
+            mapKeys.push_back(entry.first);
         }
     }
+
+    for (const auto &mapKey : mapKeys) {
+        erasePolicy(ownContents().policies.find(mapKey));
+    }
+}
+
+std::size_t PolicyBucket::deletePolicies(const PolicyKey &filter) {
+    std::vector<PolicyMapKey> mapKeys;
+    visitFiltered(filter, [&mapKeys] (const PolicyMap::value_type &entry) {
+        mapKeys.push_back(entry.first);
+    });
+
+    for (const auto &mapKey : mapKeys) {
+        erasePolicy(ownContents().policies.find(mapKey));
+    }
+    return mapKeys.size();
+}
+
+std::size_t PolicyBucket::deleteLinks(const PolicyBucketId &bucketId) {
+    if (!linksTo(bucketId)) {
+        return 0;
+    }
+
+    auto &contents = ownContents();
+    const auto linksIter = contents.links.find(bucketId);
+    MapKeys mapKeys;
+    mapKeys.swap(linksIter->second);
+    contents.links.erase(linksIter);
+
+    for (const auto &mapKey : mapKeys) {
+        erasePolicy(contents.policies.find(mapKey));
+    }
+    return mapKeys.size();
 }
 
 PolicyBucket::Policies PolicyBucket::listPolicies(const PolicyKey &filter) const {
     PolicyBucket::Policies policies;
-    for (auto iter = m_policyCollection.begin(); iter != m_policyCollection.end(); ++iter) {
-        auto &policyPtr = iter->second;
-        if (policyPtr->key().matchFilter(filter))
-            policies.push_back(*policyPtr);
-    }
+    visitFiltered(filter, [&policies] (const PolicyMap::value_type &entry) {
+        policies.push_back(*entry.second);
+    });
     return policies;
 }
 
+/*
+ * Filter with any of its features given is matched only against policies having the same feature,
+ * taken from index of the rarest one. Indexes are made on the first such use of the bucket.
+ */
+template<typename Visitor>
+void PolicyBucket::visitFiltered(const PolicyKey &filter, Visitor visitor) const {
+    const PolicyKeyFeature *features[] = { &filter.client(), &filter.user(), &filter.privilege() };
+    const MapKeys *candidates = nullptr;
+
+    for (std::size_t i = 0; i < FEATURE_COUNT; ++i) {
+        if (features[i]->isAny()) {
+            continue;
+        }
+
+        indexFeatures();
+        const auto &index = m_contents->featureIndexes[i];
+        const auto indexIter = index.find(features[i]->id());
+        if (indexIter == index.end()) {
+            return;
+        }
+        if (!candidates || indexIter->second.size() < candidates->size()) {
+            candidates = &indexIter->second;
+        }
+    }
+
+    const auto &policies = m_contents->policies;
+    if (!candidates) {
+        for (const auto &entry : policies) {
+            visitor(entry);
+        }
+        return;
+    }
+
+    for (const auto &mapKey : *candidates) {
+        const auto &entry = *policies.find(mapKey);
+        if (entry.second->key().matchFilter(filter)) {
+            visitor(entry);
+        }
+    }
+}
+
+// Iterator must point to contents owned by this bucket only
+void PolicyBucket::erasePolicy(PolicyMap::iterator policyIter) {
+    const auto &policy = *policyIter->second;
+    removeShape(PolicyKeyHelpers::wildcardShape(policy.key()));
+    removeLink(policyIter->first, policy);
+    removeFeatures(policyIter->first, policy);
+    m_contents->policies.erase(policyIter);
+}
+
 PolicyBucket::BucketIds PolicyBucket::getSubBuckets(void) const {
     PolicyBucket::BucketIds buckets;
-    for (auto iter = m_policyCollection.begin(); iter != m_policyCollection.end(); ++iter) {
-        auto &policyPtr = iter->second;
-        if (policyPtr->result().policyType() == PredefinedPolicyType::BUCKET)
-            buckets.insert(policyPtr->result().metadata());
+    for (const auto &link : m_contents->links) {
+        buckets.insert(buckets.end(), link.first);
     }
     return buckets;
 }
 
+PolicyBucket::Policies PolicyBucket::listLinks(void) const {
+    PolicyBucket::Policies policies;
+    for (const auto &link : m_contents->links) {
+        for (const auto &mapKey : link.second) {
+            policies.push_back(*m_contents->policies.find(mapKey)->second);
+        }
+    }
+    return policies;
+}
+
 PolicyMap PolicyBucket::makePolicyMap(const PolicyCollection &policies) {
     PolicyMap result;
     for (const auto &policy : policies) {
-        const auto gluedKey = PolicyKeyHelpers::glueKey(policy->key());
-        result[gluedKey] = policy;
+        insertIntoMap(result, policy);
     }
     return result;
 }
 
+bool PolicyBucket::insertIntoMap(PolicyMap &policyMap, PolicyPtr policy) {
+    // Replacing policy holds the same features, so ids in map key stay valid
+    auto &mapped = policyMap[PolicyKeyHelpers::mapKey(policy->key())];
+    const bool inserted = !mapped;
+    mapped = std::move(policy);
+    return inserted;
+}
+
+void PolicyBucket::indexPolicies(void) {
+    for (const auto &entry : m_contents->policies) {
+        addShape(PolicyKeyHelpers::wildcardShape(entry.second->key()));
+        addLink(entry.first, *entry.second);
+    }
+}
+
+void PolicyBucket::addShape(unsigned shape) {
+    ++m_contents->shapeCounts[shape];
+    m_contents->shapes |= 1u << shape;
+}
+
+void PolicyBucket::removeShape(unsigned shape) {
+    if (--m_contents->shapeCounts[shape] == 0) {
+        m_contents->shapes &= ~(1u << shape);
+    }
+}
+
+void PolicyBucket::addLink(const PolicyMapKey &mapKey, const Policy &policy) {
+    if (policy.result().policyType() == PredefinedPolicyType::BUCKET) {
+        m_contents->links[policy.result().metadata()].insert(mapKey);
+    }
+}
+
+void PolicyBucket::removeLink(const PolicyMapKey &mapKey, const Policy &policy) {
+    if (policy.result().policyType() != PredefinedPolicyType::BUCKET) {
+        return;
+    }
+
+    auto &links = m_contents->links;
+    const auto linksIter = links.find(policy.result().metadata());
+    if (linksIter != links.end() && linksIter->second.erase(mapKey)
+        && linksIter->second.empty()) {
+        links.erase(linksIter);
+    }
+}
+
+void PolicyBucket::indexFeatures(void) const {
+    if (m_contents->featuresIndexed) {
+        return;
+    }
+
+    m_contents->featuresIndexed = true;
+    for (const auto &entry : m_contents->policies) {
+        addFeatures(entry.first, *entry.second);
+    }
+}
+
+void PolicyBucket::addFeatures(const PolicyMapKey &mapKey, const Policy &policy) const {
+    if (!m_contents->featuresIndexed) {
+        return;
+    }
+
+    const auto &key = policy.key();
+    auto &featureIndexes = m_contents->featureIndexes;
+    featureIndexes[CLIENT][key.client().id()].insert(mapKey);
+    featureIndexes[USER][key.user().id()].insert(mapKey);
+    featureIndexes[PRIVILEGE][key.privilege().id()].insert(mapKey);
+}
+
+void PolicyBucket::removeFeatures(const PolicyMapKey &mapKey, const Policy &policy) {
+    if (!m_contents->featuresIndexed) {
+        return;
+    }
+
+    const auto &key = policy.key();
+    const PolicyKeyFeature::IdType ids[] = { key.client().id(), key.user().id(),
+                                             key.privilege().id() };
+    for (std::size_t i = 0; i < FEATURE_COUNT; ++i) {
+        auto &index = m_contents->featureIndexes[i];
+        const auto indexIter = index.find(ids[i]);
+        if (indexIter != index.end() && indexIter->second.erase(mapKey)
+            && indexIter->second.empty()) {
+            index.erase(indexIter);
+        }
+    }
+}
+
 void PolicyBucket::idValidator(const PolicyBucketId &id) {
     auto isCharInvalid = [] (char c) {
         return !(std::isalnum(c) || isIdSeparator(c));
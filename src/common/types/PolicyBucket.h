@@ -26,9 +26,15 @@
 #define SRC_COMMON_TYPES_POLICYBUCKET_H_
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <exceptions/NotImplementedException.h>
@@ -37,6 +43,8 @@
 #include <types/PolicyBucketId.h>
 #include <types/PolicyCollection.h>
 #include <types/PolicyKey.h>
+#include <types/PolicyKeyVariants.h>
+#include <types/PolicyMatches.h>
 #include <types/PolicyType.h>
 
 namespace Cynara {
@@ -63,11 +71,29 @@ public:
                  const PolicyResult &defaultPolicy,
                  const PolicyCollection &policies);
 
+    // Copies share policies until one of them is changed, so copying is cheap. Moves copy,
+    // so moved-from bucket stays usable.
+    PolicyBucket(const PolicyBucket &) = default;
+    PolicyBucket &operator=(const PolicyBucket &) = default;
+
     PolicyBucket filtered(const PolicyKey &key) const;
-    void insertPolicy(PolicyPtr policy);
-    void deletePolicy(const PolicyKey &key);
+    void match(const PolicyKey &key, PolicyMatches &matches) const;
+    void match(const PolicyKeyVariants &variants, PolicyMatches &matches) const;
+    // Both return policy replaced or deleted (if any), so its link can be accounted for
+    PolicyPtr insertPolicy(PolicyPtr policy);
+    PolicyPtr deletePolicy(const PolicyKey &key);
     Policies listPolicies(const PolicyKey &filter) const;
+    // Deletes policies matching filter; returns number of them
+    std::size_t deletePolicies(const PolicyKey &filter);
     BucketIds getSubBuckets(void) const;
+    // Policies linking to other buckets
+    Policies listLinks(void) const;
+
+    bool linksTo(const PolicyBucketId &bucketId) const {
+        return m_contents->links.count(bucketId) > 0;
+    }
+    // Deletes policies linking to given bucket; returns number of them
+    std::size_t deleteLinks(const PolicyBucketId &bucketId);
 
     // TODO: Try to change interface, so this method is not needed
     void deletePolicy(std::function<bool(PolicyPtr)> predicate);
@@ -75,19 +101,19 @@ public:
     static PolicyMap makePolicyMap(const PolicyCollection &policies);
 
     const_policy_iterator begin(void) const {
-        return const_policy_iterator(m_policyCollection.begin());
+        return const_policy_iterator(m_contents->policies.begin());
     }
 
     const_policy_iterator end(void) const {
-        return const_policy_iterator(m_policyCollection.end());
+        return const_policy_iterator(m_contents->policies.end());
     }
 
     PolicyMap::size_type size(void) const {
-        return m_policyCollection.size();
+        return m_contents->policies.size();
     }
 
     bool empty(void) const {
-        return m_policyCollection.empty();
+        return m_contents->policies.empty();
     }
 
     const PolicyResult &defaultPolicy(void) const {
@@ -104,10 +130,63 @@ public:
     }
 
 private:
+    // Number of policies of every wildcard shape (see PolicyKeyHelpers::wildcardShape)
+    typedef std::array<std::size_t, PolicyKeyVariants::maxSize> ShapeCounts;
+
+    template<typename Visitor>
+    void visitMatching(const PolicyKeyVariants &variants, Visitor visitor) const;
+    template<typename Visitor>
+    void visitFiltered(const PolicyKey &filter, Visitor visitor) const;
+    static bool insertIntoMap(PolicyMap &policyMap, PolicyPtr policy);
+    void erasePolicy(PolicyMap::iterator policyIter);
+
+    struct Contents;
+    // Contents of this bucket only, copied first if shared with other buckets
+    Contents &ownContents(void);
+
+    void indexPolicies(void);
+    void addShape(unsigned shape);
+    void removeShape(unsigned shape);
+    void addLink(const PolicyMapKey &mapKey, const Policy &policy);
+    void removeLink(const PolicyMapKey &mapKey, const Policy &policy);
+    void indexFeatures(void) const;
+    void addFeatures(const PolicyMapKey &mapKey, const Policy &policy) const;
+    void removeFeatures(const PolicyMapKey &mapKey, const Policy &policy);
+
     static void idValidator(const PolicyBucketId &id);
     static bool isIdSeparator(char c);
 
-    PolicyMap m_policyCollection;
+    // Keys of policies linking to other buckets, by bucket linked to
+    typedef std::unordered_set<PolicyMapKey, PolicyMapKeyHash> MapKeys;
+    typedef std::map<PolicyBucketId, MapKeys> Links;
+    // Keys of policies by id of their client, user and privilege (in this order)
+    enum : std::size_t { CLIENT, USER, PRIVILEGE, FEATURE_COUNT };
+    typedef std::unordered_map<PolicyKeyFeature::IdType, MapKeys> FeatureIndex;
+    typedef std::array<FeatureIndex, FEATURE_COUNT> FeatureIndexes;
+
+    /*
+     * Shared contents are never changed, so they may be read from other threads (e.g. by saving
+     * of database) while bucket is changed. Feature indexes are the exception - they are made
+     * lazily by the thread owning the bucket, so other threads must not list or erase policies
+     * with filter.
+     */
+    struct Contents {
+        Contents() : shapeCounts(), shapes(0), featuresIndexed(false) {}
+        // Feature indexes are not copied; they are made again, when needed
+        Contents(const Contents &other)
+            : policies(other.policies), shapeCounts(other.shapeCounts), shapes(other.shapes),
+              links(other.links), featuresIndexed(false) {}
+
+        PolicyMap policies;
+        ShapeCounts shapeCounts;
+        std::uint8_t shapes;
+        Links links;
+        // Made only for buckets, which are listed or erased with filter
+        bool featuresIndexed;
+        FeatureIndexes featureIndexes;
+    };
+
+    std::shared_ptr<Contents> m_contents;
     PolicyResult m_defaultPolicy;
     PolicyBucketId m_id;
     static const char m_idSeparators[];
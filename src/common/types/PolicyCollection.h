@@ -27,12 +27,18 @@
 #include <unordered_map>
 #include <vector>
 
+#include <containers/FlatHashMap.h>
 #include "types/pointers.h"
+#include "types/PolicyMapKey.h"
 
 namespace Cynara {
 
 typedef std::vector<PolicyPtr> PolicyCollection;
-typedef std::unordered_map<std::string, PolicyPtr> PolicyMap;
+#ifdef FLAT_POLICY_MAP
+typedef FlatHashMap<PolicyMapKey, PolicyPtr, PolicyMapKeyHash> PolicyMap;
+#else
+typedef std::unordered_map<PolicyMapKey, PolicyPtr, PolicyMapKeyHash> PolicyMap;
+#endif
 
 class const_policy_iterator : public PolicyMap::const_iterator
 {
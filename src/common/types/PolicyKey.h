@@ -27,22 +27,59 @@
 
 #include <string>
 #include <tuple>
+#include <utility>
+
+#include <containers/StringView.h>
+#include <types/SymbolTable.h>
 
 namespace Cynara {
 
 class PolicyKey;
 
+/*
+ * Values of features are interned in SymbolTable, so features sharing a value share a single
+ * copy of the string and are compared by symbol ids.
+ * Features of keys which are only sent away, like ones of client checks, are uninterned:
+ * making them does not lock SymbolTable, but they have no id and cannot be put into buckets.
+ */
 class PolicyKeyFeature {
 friend class PolicyKey;
 
 public:
-    PolicyKeyFeature(const PolicyKeyFeature &) = default;
-    PolicyKeyFeature(PolicyKeyFeature &&) = default;
+    struct Uninterned {};
 
-    PolicyKeyFeature& operator=(const PolicyKeyFeature &) = default;
-    PolicyKeyFeature& operator=(PolicyKeyFeature &&) = default;
+    PolicyKeyFeature(const PolicyKeyFeature &other) : m_symbol(other.m_symbol),
+        m_isAny(other.m_isAny) {
+        SymbolTable::acquire(m_symbol);
+    }
+
+    // Symbol is taken over, so no reference counts are touched
+    PolicyKeyFeature(PolicyKeyFeature &&other) : m_symbol(other.m_symbol),
+        m_isAny(other.m_isAny) {
+        other.m_symbol = SymbolTable::instance().empty();
+        other.m_isAny = false;
+    }
+
+    PolicyKeyFeature& operator=(const PolicyKeyFeature &other) {
+        SymbolTable::acquire(other.m_symbol);
+        SymbolTable::instance().release(m_symbol);
+        m_symbol = other.m_symbol;
+        m_isAny = other.m_isAny;
+        return *this;
+    }
+
+    PolicyKeyFeature& operator=(PolicyKeyFeature &&other) {
+        std::swap(m_symbol, other.m_symbol);
+        std::swap(m_isAny, other.m_isAny);
+        return *this;
+    }
+
+    ~PolicyKeyFeature() {
+        SymbolTable::instance().release(m_symbol);
+    }
 
     typedef std::string ValueType;
+    typedef SymbolTable::Id IdType;
 
     static PolicyKeyFeature create(ValueType value) {
         return PolicyKeyFeature(value);
@@ -63,13 +100,17 @@ public:
     }
 
     bool operator==(const PolicyKeyFeature::ValueType &other) const {
-        return valuesMatch(*this, PolicyKeyFeature(other));
+        return value() == other;
     }
 
     const std::string &toString(void) const;
 
     const ValueType &value(void) const {
-        return m_value;
+        return m_symbol->value();
+    }
+
+    IdType id(void) const {
+        return m_symbol->id();
     }
 
     bool isAny(void) const {
@@ -81,19 +122,30 @@ public:
     }
 
 protected:
-    explicit PolicyKeyFeature(const ValueType &value) : m_value(value),
-        m_isAny(value == anyValue()) {}
+    explicit PolicyKeyFeature(const ValueType &value)
+        : m_symbol(SymbolTable::instance().acquire(value)), m_isAny(value == anyValue()) {}
+
+    explicit PolicyKeyFeature(StringView value)
+        : m_symbol(SymbolTable::instance().acquire(value)), m_isAny(value == anyValue()) {}
+
+    PolicyKeyFeature(const ValueType &value, Uninterned)
+        : m_symbol(SymbolTable::acquireUninterned(value)), m_isAny(value == anyValue()) {}
 
     static bool anyAny(const PolicyKeyFeature &pkf1, const PolicyKeyFeature &pkf2) {
         return pkf1.isAny() || pkf2.isAny();
     }
 
     static bool valuesMatch(const PolicyKeyFeature &pkf1, const PolicyKeyFeature &pkf2) {
-        return pkf1.value() == pkf2.value();
+        if (pkf1.m_symbol == pkf2.m_symbol) {
+            return true;
+        }
+        // Interned values are equal only if they are the same symbol
+        return !(pkf1.m_symbol->interned() && pkf2.m_symbol->interned())
+               && pkf1.value() == pkf2.value();
     }
 
 private:
-    ValueType m_value;
+    const SymbolTable::Symbol *m_symbol;
     bool m_isAny;
 
     const static std::string &wildcardValue(void);
@@ -113,6 +165,18 @@ public:
               const PolicyKeyFeature::ValueType &privilegeId)
         : m_client(clientId), m_user(userId), m_privilege(privilegeId) {};
 
+    // Key of a single check, which is only serialized; see PolicyKeyFeature::Uninterned
+    PolicyKey(const PolicyKeyFeature::ValueType &clientId,
+              const PolicyKeyFeature::ValueType &userId,
+              const PolicyKeyFeature::ValueType &privilegeId, PolicyKeyFeature::Uninterned)
+        : m_client(clientId, PolicyKeyFeature::Uninterned()),
+          m_user(userId, PolicyKeyFeature::Uninterned()),
+          m_privilege(privilegeId, PolicyKeyFeature::Uninterned()) {};
+
+    // Features viewed in received frames are not copied, unless they are new symbols
+    PolicyKey(StringView clientId, StringView userId, StringView privilegeId)
+        : m_client(clientId), m_user(userId), m_privilege(privilegeId) {};
+
     PolicyKey(const PolicyKey &) = default;
     PolicyKey(PolicyKey &&) = default;
 
@@ -20,45 +20,43 @@
  * @brief       Helper functions to manage Cynara::PolicyKey
  */
 
-#include <sstream>
-
 #include "PolicyKeyHelpers.h"
 
 namespace Cynara {
 
-std::string PolicyKeyHelpers::glueKey(const PolicyKey &key) {
-    return glueKey(key.client(), key.user(), key.privilege());
+PolicyMapKey PolicyKeyHelpers::mapKey(const PolicyKey &key) {
+    const auto client = key.client().id();
+    const auto user = key.user().id();
+    const auto privilege = key.privilege().id();
+
+    return PolicyMapKey(client, user, privilege, hashKey(client, user, privilege));
 }
 
-std::string PolicyKeyHelpers::glueKey(const PolicyKeyFeature &client,
-                                      const PolicyKeyFeature &user,
-                                      const PolicyKeyFeature &privilege) {
-    const std::string sep = ";";
-    const std::string c = client.toString();
-    const std::string u = user.toString();
-    const std::string p = privilege.toString();
+std::size_t PolicyKeyHelpers::hashKey(PolicyKeyFeature::IdType client,
+                                      PolicyKeyFeature::IdType user,
+                                      PolicyKeyFeature::IdType privilege) {
+    // Features are combined in order, so swapping them yields different hash
+    std::size_t hash = client;
+    hash ^= user + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= privilege + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
 
-    std::ostringstream glued;
-    glued << c << sep << u << sep << p << sep << c.size() << sep << u.size() << sep << p.size();
-    return glued.str();
-};
+unsigned PolicyKeyHelpers::wildcardShape(const PolicyKey &key) {
+    return wildcardShape(key.client().id(), key.user().id(), key.privilege().id());
+}
 
-std::vector<std::string> PolicyKeyHelpers::keyVariants(const PolicyKey &key) {
-    const auto &client = key.client();
-    const auto &user = key.user();
-    const auto &privilege = key.privilege();
-    const auto w = PolicyKeyFeature::createWildcard();
+unsigned PolicyKeyHelpers::wildcardShape(PolicyKeyFeature::IdType client,
+                                         PolicyKeyFeature::IdType user,
+                                         PolicyKeyFeature::IdType privilege) {
+    // Bits of shape tell, which features are wildcards (same as bits of PolicyKeyVariants)
+    const auto w = wildcard().id();
+    return (client == w ? 1 : 0) | (user == w ? 2 : 0) | (privilege == w ? 4 : 0);
+}
 
-    return {
-        glueKey(client, user, privilege),
-        glueKey(w, user, privilege),
-        glueKey(client, w, privilege),
-        glueKey(client, user, w),
-        glueKey(w, w, privilege),
-        glueKey(w, user, w),
-        glueKey(client, w, w),
-        glueKey(w, w, w),
-    };
+const PolicyKeyFeature &PolicyKeyHelpers::wildcard(void) {
+    static const PolicyKeyFeature wildcardFeature = PolicyKeyFeature::createWildcard();
+    return wildcardFeature;
 }
 
 } /* namespace Cynara */
@@ -22,19 +22,22 @@
 #ifndef SRC_COMMON_TYPES_POLICYKEYHELPERS_H_
 #define SRC_COMMON_TYPES_POLICYKEYHELPERS_H_
 
-#include <string>
-#include <vector>
+#include <cstddef>
 
 #include <types/PolicyKey.h>
+#include <types/PolicyMapKey.h>
 
 namespace Cynara {
 
 class PolicyKeyHelpers {
 public:
-    static std::string glueKey(const PolicyKey &client);
-    static std::string glueKey(const PolicyKeyFeature &client, const PolicyKeyFeature &user,
-                               const PolicyKeyFeature &privilege);
-    static std::vector<std::string> keyVariants(const PolicyKey &key);
+    static PolicyMapKey mapKey(const PolicyKey &key);
+    static std::size_t hashKey(PolicyKeyFeature::IdType client, PolicyKeyFeature::IdType user,
+                               PolicyKeyFeature::IdType privilege);
+    static unsigned wildcardShape(const PolicyKey &key);
+    static unsigned wildcardShape(PolicyKeyFeature::IdType client, PolicyKeyFeature::IdType user,
+                                  PolicyKeyFeature::IdType privilege);
+    static const PolicyKeyFeature &wildcard(void);
 };
 
 } /* namespace Cynara */
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/common/types/PolicyKeyVariants.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Implementation of Cynara::PolicyKeyVariants methods
+ */
+
+#include <types/PolicyKeyHelpers.h>
+
+#include "PolicyKeyVariants.h"
+
+namespace Cynara {
+
+PolicyKeyVariants::PolicyKeyVariants(const PolicyKey &key) : m_key(key), m_size(0) {
+    const auto w = PolicyKeyHelpers::wildcard().id();
+    const auto client = key.client().id();
+    const auto user = key.user().id();
+    const auto privilege = key.privilege().id();
+
+    // Bits of variant tell, which features are replaced with wildcard
+    for (unsigned variant = 0; variant < maxSize; ++variant) {
+        const bool wildClient = variant & 1;
+        const bool wildUser = variant & 2;
+        const bool wildPrivilege = variant & 4;
+
+        // Skip variants duplicating one already created
+        if ((wildClient && client == w) || (wildUser && user == w)
+            || (wildPrivilege && privilege == w)) {
+            continue;
+        }
+
+        const auto c = wildClient ? w : client;
+        const auto u = wildUser ? w : user;
+        const auto p = wildPrivilege ? w : privilege;
+        m_shapes[m_size] = PolicyKeyHelpers::wildcardShape(c, u, p);
+        m_variants[m_size++] = PolicyMapKey(c, u, p, PolicyKeyHelpers::hashKey(c, u, p));
+    }
+}
+
+} /* namespace Cynara */
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/common/types/PolicyKeyVariants.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file defines PolicyKeyVariants - map keys of policies, which can match
+                a checked key
+ */
+
+#ifndef SRC_COMMON_TYPES_POLICYKEYVARIANTS_H_
+#define SRC_COMMON_TYPES_POLICYKEYVARIANTS_H_
+
+#include <array>
+#include <cstddef>
+
+#include <types/PolicyKey.h>
+#include <types/PolicyMapKey.h>
+
+namespace Cynara {
+
+/*
+ * Variants are the checked key with features replaced by wildcards in every possible way.
+ * They are computed once per check and reused for every bucket visited. Variants consist of ids
+ * of features of the key, so the key must outlive them.
+ * Every variant has a distinct wildcard shape, which lets buckets skip variants of shapes they do
+ * not contain.
+ */
+class PolicyKeyVariants {
+public:
+    static const std::size_t maxSize = 8;
+
+    typedef std::array<PolicyMapKey, maxSize> Container;
+    typedef Container::value_type value_type;
+    typedef Container::const_iterator const_iterator;
+
+    explicit PolicyKeyVariants(const PolicyKey &key);
+
+    PolicyKeyVariants(const PolicyKeyVariants &) = delete;
+    PolicyKeyVariants& operator=(const PolicyKeyVariants &) = delete;
+
+    const PolicyKey &key(void) const {
+        return m_key;
+    }
+
+    const_iterator begin(void) const {
+        return m_variants.begin();
+    }
+
+    const_iterator end(void) const {
+        return m_variants.begin() + m_size;
+    }
+
+    std::size_t size(void) const {
+        return m_size;
+    }
+
+    const value_type &operator[](std::size_t index) const {
+        return m_variants[index];
+    }
+
+    // Wildcard shape of variant at given position (see PolicyKeyHelpers::wildcardShape)
+    unsigned shape(std::size_t index) const {
+        return m_shapes[index];
+    }
+
+private:
+    const PolicyKey &m_key;
+    Container m_variants;
+    std::array<unsigned char, maxSize> m_shapes;
+    std::size_t m_size;
+};
+
+} /* namespace Cynara */
+
+#endif /* SRC_COMMON_TYPES_POLICYKEYVARIANTS_H_ */
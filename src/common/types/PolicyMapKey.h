@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/common/types/PolicyMapKey.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file defines PolicyMapKey - key of policies in PolicyMap
+ */
+
+#ifndef SRC_COMMON_TYPES_POLICYMAPKEY_H_
+#define SRC_COMMON_TYPES_POLICYMAPKEY_H_
+
+#include <cstddef>
+
+#include <types/PolicyKey.h>
+
+namespace Cynara {
+
+/*
+ * Consists of ids of interned features, which stay valid as long as the features are held.
+ * Keys stored in PolicyMap are made of features of the policy they are mapped to.
+ * Hash is computed by creator of the key (see PolicyKeyHelpers), so variants of a checked key
+ * are hashed only once per check.
+ */
+class PolicyMapKey {
+public:
+    typedef PolicyKeyFeature::IdType IdType;
+
+    // Only a placeholder, must be assigned before use
+    PolicyMapKey() : m_client(0), m_user(0), m_privilege(0), m_hash(0) {}
+
+    PolicyMapKey(IdType client, IdType user, IdType privilege, std::size_t hash)
+        : m_client(client), m_user(user), m_privilege(privilege), m_hash(hash) {}
+
+    bool operator==(const PolicyMapKey &other) const {
+        return m_client == other.m_client && m_user == other.m_user
+               && m_privilege == other.m_privilege;
+    }
+
+    std::size_t hash(void) const {
+        return m_hash;
+    }
+
+private:
+    IdType m_client;
+    IdType m_user;
+    IdType m_privilege;
+    std::size_t m_hash;
+};
+
+struct PolicyMapKeyHash {
+    std::size_t operator()(const PolicyMapKey &key) const {
+        return key.hash();
+    }
+};
+
+} /* namespace Cynara */
+
+#endif /* SRC_COMMON_TYPES_POLICYMAPKEY_H_ */
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/common/types/PolicyMatches.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file defines PolicyMatches - policies of a single bucket
+                matching a key, gathered without copying them
+ */
+
+#ifndef SRC_COMMON_TYPES_POLICYMATCHES_H_
+#define SRC_COMMON_TYPES_POLICYMATCHES_H_
+
+#include <array>
+#include <cstddef>
+
+#include <types/Policy.h>
+#include <types/PolicyResult.h>
+
+namespace Cynara {
+
+/*
+ * Holds pointers into a bucket, so it is valid only as long as the bucket is not modified.
+ * A key can be matched by at most one policy per key variant, hence the fixed capacity.
+ */
+class PolicyMatches {
+public:
+    static const std::size_t maxSize = 8;
+
+    typedef std::array<const Policy *, maxSize> Container;
+    typedef Container::value_type value_type;
+    typedef Container::const_iterator const_iterator;
+
+    PolicyMatches() : m_size(0), m_defaultPolicy(nullptr) {}
+
+    void reset(const PolicyResult &defaultPolicy) {
+        m_size = 0;
+        m_defaultPolicy = &defaultPolicy;
+    }
+
+    void add(const Policy &policy) {
+        m_policies[m_size++] = &policy;
+    }
+
+    const PolicyResult &defaultPolicy(void) const {
+        return *m_defaultPolicy;
+    }
+
+    const_iterator begin(void) const {
+        return m_policies.begin();
+    }
+
+    const_iterator end(void) const {
+        return m_policies.begin() + m_size;
+    }
+
+    std::size_t size(void) const {
+        return m_size;
+    }
+
+    bool empty(void) const {
+        return m_size == 0;
+    }
+
+private:
+    Container m_policies;
+    std::size_t m_size;
+    const PolicyResult *m_defaultPolicy;
+};
+
+} /* namespace Cynara */
+
+#endif /* SRC_COMMON_TYPES_POLICYMATCHES_H_ */
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/common/types/SymbolTable.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Implementation of Cynara::SymbolTable methods
+ */
+
+#include "SymbolTable.h"
+
+namespace Cynara {
+
+const SymbolTable::Id SymbolTable::noId;
+
+SymbolTable::SymbolTable() : m_nextId(0) {
+    auto empty = new Symbol(std::string(), m_nextId++);
+    m_symbols.emplace(StringView(empty->m_value), empty);
+    m_empty = empty;
+}
+
+SymbolTable &SymbolTable::instance(void) {
+    // Never destroyed, so symbols held by static objects can be released at exit
+    static SymbolTable *table = new SymbolTable();
+    return *table;
+}
+
+const SymbolTable::Symbol *SymbolTable::acquire(StringView value) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_symbols.find(value);
+    if (it != m_symbols.end()) {
+        it->second->m_refCount.fetch_add(1, std::memory_order_relaxed);
+        return it->second;
+    }
+
+    Id id;
+    if (m_freeIds.empty()) {
+        id = m_nextId++;
+    } else {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+
+    auto symbol = new Symbol(value.str(), id);
+    m_symbols.emplace(StringView(symbol->m_value), symbol);
+    return symbol;
+}
+
+void SymbolTable::release(const Symbol *symbol) {
+    if (symbol == m_empty) {
+        return;
+    }
+
+    // Nothing else can find uninterned symbol, so it is deleted by its last holder
+    if (!symbol->interned()) {
+        if (symbol->m_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete symbol;
+        }
+        return;
+    }
+
+    // Fast path - symbol stays alive, because it is held by someone else
+    auto refCount = symbol->m_refCount.load(std::memory_order_relaxed);
+    while (refCount > 1) {
+        if (symbol->m_refCount.compare_exchange_weak(refCount, refCount - 1,
+                                                     std::memory_order_release,
+                                                     std::memory_order_relaxed)) {
+            return;
+        }
+    }
+
+    // Possibly last holder - only acquire() can revive symbol and it is serialized by mutex
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (symbol->m_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        m_symbols.erase(StringView(symbol->m_value));
+        m_freeIds.push_back(symbol->m_id);
+        delete symbol;
+    }
+}
+
+std::size_t SymbolTable::size(void) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_symbols.size();
+}
+
+} /* namespace Cynara */
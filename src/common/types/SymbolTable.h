@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/common/types/SymbolTable.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file defines SymbolTable - process wide table of interned strings
+ */
+
+#ifndef SRC_COMMON_TYPES_SYMBOLTABLE_H_
+#define SRC_COMMON_TYPES_SYMBOLTABLE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <containers/StringView.h>
+
+namespace Cynara {
+
+/*
+ * Every distinct string is stored once and identified by a 32-bit id, so symbols can be
+ * compared and hashed as integers. Symbols are reference counted - a symbol is removed
+ * (and its id reused) when its last holder releases it.
+ * Symbols are held by PolicyKeyFeature, which is the only intended user of this class.
+ * Uninterned symbols are not put into the table, so they are made and released without its
+ * lock; they have no id and are equal to other symbols only by value. Empty symbol is never
+ * removed, so moved-from features can hold it without counting references.
+ */
+class SymbolTable {
+public:
+    typedef std::uint32_t Id;
+    static const Id noId = static_cast<Id>(-1);
+
+    class Symbol {
+    public:
+        const std::string &value(void) const {
+            return m_value;
+        }
+
+        Id id(void) const {
+            return m_id;
+        }
+
+        bool interned(void) const {
+            return m_id != noId;
+        }
+
+    private:
+        friend class SymbolTable;
+
+        Symbol(const std::string &value, Id id) : m_value(value), m_id(id), m_refCount(1) {}
+
+        const std::string m_value;
+        const Id m_id;
+        mutable std::atomic<std::size_t> m_refCount;
+    };
+
+    static SymbolTable &instance(void);
+
+    // Value is copied only, when symbol is created
+    const Symbol *acquire(StringView value);
+    void release(const Symbol *symbol);
+
+    static const Symbol *acquireUninterned(StringView value) {
+        return new Symbol(value.str(), noId);
+    }
+
+    const Symbol *empty(void) const {
+        return m_empty;
+    }
+
+    // Symbol must be already held by caller
+    static void acquire(const Symbol *symbol) {
+        symbol->m_refCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::size_t size(void);
+
+private:
+    SymbolTable();
+
+    // FNV-1a, as views cannot be hashed by std::hash
+    struct ValueHash {
+        std::size_t operator()(const StringView &value) const {
+            std::uint64_t hash = 0xcbf29ce484222325ull;
+            for (std::size_t i = 0; i < value.size(); ++i) {
+                hash = (hash ^ static_cast<unsigned char>(value.data()[i])) * 0x100000001b3ull;
+            }
+            return static_cast<std::size_t>(hash);
+        }
+    };
+
+    // Keys view values of symbols, so strings are not duplicated and can be looked up
+    // without creating them
+    typedef std::unordered_map<StringView, Symbol *, ValueHash> Symbols;
+
+    std::mutex m_mutex;
+    Symbols m_symbols;
+    std::vector<Id> m_freeIds;
+    Id m_nextId;
+    const Symbol *m_empty;
+};
+
+} /* namespace Cynara */
+
+#endif /* SRC_COMMON_TYPES_SYMBOLTABLE_H_ */
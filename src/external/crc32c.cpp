@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/external/crc32c.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       CRC32C (Castagnoli) checksum, hardware accelerated where available
+ */
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+#include <crc32c.h>
+
+namespace Cynara {
+
+namespace {
+
+// Reflected Castagnoli polynomial
+const std::uint32_t POLYNOMIAL = 0x82F63B78;
+
+// Tables for slicing-by-8: table[k][b] is CRC of byte b followed by k zero bytes
+struct Tables {
+    Tables() {
+        for (std::uint32_t b = 0; b < 256; ++b) {
+            std::uint32_t crc = b;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ ((crc & 1) ? POLYNOMIAL : 0);
+            }
+            table[0][b] = crc;
+        }
+        for (std::uint32_t b = 0; b < 256; ++b) {
+            for (int k = 1; k < 8; ++k) {
+                table[k][b] = (table[k - 1][b] >> 8) ^ table[0][table[k - 1][b] & 0xFF];
+            }
+        }
+    }
+
+    std::uint32_t table[8][256];
+};
+
+std::uint32_t updateSoftware(std::uint32_t crc, const unsigned char *data, std::size_t size) {
+    static const Tables tables;
+    const auto &table = tables.table;
+
+    while (size >= 8) {
+        std::uint32_t low, high;
+        memcpy(&low, data, sizeof(low));
+        memcpy(&high, data + 4, sizeof(high));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        low = __builtin_bswap32(low);
+        high = __builtin_bswap32(high);
+#endif
+        low ^= crc;
+        crc = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF]
+            ^ table[5][(low >> 16) & 0xFF] ^ table[4][low >> 24]
+            ^ table[3][high & 0xFF] ^ table[2][(high >> 8) & 0xFF]
+            ^ table[1][(high >> 16) & 0xFF] ^ table[0][high >> 24];
+        data += 8;
+        size -= 8;
+    }
+    while (size-- > 0) {
+        crc = (crc >> 8) ^ table[0][(crc ^ *data++) & 0xFF];
+    }
+    return crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2")))
+std::uint32_t updateHardware(std::uint32_t crc, const unsigned char *data, std::size_t size) {
+    std::uint64_t crc64 = crc;
+    while (size >= 8) {
+        std::uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc64 = __builtin_ia32_crc32di(crc64, word);
+        data += 8;
+        size -= 8;
+    }
+    crc = static_cast<std::uint32_t>(crc64);
+    while (size-- > 0) {
+        crc = __builtin_ia32_crc32qi(crc, *data++);
+    }
+    return crc;
+}
+
+bool hardwareSupported(void) {
+    static const bool supported = __builtin_cpu_supports("sse4.2");
+    return supported;
+}
+#elif defined(__ARM_FEATURE_CRC32)
+std::uint32_t updateHardware(std::uint32_t crc, const unsigned char *data, std::size_t size) {
+    while (size >= 4) {
+        std::uint32_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = __crc32cw(crc, word);
+        data += 4;
+        size -= 4;
+    }
+    while (size-- > 0) {
+        crc = __crc32cb(crc, *data++);
+    }
+    return crc;
+}
+
+bool hardwareSupported(void) {
+    return true;
+}
+#else
+std::uint32_t updateHardware(std::uint32_t crc, const unsigned char *data, std::size_t size) {
+    return updateSoftware(crc, data, size);
+}
+
+bool hardwareSupported(void) {
+    return false;
+}
+#endif
+
+} // namespace
+
+const std::string generateCRC32C(const std::string &data) {
+    return generateCRC32C(data.data(), data.size());
+}
+
+const std::string generateCRC32C(const void *data, std::size_t size) {
+    CRC32CGenerator generator;
+    generator.update(data, size);
+    return generator.final();
+}
+
+void CRC32CGenerator::update(const void *data, std::size_t size) {
+    const auto bytes = static_cast<const unsigned char *>(data);
+    m_crc = hardwareSupported() ? updateHardware(m_crc, bytes, size)
+                                : updateSoftware(m_crc, bytes, size);
+}
+
+const std::string CRC32CGenerator::final(void) const {
+    std::stringstream output;
+    output << std::setfill('0') << std::hex << std::setw(8) << (m_crc ^ 0xFFFFFFFF);
+    return output.str();
+}
+
+} // namespace Cynara
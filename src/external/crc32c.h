@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/external/crc32c.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       CRC32C (Castagnoli) checksum, hardware accelerated where available
+ */
+#ifndef SRC_EXTERNAL_CRC32C_H_
+#define SRC_EXTERNAL_CRC32C_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Cynara {
+
+const std::string generateCRC32C(const std::string &data);
+const std::string generateCRC32C(const void *data, std::size_t size);
+
+// Computes CRC32C of data passed in consecutive parts
+class CRC32CGenerator {
+public:
+    CRC32CGenerator() : m_crc(0xFFFFFFFF) {}
+
+    void update(const void *data, std::size_t size);
+    // Returns hex digest of all passed data
+    const std::string final(void) const;
+
+private:
+    std::uint32_t m_crc;
+};
+
+} // namespace Cynara
+
+#endif /* SRC_EXTERNAL_CRC32C_H_ */
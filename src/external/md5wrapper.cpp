@@ -31,11 +31,28 @@
 namespace Cynara {
 
 const std::string generateMD5(const std::string &data) {
-    MD5Context context;
+    return generateMD5(data.data(), data.size());
+}
+
+const std::string generateMD5(const void *data, std::size_t size) {
+    MD5Generator generator;
+    generator.update(data, size);
+    return generator.final();
+}
+
+MD5Generator::MD5Generator() : m_context(new MD5Context) {
+    MD5Init(m_context.get());
+}
+
+MD5Generator::~MD5Generator() {}
+
+void MD5Generator::update(const void *data, std::size_t size) {
+    MD5Update(m_context.get(), reinterpret_cast<const u_int8_t *>(data), size);
+}
+
+const std::string MD5Generator::final(void) {
     std::vector<u_int8_t> result(MD5_DIGEST_LENGTH);
-    MD5Init(&context);
-    MD5Update(&context, reinterpret_cast<const u_int8_t *>(data.data()), data.size());
-    MD5Final(result.data(), &context);
+    MD5Final(result.data(), m_context.get());
 
     std::stringstream output;
     output << std::setfill('0') << std::hex;
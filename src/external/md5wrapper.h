@@ -22,11 +22,33 @@
 #ifndef SRC_EXTERNAL_MD5WRAPPER_H_
 #define SRC_EXTERNAL_MD5WRAPPER_H_
 
+#include <cstddef>
+#include <memory>
 #include <string>
 
+struct MD5Context;
+
 namespace Cynara {
 
+// Computes MD5 of data passed in consecutive parts
+class MD5Generator {
+public:
+    MD5Generator();
+    ~MD5Generator();
+
+    MD5Generator(const MD5Generator &) = delete;
+    MD5Generator &operator=(const MD5Generator &) = delete;
+
+    void update(const void *data, std::size_t size);
+    // Returns hex digest of all passed data; generator must not be updated afterwards
+    const std::string final(void);
+
+private:
+    std::unique_ptr<MD5Context> m_context;
+};
+
 const std::string generateMD5(const std::string &data);
+const std::string generateMD5(const void *data, std::size_t size);
 
 } // namespace Cynara
 
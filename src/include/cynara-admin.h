@@ -139,6 +139,8 @@ int cynara_admin_finish(struct cynara_admin *p_cynara_admin);
  *
  * One call of cynara_admin_set_policies() can manage many different policies in different buckets.
  * However, considered buckets must exist before referring to them in policies.
+ * Bucket-pointing policies cannot link buckets into a cycle. If they would,
+ * CYNARA_API_OPERATION_NOT_ALLOWED is returned and no policy is changed.
  * \endparblock
  *
  * \par Sync (or) Async:
@@ -547,6 +547,87 @@ int cynara_async_create_simple_request(cynara_async *p_cynara, const char *clien
                                        const char *privilege, cynara_check_id *p_check_id,
                                        cynara_response_callback callback, void *user_response_data);
 
+/**
+ * \par Description:
+ * Creates one request to cynara service for simple access check of many privileges.
+ * Set callback and user_response_data to be called and passed when request processing is finished.
+ *
+ * \par Purpose:
+ * This API should be used to check at once, if a user running application identified as client
+ * has access to a number of privileges.
+ * Response can be received with cynara_async_process().
+ * Check id is returned to pair request with response for canceling purposes.
+ *
+ * \par Typical use case:
+ * A service, that has to resolve many privileges of the same client, wants to ask cynara service
+ * about all of them with one request and one response.
+ *
+ * \par Method of function operation:
+ * \parblock
+ * Every privilege is first looked up in cache, like with cynara_async_check_cache(), and result
+ * of privileges[i] found there is stored in results[i] at once. Remaining privileges are checked
+ * like with cynara_async_create_simple_request(), but all of them are sent to cynara service in
+ * one request and answered with one response. All results received are stored in cache.
+ *
+ * When response is received, result of check of privileges[i] is stored in results[i] and callback
+ * is called once for whole request with CYNARA_CALL_CAUSE_ANSWER and response value
+ * CYNARA_API_SUCCESS. Result is one of CYNARA_API_ACCESS_ALLOWED, CYNARA_API_ACCESS_DENIED or
+ * CYNARA_API_ACCESS_NOT_RESOLVED, if access cannot be resolved without usage of external agents.
+ * Only creating full request through cynara_async_create_request() API would yield eventual
+ * answer for such privileges.
+ *
+ * If all privileges are found in cache, nothing is sent to cynara service, but callback is still
+ * called the same way - during next call to cynara_async_process().
+ * \endparblock
+ *
+ * \par Sync (or) Async:
+ * This is an asynchronous API.
+ *
+ * \par Thread-safety:
+ * This function is NOT thread-safe. If functions from described API are called by multithreaded
+ * application from different threads, they must be put into mutex protected critical section.
+ *
+ * \par Important notes:
+ * \parblock
+ * Call cynara_async_create_batch_request() needs cynara_async structure to be created first
+ * with cynara_async_initialize().
+ * Call cynara_async_cancel_request() to cancel pending request.
+ * Call cynara_async_process() to send request and receive response.
+ *
+ * Array of results has to stay valid until callback is called. Only results found in cache are
+ * filled, when request is cancelled or finished without answer.
+ *
+ * String length cannot exceed CYNARA_MAX_ID_LENGTH and count cannot be 0 or exceed
+ * CYNARA_MAX_VECTOR_SIZE, otherwise CYNARA_API_INVALID_PARAM will be returned.
+ * \endparblock
+ *
+ * \param[in] p_cynara cynara_async structure.
+ * \param[in] client Application or process identifier.
+ * \param[in] client_session Client defined session.
+ * \param[in] user User of running client.
+ * \param[in] privileges Array of privileges, that are subjects of a check.
+ * \param[in] count Number of privileges.
+ * \param[out] results Array of count elements, filled with result of each check.
+ * \param[out] p_check_id Placeholder for check id. If NULL, then no check_id is returned.
+ * \param[in] callback Function called when matching response is received.
+ *            If NULL then no callback will be called when response, cancel, finish
+ *            or service not availble error happens.
+ * \param[in] user_response_data User specific data, passed to callback is being only stored by
+ *            library. Cynara library does not take any actions on this pointer, except for giving
+ *            it back to user in cynara_response_callback.
+ *            Can be NULL.
+ *
+ * \return CYNARA_API_SUCCESS on success
+ * \return CYNARA_API_MAX_PENDING_REQUESTS on too much pending requests
+ * \return other negative error code on error
+ */
+int cynara_async_create_batch_request(cynara_async *p_cynara, const char *client,
+                                      const char *client_session, const char *user,
+                                      const char *const *privileges, size_t count, int *results,
+                                      cynara_check_id *p_check_id,
+                                      cynara_response_callback callback,
+                                      void *user_response_data);
+
 /**
  * \par Description:
  * Process events that appeared on cynara socket.
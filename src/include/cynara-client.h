@@ -298,6 +298,63 @@ int cynara_check(cynara *p_cynara, const char *client, const char *client_sessio
 int cynara_simple_check(cynara *p_cynara, const char *client, const char *client_session,
                         const char *user, const char *privilege);
 
+/**
+ * \par Description:
+ * Check client, user access for each of given privileges.
+ *
+ * \par Purpose:
+ * This API should be used to check at once, if a user running application identified as client
+ * has access to a number of privileges.
+ *
+ * \par Typical use case:
+ * A service, that has to resolve many privileges of the same client (e.g. when application is
+ * launched), wants to ask Cynara about all of them without a round trip per privilege.
+ *
+ * \par Method of function operation:
+ * \parblock
+ * Every privilege is checked exactly like with cynara_check(). Answers found in cache are taken
+ * from there. All other privileges are sent to cynara service in one request and answered with
+ * one response, which results are stored in cache. Privileges, that cannot be resolved without
+ * an external application, are then checked one by one like with cynara_check().
+ *
+ * Result of check of privileges[i] is stored in results[i].
+ * \endparblock
+ *
+ * \par Sync (or) Async:
+ * This is a Synchronous API.
+ *
+ * \par Thread-safeness:
+ * This function is NOT thread-safe. If functions from described API are called by multithreaded
+ * application from different threads, they must be put into mutex protected critical section.
+ *
+ * \par Important notes:
+ * \parblock
+ * An external application may be launched to allow user interaction in granting or denying access.
+ *
+ * Call to cynara_check_batch() needs cynara structure to be created first with call to
+ * cynara_initialize().
+ *
+ * String length cannot exceed CYNARA_MAX_ID_LENGTH and count cannot be 0 or exceed
+ * CYNARA_MAX_VECTOR_SIZE, otherwise CYNARA_API_INVALID_PARAM will be returned.
+ *
+ * If function fails, content of results should be ignored.
+ * \endparblock
+ *
+ * \param[in] p_cynara Cynara structure.
+ * \param[in] client Application or process identifier.
+ * \param[in] client_session Session of client (connection, launch).
+ * \param[in] user User running client.
+ * \param[in] privileges Array of privileges, that are subjects of a check.
+ * \param[in] count Number of privileges.
+ * \param[out] results Array of count elements, filled with CYNARA_API_ACCESS_ALLOWED or
+ *             CYNARA_API_ACCESS_DENIED for each privilege.
+ *
+ * \return CYNARA_API_SUCCESS on success or negative error code on error.
+ */
+int cynara_check_batch(cynara *p_cynara, const char *client, const char *client_session,
+                       const char *user, const char *const *privileges, size_t count,
+                       int *results);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/service/logic/CheckCache.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file implements class caching results of storage checks in cynara service
+ */
+
+#include <types/PolicyKeyHelpers.h>
+
+#include "CheckCache.h"
+
+namespace Cynara {
+
+// Entries start with generation 0, which is never current, so empty slots never match
+CheckCache::CheckCache(std::size_t capacity)
+    : m_entries(capacity, Entry{ PolicyKey("", "", ""), PolicyResult(), 0 }), m_generation(1),
+      m_hits(0), m_misses(0) {}
+
+CheckCache::Entry *CheckCache::slot(const PolicyKey &key) {
+    if (m_entries.empty()) {
+        return nullptr;
+    }
+    return &m_entries[PolicyKeyHelpers::mapKey(key).hash() % m_entries.size()];
+}
+
+bool CheckCache::get(const PolicyKey &key, PolicyResult &result) {
+    auto entry = slot(key);
+    if (entry && entry->generation == m_generation && entry->key == key) {
+        ++m_hits;
+        result = entry->result;
+        return true;
+    }
+
+    ++m_misses;
+    return false;
+}
+
+void CheckCache::update(const PolicyKey &key, const PolicyResult &result) {
+    auto entry = slot(key);
+    if (!entry) {
+        return;
+    }
+
+    entry->key = key;
+    entry->result = result;
+    entry->generation = m_generation;
+}
+
+} // namespace Cynara
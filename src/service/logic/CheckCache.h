@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/service/logic/CheckCache.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file defines class caching results of storage checks in cynara service
+ */
+
+#ifndef SRC_SERVICE_LOGIC_CHECKCACHE_H_
+#define SRC_SERVICE_LOGIC_CHECKCACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <types/PolicyKey.h>
+#include <types/PolicyResult.h>
+
+namespace Cynara {
+
+/*
+ * Caches results of Storage::checkPolicy() for the default bucket. Results of plugin types are
+ * cached too, as plugins are asked for the final answer after the storage check anyway.
+ * Entries are stamped with a database generation, so invalidate() only bumps the generation.
+ * Cache is direct mapped: a key may be stored only in the slot chosen by its hash, replacing
+ * whatever was there before.
+ */
+class CheckCache {
+public:
+    static const std::size_t CACHE_DEFAULT_CAPACITY = 4096;
+
+    CheckCache(std::size_t capacity = CACHE_DEFAULT_CAPACITY);
+
+    bool get(const PolicyKey &key, PolicyResult &result);
+    void update(const PolicyKey &key, const PolicyResult &result);
+
+    void invalidate(void) {
+        ++m_generation;
+    }
+
+    std::size_t hits(void) const {
+        return m_hits;
+    }
+
+    std::size_t misses(void) const {
+        return m_misses;
+    }
+
+private:
+    typedef std::uint64_t Generation;
+
+    struct Entry {
+        PolicyKey key;
+        PolicyResult result;
+        Generation generation;
+    };
+
+    Entry *slot(const PolicyKey &key);
+
+    std::vector<Entry> m_entries;
+    Generation m_generation;
+    std::size_t m_hits;
+    std::size_t m_misses;
+};
+
+} // namespace Cynara
+
+#endif /* SRC_SERVICE_LOGIC_CHECKCACHE_H_ */
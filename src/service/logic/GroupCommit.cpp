@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/service/logic/GroupCommit.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file implements class gathering database changes to be saved together
+ */
+
+#include "GroupCommit.h"
+
+namespace Cynara {
+
+const unsigned int GroupCommit::DEFAULT_WINDOW_MS;
+const std::size_t GroupCommit::DEFAULT_MAX_OPERATIONS;
+
+void GroupCommit::add(const RequestContext &context, ProtocolFrameSequenceNumber sequenceNumber,
+                      Clock::time_point now) {
+    if (m_pending.empty()) {
+        m_deadline = now + m_window;
+    }
+    m_pending.push_back({ context, sequenceNumber });
+}
+
+bool GroupCommit::due(Clock::time_point now) const {
+    if (m_pending.empty()) {
+        return false;
+    }
+    return now >= m_deadline || (m_maxOperations > 0 && m_pending.size() >= m_maxOperations);
+}
+
+std::chrono::milliseconds GroupCommit::timeLeft(Clock::time_point now) const {
+    if (due(now)) {
+        return std::chrono::milliseconds(0);
+    }
+    // Rounded up, so the batch is due once the time passes
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               m_deadline - now + std::chrono::milliseconds(1) - Clock::duration(1));
+}
+
+GroupCommit::Acknowledgements GroupCommit::take(void) {
+    Acknowledgements acknowledgements;
+    acknowledgements.swap(m_pending);
+    return acknowledgements;
+}
+
+} // namespace Cynara
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/service/logic/GroupCommit.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file defines class gathering database changes to be saved together
+ */
+
+#ifndef SRC_SERVICE_LOGIC_GROUPCOMMIT_H_
+#define SRC_SERVICE_LOGIC_GROUPCOMMIT_H_
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include <request/RequestContext.h>
+#include <types/ProtocolFields.h>
+
+namespace Cynara {
+
+/*
+ * Holds acknowledgements of admin requests, which changes are applied in memory, but not saved
+ * yet. Batch is due when the window started by its first change elapses or when it reaches
+ * the operation limit; then the database is saved once and the whole batch is acknowledged.
+ * Group commit with empty window is disabled: every change is due as soon as it is added.
+ */
+class GroupCommit {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    static const unsigned int DEFAULT_WINDOW_MS = 20;
+    static const std::size_t DEFAULT_MAX_OPERATIONS = 256;
+
+    struct Acknowledgement {
+        RequestContext context;
+        ProtocolFrameSequenceNumber sequenceNumber;
+    };
+    typedef std::vector<Acknowledgement> Acknowledgements;
+
+    GroupCommit() : m_window(0), m_maxOperations(0) {}
+
+    void configure(std::chrono::milliseconds window, std::size_t maxOperations) {
+        m_window = window;
+        m_maxOperations = maxOperations;
+    }
+
+    bool enabled(void) const {
+        return m_window.count() > 0;
+    }
+
+    bool empty(void) const {
+        return m_pending.empty();
+    }
+
+    void add(const RequestContext &context, ProtocolFrameSequenceNumber sequenceNumber,
+             Clock::time_point now = Clock::now());
+
+    bool due(Clock::time_point now = Clock::now()) const;
+    // Time left until the batch is due; meaningful only if there are pending changes
+    std::chrono::milliseconds timeLeft(Clock::time_point now = Clock::now()) const;
+
+    Acknowledgements take(void);
+
+private:
+    std::chrono::milliseconds m_window;
+    std::size_t m_maxOperations;
+    Clock::time_point m_deadline;
+    Acknowledgements m_pending;
+};
+
+} // namespace Cynara
+
+#endif /* SRC_SERVICE_LOGIC_GROUPCOMMIT_H_ */
@@ -26,12 +26,14 @@
 #include <cinttypes>
 #include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include <attributes/attributes.h>
 #include <log/log.h>
 #include <common.h>
 #include <log/log.h>
+#include <exceptions/BucketLinkCycleException.h>
 #include <exceptions/BucketNotExistsException.h>
 #include <exceptions/DatabaseCorruptedException.h>
 #include <exceptions/DatabaseException.h>
@@ -46,6 +48,7 @@
 #include <request/AgentActionRequest.h>
 #include <request/AgentRegisterRequest.h>
 #include <request/CancelRequest.h>
+#include <request/CheckBatchRequest.h>
 #include <request/CheckRequest.h>
 #include <request/DescriptionListRequest.h>
 #include <request/EraseRequest.h>
@@ -63,6 +66,7 @@
 #include <response/AdminCheckResponse.h>
 #include <response/AgentRegisterResponse.h>
 #include <response/CancelResponse.h>
+#include <response/CheckBatchResponse.h>
 #include <response/CheckResponse.h>
 #include <response/CodeResponse.h>
 #include <response/DescriptionListResponse.h>
@@ -98,6 +102,10 @@ void Logic::execute(const RequestContext &context UNUSED, const SignalRequest &r
         LOGI("SIGTERM received!");
         m_socketManager->mainLoopStop();
         break;
+    case SIGUSR1:
+        LOGI("Check cache hits: [%zu], misses: [%zu]", m_checkCache.hits(),
+             m_checkCache.misses());
+        break;
     }
 }
 
@@ -194,7 +202,7 @@ bool Logic::check(const RequestContext &context, const PolicyKey &key,
         return false;
     }
 
-    result = (m_dbCorrupted ? PredefinedPolicyType::DENY : m_storage->checkPolicy(key));
+    result = (m_dbCorrupted ? PredefinedPolicyType::DENY : storageCheck(key));
 
     switch (result.policyType()) {
         case PredefinedPolicyType::ALLOW :
@@ -208,6 +216,15 @@ bool Logic::check(const RequestContext &context, const PolicyKey &key,
     return pluginCheck(context, key, checkId, result);
 }
 
+PolicyResult Logic::storageCheck(const PolicyKey &key) {
+    PolicyResult result;
+    if (!m_checkCache.get(key, result)) {
+        result = m_storage->checkPolicy(key);
+        m_checkCache.update(key, result);
+    }
+    return result;
+}
+
 bool Logic::pluginCheck(const RequestContext &context, const PolicyKey &key,
                         ProtocolFrameSequenceNumber checkId, PolicyResult &result) {
 
@@ -316,7 +333,7 @@ void Logic::execute(const RequestContext &context, const EraseRequest &request)
         }
     }
 
-    context.returnResponse(CodeResponse(code, request.sequenceNumber()));
+    acknowledgeChange(context, code, request.sequenceNumber());
 }
 
 void Logic::execute(const RequestContext &context, const InsertOrUpdateBucketRequest &request) {
@@ -340,7 +357,7 @@ void Logic::execute(const RequestContext &context, const InsertOrUpdateBucketReq
         }
     }
 
-    context.returnResponse(CodeResponse(code, request.sequenceNumber()));
+    acknowledgeChange(context, code, request.sequenceNumber());
 }
 
 void Logic::execute(const RequestContext &context, const ListRequest &request) {
@@ -378,7 +395,7 @@ void Logic::execute(const RequestContext &context, const RemoveBucketRequest &re
             code = CodeResponse::Code::NOT_ALLOWED;
         }
     }
-    context.returnResponse(CodeResponse(code, request.sequenceNumber()));
+    acknowledgeChange(context, code, request.sequenceNumber());
 }
 
 void Logic::execute(const RequestContext &context, const SetPoliciesRequest &request) {
@@ -389,26 +406,51 @@ void Logic::execute(const RequestContext &context, const SetPoliciesRequest &req
     } else {
         try {
             checkPoliciesTypes(request.policiesToBeInsertedOrUpdated(), true, false);
-            m_storage->insertPolicies(request.policiesToBeInsertedOrUpdated());
-            m_storage->deletePolicies(request.policiesToBeRemoved());
+            m_storage->setPolicies(request.policiesToBeInsertedOrUpdated(),
+                                   request.policiesToBeRemoved());
             onPoliciesChanged();
         } catch (const DatabaseException &ex) {
             code = CodeResponse::Code::FAILED;
         } catch (const BucketNotExistsException &ex) {
             code = CodeResponse::Code::NO_BUCKET;
+        } catch (const BucketLinkCycleException &ex) {
+            code = CodeResponse::Code::NOT_ALLOWED;
         } catch (const UnknownPolicyTypeException &ex) {
             code = CodeResponse::Code::NO_POLICY_TYPE;
         }
     }
 
-    context.returnResponse(CodeResponse(code, request.sequenceNumber()));
+    acknowledgeChange(context, code, request.sequenceNumber());
+}
+
+void Logic::execute(const RequestContext &context, const CheckBatchRequest &request) {
+    const auto &keys = request.keys();
+    std::vector<int32_t> retValues;
+    std::vector<PolicyResult> results;
+    retValues.reserve(keys.size());
+    results.reserve(keys.size());
+
+    for (const auto &key : keys) {
+        PolicyResult result;
+        retValues.push_back(simpleCheck(key, result));
+        m_auditLog.log(key, result);
+        results.push_back(std::move(result));
+    }
+
+    context.returnResponse(CheckBatchResponse(retValues, results, request.sequenceNumber()));
 }
 
 void Logic::execute(const RequestContext &context, const SimpleCheckRequest &request) {
-    int retValue = CYNARA_API_SUCCESS;
     PolicyResult result;
-    PolicyKey key = request.key();
-    result = m_storage->checkPolicy(key);
+    int retValue = simpleCheck(request.key(), result);
+    m_auditLog.log(request.key(), result);
+    context.returnResponse(SimpleCheckResponse(retValue, result,
+                                               request.sequenceNumber()));
+}
+
+int Logic::simpleCheck(const PolicyKey &key, PolicyResult &result) {
+    int retValue = CYNARA_API_SUCCESS;
+    result = storageCheck(key);
 
     switch (result.policyType()) {
     case PredefinedPolicyType::ALLOW:
@@ -422,7 +464,6 @@ void Logic::execute(const RequestContext &context, const SimpleCheckRequest &req
         if (!plugin) {
             LOGE("Plugin not found for policy: [0x%x]", result.policyType());
             result = PolicyResult(PredefinedPolicyType::DENY);
-            retValue = CYNARA_API_SUCCESS;
             break;
         }
 
@@ -431,7 +472,6 @@ void Logic::execute(const RequestContext &context, const SimpleCheckRequest &req
         if (!servicePlugin) {
             LOGE("Couldn't cast plugin pointer to ServicePluginInterface");
             result = PolicyResult(PredefinedPolicyType::DENY);
-            retValue = CYNARA_API_SUCCESS;
             break;
         }
 
@@ -454,9 +494,8 @@ void Logic::execute(const RequestContext &context, const SimpleCheckRequest &req
         }
     }
     }
-    m_auditLog.log(request.key(), result);
-    context.returnResponse(SimpleCheckResponse(retValue, result,
-                                               request.sequenceNumber()));
+
+    return retValue;
 }
 
 void Logic::sendMonitorResponses(void) {
@@ -529,12 +568,102 @@ void Logic::contextClosed(const RequestContext &context) {
 }
 
 void Logic::onPoliciesChanged(void) {
-    m_storage->save();
+    m_checkCache.invalidate();
     m_socketManager->disconnectAllClients();
     m_pluginManager->invalidateAll();
     //todo remove all saved contexts (if there will be any saved contexts)
 }
 
+void Logic::acknowledgeChange(const RequestContext &context, CodeResponse::Code code,
+                              ProtocolFrameSequenceNumber sequenceNumber) {
+    // Only applied changes wait for the save; errors are returned right away
+    if (code != CodeResponse::Code::OK) {
+        context.returnResponse(CodeResponse(code, sequenceNumber));
+        return;
+    }
+
+    // Without group commit, change is due at once and is saved as soon as persistence thread
+    // is free, in the same way as a batch
+    m_groupCommit.add(context, sequenceNumber);
+    savePendingChanges();
+}
+
+bool Logic::pendingChanges(std::chrono::milliseconds &timeLeft) const {
+    // Changes gathered during background save wait for its completion
+    if (m_groupCommit.empty() || m_persistenceThread.busy()) {
+        return false;
+    }
+    timeLeft = m_groupCommit.timeLeft();
+    return true;
+}
+
+void Logic::savePendingChanges(bool force) {
+    if (m_persistenceThread.busy()) {
+        if (!force) {
+            return;
+        }
+        completeSave();
+    }
+
+    if (m_groupCommit.empty() || !(force || m_groupCommit.due())) {
+        return;
+    }
+
+    m_savedChanges = m_groupCommit.take();
+
+    StorageBackend::SaveTask task;
+    try {
+        task = m_storage->prepareSave();
+    } catch (const DatabaseException &ex) {
+        LOGE("Saving database failed: <%s>", ex.what());
+        acknowledgeSave(CodeResponse::Code::FAILED);
+        return;
+    }
+
+    // Storage, which cannot save in background, has already saved
+    if (!task) {
+        acknowledgeSave(CodeResponse::Code::OK);
+        return;
+    }
+
+    m_persistenceThread.run(std::move(task));
+    if (force) {
+        completeSave();
+    }
+}
+
+void Logic::onSaveCompleted(void) {
+    if (!m_persistenceThread.busy() || !m_persistenceThread.done()) {
+        return;
+    }
+
+    completeSave();
+    // Changes gathered in the meantime may be due already
+    savePendingChanges();
+}
+
+void Logic::completeSave(void) {
+    bool succeeded = true;
+    try {
+        m_persistenceThread.finish();
+    } catch (const DatabaseException &ex) {
+        LOGE("Saving database failed: <%s>", ex.what());
+        succeeded = false;
+    }
+
+    m_storage->completeSave(succeeded);
+    acknowledgeSave(succeeded ? CodeResponse::Code::OK : CodeResponse::Code::FAILED);
+}
+
+void Logic::acknowledgeSave(CodeResponse::Code code) {
+    GroupCommit::Acknowledgements acknowledgements;
+    acknowledgements.swap(m_savedChanges);
+    for (const auto &acknowledgement : acknowledgements) {
+        acknowledgement.context.returnResponse(CodeResponse(code,
+                                                            acknowledgement.sequenceNumber));
+    }
+}
+
 void Logic::handleAgentTalkerDisconnection(const AgentTalkerPtr &agentTalkerPtr) {
     CheckContextPtr checkContextPtr = m_checkRequestManager.getContext(agentTalkerPtr);
     if (checkContextPtr == nullptr) {
@@ -562,6 +691,7 @@ void Logic::handleClientDisconnection(const CheckContextPtr &checkContextPtr) {
 }
 
 void Logic::loadDb(void) {
+    m_checkCache.invalidate();
     try {
         m_storage->load();
     } catch (const DatabaseCorruptedException &) {
@@ -25,6 +25,8 @@
 #ifndef SRC_SERVICE_LOGIC_LOGIC_H_
 #define SRC_SERVICE_LOGIC_LOGIC_H_
 
+#include <chrono>
+#include <cstddef>
 #include <map>
 #include <vector>
 
@@ -35,11 +37,15 @@
 #include <types/PolicyResult.h>
 #include <types/PolicyType.h>
 
+#include <logic/CheckCache.h>
+#include <logic/GroupCommit.h>
+#include <logic/PersistenceThread.h>
 #include <main/pointers.h>
 #include <plugin/PluginManager.h>
 #include <request/CheckRequestManager.h>
 #include <request/pointers.h>
 #include <request/RequestTaker.h>
+#include <response/CodeResponse.h>
 
 #include <cynara-plugin.h>
 
@@ -68,6 +74,11 @@ public:
         m_socketManager = socketManager;
     }
 
+    // Saves changes of admin requests together, acknowledging them when batch is saved
+    void setGroupCommit(std::chrono::milliseconds window, std::size_t maxOperations) {
+        m_groupCommit.configure(window, maxOperations);
+    }
+
     void unbindAll(void) {
         m_agentManager.reset();
         m_pluginManager.reset();
@@ -79,6 +90,7 @@ public:
     virtual void execute(const RequestContext &context, const AgentActionRequest &request);
     virtual void execute(const RequestContext &context, const AgentRegisterRequest &request);
     virtual void execute(const RequestContext &context, const CancelRequest &request);
+    virtual void execute(const RequestContext &context, const CheckBatchRequest &request);
     virtual void execute(const RequestContext &context, const CheckRequest &request);
     virtual void execute(const RequestContext &context, const DescriptionListRequest &request);
     virtual void execute(const RequestContext &context, const EraseRequest &request);
@@ -96,6 +108,17 @@ public:
     virtual void contextClosed(const RequestContext &context);
     virtual void loadDb(void);
 
+    // Time left until pending changes have to be saved; false if there are none
+    bool pendingChanges(std::chrono::milliseconds &timeLeft) const;
+    // Starts saving of pending changes, if due; forced save is done before return
+    void savePendingChanges(bool force = false);
+
+    // Readable when background save is done; then onSaveCompleted() should be called
+    int persistenceDescriptor(void) {
+        return m_persistenceThread.descriptor();
+    }
+    void onSaveCompleted(void);
+
 private:
     AgentManagerPtr m_agentManager;
     CheckRequestManager m_checkRequestManager;
@@ -104,8 +127,16 @@ private:
     SocketManagerPtr m_socketManager;
     AuditLog m_auditLog;
     MonitorLogic m_monitorLogic;
+    CheckCache m_checkCache;
+    GroupCommit m_groupCommit;
+    GroupCommit::Acknowledgements m_savedChanges;
+    PersistenceThread m_persistenceThread;
     bool m_dbCorrupted;
 
+    PolicyResult storageCheck(const PolicyKey &key);
+    // Resolves key without agents; CYNARA_API_ACCESS_NOT_RESOLVED if an agent is needed
+    int simpleCheck(const PolicyKey &key, PolicyResult &result);
+
     bool check(const RequestContext &context, const PolicyKey &key,
                ProtocolFrameSequenceNumber checkId, PolicyResult &result);
     bool pluginCheck(const RequestContext &context, const PolicyKey &key,
@@ -121,6 +152,10 @@ private:
     void handleClientDisconnection(const CheckContextPtr &checkContextPtr);
     void sendMonitorResponses(void);
     void onPoliciesChanged(void);
+    void acknowledgeChange(const RequestContext &context, CodeResponse::Code code,
+                           ProtocolFrameSequenceNumber sequenceNumber);
+    void acknowledgeSave(CodeResponse::Code code);
+    void completeSave(void);
 };
 
 } // namespace Cynara
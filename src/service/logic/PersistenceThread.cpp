@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/service/logic/PersistenceThread.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file implements thread saving database in background
+ */
+
+#include <utility>
+
+#include <exceptions/UnexpectedErrorException.h>
+
+#include "PersistenceThread.h"
+
+namespace Cynara {
+
+PersistenceThread::PersistenceThread() : m_busy(false), m_done(false), m_stopped(false) {
+    if (!m_notify.init()) {
+        throw UnexpectedErrorException("Couldn't initialize persistence notification");
+    }
+}
+
+PersistenceThread::~PersistenceThread() {
+    if (!m_thread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopped = true;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+}
+
+bool PersistenceThread::done(void) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_done;
+}
+
+void PersistenceThread::run(Task task) {
+    // Thread is started with the first task, so service saving nothing has none
+    if (!m_thread.joinable()) {
+        m_thread = std::thread(&PersistenceThread::work, this);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = std::move(task);
+        m_done = false;
+    }
+    m_busy = true;
+    m_condition.notify_all();
+}
+
+void PersistenceThread::finish(void) {
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] () { return m_done; });
+        m_done = false;
+        std::swap(error, m_error);
+    }
+    m_busy = false;
+    m_notify.snooze();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void PersistenceThread::work(void) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_condition.wait(lock, [this] () { return m_stopped || m_task; });
+        if (!m_task) {
+            return;
+        }
+
+        Task task;
+        task.swap(m_task);
+        lock.unlock();
+
+        std::exception_ptr error;
+        try {
+            task();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        // References held by task are dropped before main thread is told it is done
+        task = nullptr;
+
+        lock.lock();
+        m_error = error;
+        m_done = true;
+        m_condition.notify_all();
+        m_notify.notify();
+    }
+}
+
+} // namespace Cynara
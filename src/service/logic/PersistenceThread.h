@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/service/logic/PersistenceThread.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file defines thread saving database in background
+ */
+
+#ifndef SRC_SERVICE_LOGIC_PERSISTENCETHREAD_H_
+#define SRC_SERVICE_LOGIC_PERSISTENCETHREAD_H_
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <notify/FdNotifyObject.h>
+
+namespace Cynara {
+
+/*
+ * Runs database save tasks, one at a time, so writing and syncing files does not block
+ * the main loop. Completion of a task is signalled on descriptor, which main loop waits for
+ * together with sockets; then finish() gives result of the task.
+ * All methods are called from the main thread.
+ */
+class PersistenceThread {
+public:
+    typedef std::function<void(void)> Task;
+
+    PersistenceThread();
+    ~PersistenceThread();
+
+    PersistenceThread(const PersistenceThread &) = delete;
+    PersistenceThread &operator=(const PersistenceThread &) = delete;
+
+    int descriptor(void) {
+        return m_notify.getNotifyFd();
+    }
+
+    // Task is run and not finished yet
+    bool busy(void) const {
+        return m_busy;
+    }
+
+    bool done(void);
+    void run(Task task);
+    // Waits for the task to end and rethrows exception it ended with, if any
+    void finish(void);
+
+private:
+    void work(void);
+
+    FdNotifyObject m_notify;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    Task m_task;
+    std::exception_ptr m_error;
+    bool m_busy;
+    bool m_done;
+    bool m_stopped;
+};
+
+} // namespace Cynara
+
+#endif /* SRC_SERVICE_LOGIC_PERSISTENCETHREAD_H_ */
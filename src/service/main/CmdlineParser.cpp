@@ -27,6 +27,8 @@
 #include <pwd.h>
 #include <sstream>
 
+#include <service/logic/GroupCommit.h>
+
 #include "CmdlineParser.h"
 
 namespace Cynara {
@@ -46,7 +48,11 @@ struct CmdLineOptions handleCmdlineOptions(int argc, char * const *argv) {
               << CmdlineOpt::Daemon
               << CmdlineOpt::Mask << ":"
               << CmdlineOpt::User << ":"
-              << CmdlineOpt::Group << ":";
+              << CmdlineOpt::Group << ":"
+              << CmdlineOpt::Image
+              << CmdlineOpt::Compact << ":"
+              << CmdlineOpt::CommitWindow << ":"
+              << CmdlineOpt::CommitOperations << ":";
 
     const struct option longOpts[] = {
         { "help",       no_argument,          NULL, CmdlineOpt::Help },
@@ -55,6 +61,10 @@ struct CmdLineOptions handleCmdlineOptions(int argc, char * const *argv) {
         { "mask",       required_argument,    NULL, CmdlineOpt::Mask },
         { "user",       required_argument,    NULL, CmdlineOpt::User },
         { "group",      required_argument,    NULL, CmdlineOpt::Group },
+        { "image",      no_argument,          NULL, CmdlineOpt::Image },
+        { "compact",    required_argument,    NULL, CmdlineOpt::Compact },
+        { "commit-window",     required_argument,    NULL, CmdlineOpt::CommitWindow },
+        { "commit-operations", required_argument,    NULL, CmdlineOpt::CommitOperations },
         { NULL, 0, NULL, 0 }
     };
 
@@ -63,7 +73,11 @@ struct CmdLineOptions handleCmdlineOptions(int argc, char * const *argv) {
                                  .m_daemon = false,
                                  .m_mask = static_cast<mode_t>(-1),
                                  .m_uid = static_cast<uid_t>(-1),
-                                 .m_gid = static_cast<gid_t>(-1) };
+                                 .m_gid = static_cast<gid_t>(-1),
+                                 .m_image = false,
+                                 .m_compactDir = "",
+                                 .m_commitWindow = GroupCommit::DEFAULT_WINDOW_MS,
+                                 .m_commitOperations = GroupCommit::DEFAULT_MAX_OPERATIONS };
 
     optind = 0; // On entry to `getopt', zero means this is the first call; initialize.
     int opt;
@@ -109,6 +123,28 @@ struct CmdLineOptions handleCmdlineOptions(int argc, char * const *argv) {
                     return ret;
                 }
                 break;
+            case CmdlineOpt::Image:
+                ret.m_image = true;
+                break;
+            case CmdlineOpt::Compact:
+                ret.m_compactDir = optarg;
+                break;
+            case CmdlineOpt::CommitWindow:
+            case CmdlineOpt::CommitOperations: {
+                const long count = getCount(optarg);
+                if (count < 0) {
+                    printInvalidParam(execName, optarg);
+                    ret.m_error = true;
+                    ret.m_exit = true;
+                    return ret;
+                }
+                if (opt == CmdlineOpt::CommitWindow) {
+                    ret.m_commitWindow = static_cast<unsigned int>(count);
+                } else {
+                    ret.m_commitOperations = static_cast<std::size_t>(count);
+                }
+                break;
+            }
             case ':': // Missing argument
                 ret.m_error = true;
                 ret.m_exit = true;
@@ -116,6 +152,9 @@ struct CmdLineOptions handleCmdlineOptions(int argc, char * const *argv) {
                     case CmdlineOpt::Mask:
                     case CmdlineOpt::User:
                     case CmdlineOpt::Group:
+                    case CmdlineOpt::Compact:
+                    case CmdlineOpt::CommitWindow:
+                    case CmdlineOpt::CommitOperations:
                         printMissingArgument(execName, argv[optind - 1]);
                         return ret;
                 }
@@ -147,6 +186,18 @@ void printHelp(const std::string &execName) {
                  "[by default uid is not changed]" << std::endl;
     std::cout << "  -g, --group=GROUP            change group to GROUP "
                  "[by default gid is not changed]" << std::endl;
+    std::cout << "  -i, --image                  keep binary image of database for faster loading "
+                 "[by default no image is kept]" << std::endl;
+    std::cout << "  -w, --commit-window=MS       save admin changes in batches of MS milliseconds, "
+                 "0 disables batching [by default " << GroupCommit::DEFAULT_WINDOW_MS << "]"
+                 << std::endl;
+    std::cout << "  -o, --commit-operations=N    save admin batch once it has N changes, "
+                 "0 sets no limit [by default " << GroupCommit::DEFAULT_MAX_OPERATIONS << "]"
+                 << std::endl;
+    std::cout << "Maintenance mode options [program exits after database maintenance]:"
+                 << std::endl;
+    std::cout << "  -c, --compact=DIR            save journaled changes of database in DIR "
+                 "into its files [service must not be running]" << std::endl;
 }
 
 void printVersion(void) {
@@ -207,6 +258,21 @@ gid_t getGid(const char *group) {
     return ret;
 }
 
+long getCount(const char *count) {
+    long ret = -1;
+    if (!count)
+        return ret;
+    try {
+        std::size_t end = 0;
+        ret = std::stol(count, &end, 10);
+        if (count[end] != '\0' || ret < 0)
+            ret = -1;
+    } catch (...) {
+        ret = -1;
+    }
+    return ret;
+}
+
 } /* namespace CmdlineOpts */
 
 } /* namespace Cynara */
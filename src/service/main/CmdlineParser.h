@@ -23,6 +23,7 @@
 #ifndef SRC_SERVICE_MAIN_CMDLINEPARSER_H_
 #define SRC_SERVICE_MAIN_CMDLINEPARSER_H_
 
+#include <cstddef>
 #include <ostream>
 #include <string>
 #include <sys/types.h>
@@ -38,6 +39,10 @@ enum CmdlineOpt {
     Mask = 'm',
     User = 'u',
     Group = 'g',
+    Image = 'i',
+    Compact = 'c',
+    CommitWindow = 'w',
+    CommitOperations = 'o',
 };
 
 struct CmdLineOptions {
@@ -48,6 +53,11 @@ struct CmdLineOptions {
     mode_t m_mask;
     uid_t m_uid;
     gid_t m_gid;
+    bool m_image;
+    std::string m_compactDir;
+    // Group commit of admin changes; empty window saves every change at once
+    unsigned int m_commitWindow;
+    std::size_t m_commitOperations;
 };
 
 std::ostream &operator<<(std::ostream &os, CmdlineOpt opt);
@@ -61,6 +71,7 @@ void printMissingArgument(const std::string &execName, const std::string &option
 mode_t getMask(const char *mask);
 uid_t getUid(const char *user);
 gid_t getGid(const char *group);
+long getCount(const char *count);
 
 } /* namespace CmdlineOpts */
 
@@ -22,8 +22,10 @@
  * @brief       This file implements main class of cynara service
  */
 
+#include <chrono>
 #include <memory>
 #include <stddef.h>
+#include <string>
 
 #include <config/PathConfig.h>
 #include <log/log.h>
@@ -33,6 +35,7 @@
 #include <logic/Logic.h>
 #include <plugin/PluginManager.h>
 #include <sockets/SocketManager.h>
+#include <storage/ChecksumValidator.h>
 #include <storage/InMemoryStorageBackend.h>
 #include <storage/Storage.h>
 #include <storage/StorageBackend.h>
@@ -50,18 +53,21 @@ Cynara::~Cynara() {
     finalize();
 }
 
-void Cynara::init(void) {
+void Cynara::init(bool imageEnabled, unsigned int commitWindowMs,
+                  std::size_t commitOperations) {
     m_agentManager = std::make_shared<AgentManager>();
     m_logic = std::make_shared<Logic>();
     m_pluginManager = std::make_shared<PluginManager>(PathConfig::PluginPath::serviceDir);
     m_socketManager = std::make_shared<SocketManager>();
-    m_storageBackend = std::make_shared<InMemoryStorageBackend>(PathConfig::StoragePath::dbDir);
+    m_storageBackend = std::make_shared<InMemoryStorageBackend>(PathConfig::StoragePath::dbDir,
+            Journal::DEFAULT_SIZE_LIMIT, imageEnabled, ChecksumValidator::Algorithm::CRC32C);
     m_storage = std::make_shared<Storage>(*m_storageBackend);
 
     m_logic->bindAgentManager(m_agentManager);
     m_logic->bindPluginManager(m_pluginManager);
     m_logic->bindStorage(m_storage);
     m_logic->bindSocketManager(m_socketManager);
+    m_logic->setGroupCommit(std::chrono::milliseconds(commitWindowMs), commitOperations);
 
     m_socketManager->bindLogic(m_logic);
 
@@ -96,4 +102,15 @@ void Cynara::finalize(void) {
     m_storage.reset();
 }
 
+/*
+ * Journal is replayed only over the snapshot it was started with, so before database files are
+ * migrated, journaled changes are loaded and saved as a new snapshot, without journal.
+ */
+void Cynara::compactDatabase(const std::string &dbDir) {
+    InMemoryStorageBackend backend(dbDir.back() == '/' ? dbDir : dbDir + '/', 0, false,
+                                   ChecksumValidator::Algorithm::CRC32C);
+    backend.load();
+    backend.save();
+}
+
 } // namespace Cynara
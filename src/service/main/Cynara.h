@@ -24,6 +24,9 @@
 #ifndef SRC_SERVICE_MAIN_CYNARA_H_
 #define SRC_SERVICE_MAIN_CYNARA_H_
 
+#include <cstddef>
+#include <string>
+
 #include <lock/FileLock.h>
 
 #include <main/pointers.h>
@@ -35,10 +38,12 @@ public:
     Cynara();
     ~Cynara();
 
-    void init(void);
+    void init(bool imageEnabled, unsigned int commitWindowMs, std::size_t commitOperations);
     void run(void);
     void finalize(void);
 
+    static void compactDatabase(const std::string &dbDir);
+
 private:
     AgentManagerPtr m_agentManager;
     LogicPtr m_logic;
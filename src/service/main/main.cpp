@@ -106,9 +106,15 @@ int main(int argc, char **argv) {
 
         init_log();
 
+        if (!options.m_compactDir.empty()) {
+            Cynara::Cynara::compactDatabase(options.m_compactDir);
+            LOGI("Cynara database <%s> is compacted", options.m_compactDir.c_str());
+            return EXIT_SUCCESS;
+        }
+
         Cynara::Cynara cynara;
         LOGI("Cynara service is starting ...");
-        cynara.init();
+        cynara.init(options.m_image, options.m_commitWindow, options.m_commitOperations);
         LOGI("Cynara service is started");
 
 #ifdef BUILD_WITH_SYSTEMD_DAEMON
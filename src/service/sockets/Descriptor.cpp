@@ -20,11 +20,16 @@
  * @brief       This file implements descriptor class
  */
 
+#include <cstring>
+#include <utility>
+
 #include "Descriptor.h"
 
 namespace Cynara {
 
-Descriptor::Descriptor() : m_listen(false), m_used(false), m_client(false), m_protocol(nullptr) {
+Descriptor::Descriptor() : m_listen(false), m_used(false), m_client(false),
+                           m_writeWatched(false), m_writeQueued(false), m_sending(false),
+                           m_generation(0), m_protocol(nullptr) {
 }
 
 void Descriptor::checkQueues(void) {
@@ -39,9 +44,13 @@ BinaryQueuePtr Descriptor::writeQueue(void) {
     return m_writeQueue;
 }
 
+void Descriptor::setWriteListener(BinaryQueue::AppendListener listener) {
+    writeQueue()->setAppendListener(std::move(listener));
+}
+
 bool Descriptor::hasDataToWrite(void) const {
     if (m_writeQueue)
-        return !(m_writeQueue->empty() && m_writeBuffer.empty());
+        return !m_writeQueue->empty();
     return false;
 }
 
@@ -49,34 +58,37 @@ ResponseTakerPtr Descriptor::responseTaker(void) const {
     return std::static_pointer_cast<ResponseTaker>(m_protocol);
 }
 
-void Descriptor::pushReadBuffer(const RawBuffer &readbuffer) {
+void *Descriptor::prepareReadBuffer(std::size_t size) {
     checkQueues();
-    m_readQueue->appendCopy(readbuffer.data(), readbuffer.size());
+    return m_readQueue->appendReserve(size);
 }
 
-RequestPtr Descriptor::extractRequest(void) {
+void Descriptor::pushReadBuffer(std::size_t size) {
     checkQueues();
-    return m_protocol->extractRequestFromBuffer(m_readQueue);
+    m_readQueue->appendCommit(size);
 }
 
-RawBuffer &Descriptor::prepareWriteBuffer(void) {
-    checkQueues();
-    size_t queuedDataSize = m_writeQueue->size();
-    size_t bufferDataSize = m_writeBuffer.size();
-
-    m_writeBuffer.resize(queuedDataSize + bufferDataSize);
-    m_writeQueue->flattenConsume(m_writeBuffer.data() + bufferDataSize, queuedDataSize);
+void Descriptor::pushReadBuffer(const void *data, std::size_t size) {
+    memcpy(prepareReadBuffer(size), data, size);
+    pushReadBuffer(size);
+}
 
-    return m_writeBuffer;
+RequestPtr Descriptor::extractRequest(void) {
+    checkQueues();
+    return m_protocol->extractRequestFromBuffer(m_readQueue);
 }
 
 void Descriptor::clear(void) {
     m_listen = false;
     m_used = false;
     m_client = false;
+    m_writeWatched = false;
+    m_writeQueued = false;
+    m_sending = false;
+    if (m_writeQueue)
+        m_writeQueue->setAppendListener(nullptr);
     m_readQueue.reset();
     m_writeQueue.reset();
-    m_writeBuffer.clear();
     m_protocol.reset();
 }
 
@@ -23,6 +23,8 @@
 #ifndef SRC_SERVICE_SOCKETS_DESCRIPTOR_H_
 #define SRC_SERVICE_SOCKETS_DESCRIPTOR_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 #include <common.h>
@@ -49,6 +51,27 @@ public:
         return m_client;
     }
 
+    // Descriptor is watched for being writable
+    bool isWriteWatched(void) const {
+        return m_writeWatched;
+    }
+
+    // Data was queued for writing since the last check of descriptor
+    bool isWriteQueued(void) const {
+        return m_writeQueued;
+    }
+
+    // Data from beginning of write queue is being sent asynchronously
+    bool isSending(void) const {
+        return m_sending;
+    }
+
+    // Changed whenever descriptor is reused, so results of earlier asynchronous operations
+    // can be told apart
+    std::uint32_t generation(void) const {
+        return m_generation;
+    }
+
     bool hasDataToWrite(void) const;
 
     const ProtocolPtr protocol(void) const {
@@ -75,10 +98,30 @@ public:
         m_client = client;
     }
 
-    void pushReadBuffer(const RawBuffer &readbuffer);
-    RequestPtr extractRequest(void);
+    void setWriteWatched(bool watched) {
+        m_writeWatched = watched;
+    }
+
+    void setWriteQueued(bool queued) {
+        m_writeQueued = queued;
+    }
+
+    void setSending(bool sending) {
+        m_sending = sending;
+    }
 
-    RawBuffer &prepareWriteBuffer(void);
+    void nextGeneration(void) {
+        ++m_generation;
+    }
+
+    void setWriteListener(BinaryQueue::AppendListener listener);
+
+    // Memory for at least size bytes, which are read straight into read queue storage and
+    // appended to read queue with pushReadBuffer(size)
+    void *prepareReadBuffer(std::size_t size);
+    void pushReadBuffer(std::size_t size);
+    void pushReadBuffer(const void *data, std::size_t size);
+    RequestPtr extractRequest(void);
 
     void clear(void);
 
@@ -86,10 +129,13 @@ private:
     bool m_listen;
     bool m_used;
     bool m_client;
+    bool m_writeWatched;
+    bool m_writeQueued;
+    bool m_sending;
+    std::uint32_t m_generation;
 
     BinaryQueuePtr m_readQueue;
     BinaryQueuePtr m_writeQueue;
-    RawBuffer m_writeBuffer;
 
     ProtocolPtr m_protocol;
 
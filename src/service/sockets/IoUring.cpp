@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/service/sockets/IoUring.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file implements io_uring instance used by socket layer
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <errno.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <exceptions/UnexpectedErrorException.h>
+#include <log/log.h>
+
+#include "IoUring.h"
+
+namespace Cynara {
+
+namespace {
+
+UnexpectedErrorException systemError(const char *what) {
+    int err = errno;
+    LOGE("%s failed: <%s>", what, strerror(err));
+    return UnexpectedErrorException(err, strerror(err));
+}
+
+} // namespace anonymous
+
+const std::uint16_t IoUring::BUFFER_GROUP;
+const int IoUring::PROBE_TIMEOUT_MS;
+
+IoUring::IoUring(unsigned entries, unsigned completionEntries, unsigned bufferCount,
+                 unsigned bufferSize)
+    : m_fd(-1), m_ringMemory(MAP_FAILED), m_ringSize(0), m_sqes(nullptr), m_sqesSize(0),
+      m_sqLocalTail(0), m_toSubmit(0), m_bufferRing(nullptr), m_bufferRingSize(0),
+      m_bufferCount(bufferCount), m_bufferSize(bufferSize) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_CLAMP;
+    params.cq_entries = completionEntries;
+
+    m_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (m_fd < 0) {
+        throw systemError("io_uring_setup");
+    }
+
+    // Completions are never dropped and waiting takes timeout as an argument
+    const unsigned neededFeatures = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP |
+                                    IORING_FEAT_EXT_ARG;
+    if ((params.features & neededFeatures) != neededFeatures) {
+        close(m_fd);
+        LOGE("io_uring features [%x] are not sufficient", params.features);
+        throw UnexpectedErrorException(EOPNOTSUPP, strerror(EOPNOTSUPP));
+    }
+
+    try {
+        m_ringSize = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                              params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+        m_ringMemory = mmap(nullptr, m_ringSize, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+        if (m_ringMemory == MAP_FAILED) {
+            throw systemError("mmap of io_uring rings");
+        }
+
+        m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void *sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            throw systemError("mmap of io_uring submission entries");
+        }
+        m_sqes = static_cast<io_uring_sqe *>(sqes);
+
+        char *ring = static_cast<char *>(m_ringMemory);
+        m_sqHead = reinterpret_cast<unsigned *>(ring + params.sq_off.head);
+        m_sqTail = reinterpret_cast<unsigned *>(ring + params.sq_off.tail);
+        m_sqArray = reinterpret_cast<unsigned *>(ring + params.sq_off.array);
+        m_sqMask = *reinterpret_cast<unsigned *>(ring + params.sq_off.ring_mask);
+        m_sqEntries = params.sq_entries;
+        m_sqLocalTail = *m_sqTail;
+
+        m_cqHead = reinterpret_cast<unsigned *>(ring + params.cq_off.head);
+        m_cqTail = reinterpret_cast<unsigned *>(ring + params.cq_off.tail);
+        m_cqes = reinterpret_cast<io_uring_cqe *>(ring + params.cq_off.cqes);
+        m_cqMask = *reinterpret_cast<unsigned *>(ring + params.cq_off.ring_mask);
+
+        registerBuffers();
+        probeRecv();
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+IoUring::~IoUring() {
+    release();
+}
+
+void IoUring::release(void) {
+    if (m_fd != -1) {
+        // Closing ring cancels all its requests, so buffers can be freed afterwards
+        close(m_fd);
+        m_fd = -1;
+    }
+    if (m_bufferRing != nullptr) {
+        munmap(m_bufferRing, m_bufferRingSize);
+        m_bufferRing = nullptr;
+    }
+    if (m_sqes != nullptr) {
+        munmap(m_sqes, m_sqesSize);
+        m_sqes = nullptr;
+    }
+    if (m_ringMemory != MAP_FAILED) {
+        munmap(m_ringMemory, m_ringSize);
+        m_ringMemory = MAP_FAILED;
+    }
+}
+
+void IoUring::registerBuffers(void) {
+    m_buffers.resize(static_cast<std::size_t>(m_bufferCount) * m_bufferSize);
+
+    m_bufferRingSize = m_bufferCount * sizeof(io_uring_buf);
+    void *bufferRing = mmap(nullptr, m_bufferRingSize, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (bufferRing == MAP_FAILED) {
+        throw systemError("mmap of buffer ring");
+    }
+    m_bufferRing = static_cast<io_uring_buf_ring *>(bufferRing);
+
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<std::uint64_t>(m_bufferRing);
+    reg.ring_entries = m_bufferCount;
+    reg.bgid = BUFFER_GROUP;
+    if (syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        throw systemError("io_uring_register of buffer ring");
+    }
+
+    for (unsigned id = 0; id < m_bufferCount; ++id) {
+        provideBuffer(id);
+    }
+}
+
+void IoUring::provideBuffer(unsigned id) {
+    std::uint16_t tail = __atomic_load_n(&m_bufferRing->tail, __ATOMIC_RELAXED);
+    // Entries start at the beginning of the ring (tail overlays the first one), but flexible
+    // array member of io_uring_buf_ring is misplaced, when the header is compiled as C++
+    auto &buf = reinterpret_cast<io_uring_buf *>(m_bufferRing)[tail & (m_bufferCount - 1)];
+    buf.addr = reinterpret_cast<std::uint64_t>(m_buffers.data() +
+                                               static_cast<std::size_t>(id) * m_bufferSize);
+    buf.len = m_bufferSize;
+    buf.bid = static_cast<std::uint16_t>(id);
+    __atomic_store_n(&m_bufferRing->tail, static_cast<std::uint16_t>(tail + 1),
+                     __ATOMIC_RELEASE);
+}
+
+/*
+ * Multishot receive came with later kernels than provided buffer rings, so it is checked on
+ * a socket pair before the ring is used.
+ */
+void IoUring::probeRecv(void) {
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, fds) == -1) {
+        throw systemError("socketpair");
+    }
+
+    const char probe = 0;
+    prepRecv(fds[0], 0);
+    submit();
+    bool received = write(fds[1], &probe, sizeof(probe)) == sizeof(probe);
+    if (received) {
+        submitAndWait(PROBE_TIMEOUT_MS);
+    }
+
+    Completion completion;
+    received = received && nextCompletion(completion) && completion.result == sizeof(probe);
+    if (received && hasBuffer(completion)) {
+        recycleBuffer(completion);
+    }
+
+    prepCancel(fds[0], 0);
+    submit();
+    close(fds[0]);
+    close(fds[1]);
+    while (nextCompletion(completion)) {
+        if (completion.result > 0 && hasBuffer(completion)) {
+            recycleBuffer(completion);
+        }
+    }
+
+    if (!received) {
+        LOGE("io_uring multishot receive is not supported");
+        throw UnexpectedErrorException(EOPNOTSUPP, strerror(EOPNOTSUPP));
+    }
+}
+
+bool IoUring::hasBuffer(const Completion &completion) {
+    return completion.flags & IORING_CQE_F_BUFFER;
+}
+
+const char *IoUring::buffer(const Completion &completion) const {
+    unsigned id = completion.flags >> IORING_CQE_BUFFER_SHIFT;
+    return m_buffers.data() + static_cast<std::size_t>(id) * m_bufferSize;
+}
+
+void IoUring::recycleBuffer(const Completion &completion) {
+    provideBuffer(completion.flags >> IORING_CQE_BUFFER_SHIFT);
+}
+
+struct io_uring_sqe *IoUring::nextSqe(void) {
+    // Full submission ring is passed to kernel, as it has room for new requests afterwards
+    if (m_sqLocalTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) >= m_sqEntries) {
+        submit();
+    }
+
+    unsigned index = m_sqLocalTail & m_sqMask;
+    struct io_uring_sqe *sqe = &m_sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    m_sqArray[index] = index;
+    ++m_sqLocalTail;
+    ++m_toSubmit;
+    return sqe;
+}
+
+void IoUring::prepAccept(int fd, std::uint64_t userData) {
+    auto sqe = nextSqe();
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = fd;
+    sqe->accept_flags = SOCK_NONBLOCK;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->user_data = userData;
+}
+
+void IoUring::prepRecv(int fd, std::uint64_t userData) {
+    auto sqe = nextSqe();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BUFFER_GROUP;
+    sqe->user_data = userData;
+}
+
+void IoUring::prepPoll(int fd, std::uint64_t userData) {
+    auto sqe = nextSqe();
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = POLLIN;
+    sqe->len = IORING_POLL_ADD_MULTI;
+    sqe->user_data = userData;
+}
+
+void IoUring::prepSendMessage(int fd, const struct msghdr *message, std::uint64_t userData) {
+    auto sqe = nextSqe();
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<std::uint64_t>(message);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = userData;
+}
+
+void IoUring::prepCancel(int fd, std::uint64_t userData) {
+    auto sqe = nextSqe();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = fd;
+    sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+    sqe->user_data = userData;
+}
+
+int IoUring::enter(unsigned waitFor, struct io_uring_getevents_arg *arg) {
+    __atomic_store_n(m_sqTail, m_sqLocalTail, __ATOMIC_RELEASE);
+
+    unsigned flags = 0;
+    if (arg != nullptr) {
+        flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+    }
+
+    int ret = static_cast<int>(syscall(__NR_io_uring_enter, m_fd, m_toSubmit, waitFor, flags,
+                                       arg, arg != nullptr ? sizeof(*arg) : 0));
+    if (ret > 0) {
+        m_toSubmit -= std::min(m_toSubmit, static_cast<unsigned>(ret));
+    }
+    return ret;
+}
+
+void IoUring::submit(void) {
+    if (enter(0, nullptr) < 0 && errno != EINTR && errno != EBUSY) {
+        throw systemError("io_uring_enter");
+    }
+}
+
+void IoUring::submitAndWait(int timeoutMs) {
+    struct __kernel_timespec timeout;
+    struct io_uring_getevents_arg arg;
+    memset(&arg, 0, sizeof(arg));
+    if (timeoutMs >= 0) {
+        timeout.tv_sec = timeoutMs / 1000;
+        timeout.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000;
+        arg.ts = reinterpret_cast<std::uint64_t>(&timeout);
+    }
+
+    if (enter(1, &arg) < 0) {
+        switch (errno) {
+        case EINTR:
+        case ETIME:
+        // Completions are taken first, when too many of them wait
+        case EBUSY:
+            break;
+        default:
+            throw systemError("io_uring_enter");
+        }
+    }
+}
+
+bool IoUring::nextCompletion(Completion &completion) {
+    unsigned head = *m_cqHead;
+    if (head == __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    const auto &cqe = m_cqes[head & m_cqMask];
+    completion.userData = cqe.user_data;
+    completion.result = cqe.res;
+    completion.flags = cqe.flags;
+    __atomic_store_n(m_cqHead, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+} // namespace Cynara
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/service/sockets/IoUring.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file defines io_uring instance used by socket layer
+ */
+
+#ifndef SRC_SERVICE_SOCKETS_IOURING_H_
+#define SRC_SERVICE_SOCKETS_IOURING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+#include <vector>
+
+namespace Cynara {
+
+/*
+ * Submission and completion rings of io_uring, used directly through system calls.
+ * Requests prepared with prep*() are submitted in one batch, when waiting for completions.
+ * Receiving uses buffers provided to kernel as one registered buffer group, so multishot
+ * receive requests of all connections share the same buffers.
+ * Constructor throws UnexpectedErrorException, when kernel does not support needed features.
+ */
+class IoUring {
+public:
+    struct Completion {
+        std::uint64_t userData;
+        std::int32_t result;
+        std::uint32_t flags;
+    };
+
+    IoUring(unsigned entries, unsigned completionEntries, unsigned bufferCount,
+            unsigned bufferSize);
+    ~IoUring();
+
+    IoUring(const IoUring &) = delete;
+    IoUring &operator=(const IoUring &) = delete;
+
+    void prepAccept(int fd, std::uint64_t userData);
+    void prepRecv(int fd, std::uint64_t userData);
+    void prepPoll(int fd, std::uint64_t userData);
+    // Message has to stay valid until send completes
+    void prepSendMessage(int fd, const struct msghdr *message, std::uint64_t userData);
+    void prepCancel(int fd, std::uint64_t userData);
+
+    // Submits prepared requests without waiting
+    void submit(void);
+    // Submits prepared requests and waits for completion; negative timeout waits forever
+    void submitAndWait(int timeoutMs);
+    bool nextCompletion(Completion &completion);
+
+    // Buffer filled by receive has to be given back to kernel, when its data is consumed
+    static bool hasBuffer(const Completion &completion);
+    const char *buffer(const Completion &completion) const;
+    void recycleBuffer(const Completion &completion);
+
+private:
+    static const std::uint16_t BUFFER_GROUP = 0;
+    static const int PROBE_TIMEOUT_MS = 1000;
+
+    void release(void);
+    struct io_uring_sqe *nextSqe(void);
+    int enter(unsigned waitFor, struct io_uring_getevents_arg *arg);
+    void registerBuffers(void);
+    void probeRecv(void);
+    void provideBuffer(unsigned id);
+
+    int m_fd;
+
+    void *m_ringMemory;
+    std::size_t m_ringSize;
+    struct io_uring_sqe *m_sqes;
+    std::size_t m_sqesSize;
+
+    unsigned *m_sqHead;
+    unsigned *m_sqTail;
+    unsigned *m_sqArray;
+    unsigned m_sqMask;
+    unsigned m_sqEntries;
+    unsigned m_sqLocalTail;
+    unsigned m_toSubmit;
+
+    unsigned *m_cqHead;
+    unsigned *m_cqTail;
+    struct io_uring_cqe *m_cqes;
+    unsigned m_cqMask;
+
+    struct io_uring_buf_ring *m_bufferRing;
+    std::size_t m_bufferRingSize;
+    unsigned m_bufferCount;
+    unsigned m_bufferSize;
+    std::vector<char> m_buffers;
+};
+
+} // namespace Cynara
+
+#endif /* SRC_SERVICE_SOCKETS_IOURING_H_ */
@@ -21,15 +21,19 @@
  * @brief       This file implements socket layer manager for cynara
  */
 
+#include <algorithm>
+#include <chrono>
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <memory>
 #include <signal.h>
-#include <sys/select.h>
+#include <sys/epoll.h>
 #include <sys/signalfd.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <unistd.h>
 
@@ -60,21 +64,54 @@
 
 namespace Cynara {
 
-SocketManager::SocketManager() : m_working(false), m_maxDesc(-1) {
-    FD_ZERO(&m_readSet);
-    FD_ZERO(&m_writeSet);
+namespace {
+
+// Events not taken in one call of epoll_wait() are reported by the next one
+const int MAX_EPOLL_EVENTS = 256;
+
+// Data queued in more buckets is written by following calls
+const size_t MAX_WRITE_IOVECS = IOV_MAX;
+
+#ifdef BUILD_WITH_IO_URING
+const unsigned RING_ENTRIES = 256;
+const unsigned RING_COMPLETION_ENTRIES = 4096;
+// Receive buffers are given back right after their data is handled, so few are needed
+const unsigned RING_BUFFER_COUNT = 256;
+#endif
+
+} // namespace anonymous
+
+SocketManager::SocketManager() : m_working(false), m_epollFd(-1), m_maxDesc(-1) {
 }
 
 SocketManager::~SocketManager() {
+    if (m_epollFd != -1)
+        close(m_epollFd);
 }
 
 void SocketManager::run(void) {
+#ifdef BUILD_WITH_IO_URING
+    initRing();
+#endif
     init();
+#ifdef BUILD_WITH_IO_URING
+    if (m_ring) {
+        ringLoop();
+        return;
+    }
+#endif
     mainLoop();
 }
 
 void SocketManager::init(void) {
     LOGI("SocketManger init start");
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epollFd == -1) {
+        UNUSED int err = errno;
+        LOGE("Error during epoll instance creation: <%s>", strerror(err));
+        throw InitException();
+    }
+
     const mode_t clientSocketUMask(0);
     const mode_t adminSocketUMask(0077);
     const mode_t agentSocketUMask(0);
@@ -92,14 +129,29 @@ void SocketManager::init(void) {
     LOGI("SocketManger init done");
 }
 
+/*
+ * Descriptors are watched for being writable only while they have data to write. Queues of
+ * descriptors report appended data (see writeQueued()), so only descriptors, which got new
+ * data, are checked after handling events.
+ */
 void SocketManager::mainLoop(void) {
     LOGI("SocketManger mainLoop start");
+
+    // Completion of background save is signalled on descriptor of its own
+    int persistenceFd = m_logic->persistenceDescriptor();
+    controlEpoll(EPOLL_CTL_ADD, persistenceFd, EPOLLIN);
+
+    std::vector<struct epoll_event> events(MAX_EPOLL_EVENTS);
     m_working  = true;
     while (m_working) {
-        fd_set readSet = m_readSet;
-        fd_set writeSet = m_writeSet;
+        // Wake up when pending database changes have to be saved
+        int timeout = -1;
+        std::chrono::milliseconds timeLeft;
+        if (m_logic->pendingChanges(timeLeft)) {
+            timeout = static_cast<int>(timeLeft.count());
+        }
 
-        int ret = select(m_maxDesc + 1, &readSet, &writeSet, nullptr, nullptr);
+        int ret = epoll_wait(m_epollFd, events.data(), MAX_EPOLL_EVENTS, timeout);
 
         if (ret < 0) {
             switch (errno) {
@@ -109,24 +161,23 @@ void SocketManager::mainLoop(void) {
                 int err = errno;
                 throw UnexpectedErrorException(err, strerror(err));
             }
-        } else if (ret > 0) {
-            for (int i = 0; i < m_maxDesc + 1 && ret; ++i) {
-                if (FD_ISSET(i, &readSet)) {
-                    readyForRead(i);
-                    --ret;
-                }
-                if (FD_ISSET(i, &writeSet)) {
-                    readyForWrite(i);
-                    --ret;
-                }
-            }
+        }
 
-            for (int i = 0; i < m_maxDesc + 1; ++i) {
-                if (m_fds[i].isUsed() && m_fds[i].hasDataToWrite())
-                    addWriteSocket(i);
+        for (int i = 0; i < ret; ++i) {
+            if (events[i].data.fd == persistenceFd) {
+                m_logic->onSaveCompleted();
+            } else {
+                handleEvent(events[i].data.fd, events[i].events);
             }
         }
+
+        // Acknowledgements of saved changes are queued for writing below
+        m_logic->savePendingChanges();
+
+        watchQueuedWrites();
     }
+    // Changes already applied must not be lost, even if they cannot be acknowledged anymore
+    m_logic->savePendingChanges(true);
     LOGI("SocketManger mainLoop done");
 }
 
@@ -134,6 +185,22 @@ void SocketManager::mainLoopStop(void) {
     m_working = false;
 }
 
+void SocketManager::handleEvent(int fd, std::uint32_t events) {
+    // Descriptor may be closed while handling previous events
+    if (!m_fds[fd].isUsed())
+        return;
+
+    // Errors and hang ups are found out by reading
+    if (events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+        readyForRead(fd);
+        if (!m_fds[fd].isUsed())
+            return;
+    }
+
+    if (events & EPOLLOUT)
+        readyForWrite(fd);
+}
+
 void SocketManager::readyForRead(int fd) {
     LOGD("SocketManger readyForRead on fd [%d] start", fd);
     auto &desc = m_fds[fd];
@@ -142,13 +209,13 @@ void SocketManager::readyForRead(int fd) {
         return;
     }
 
-    RawBuffer readBuffer(DEFAULT_BUFFER_SIZE);
-    ssize_t size = read(fd, readBuffer.data(), DEFAULT_BUFFER_SIZE);
+    void *readBuffer = desc.prepareReadBuffer(DEFAULT_BUFFER_SIZE);
+    ssize_t size = read(fd, readBuffer, DEFAULT_BUFFER_SIZE);
 
     if (size > 0) {
         LOGD("read [%zd] bytes", size);
-        readBuffer.resize(size);
-        if (handleRead(fd, readBuffer)) {
+        desc.pushReadBuffer(static_cast<size_t>(size));
+        if (handleRead(fd)) {
             LOGD("SocketManger readyForRead on fd [%d] successfully done", fd);
             return;
         }
@@ -175,16 +242,16 @@ void SocketManager::readyForRead(int fd) {
 
 void SocketManager::readyForWrite(int fd) {
     LOGD("SocketManger readyForWrite on fd [%d] start", fd);
-    auto &desc = m_fds[fd];
-    auto &buffer = desc.prepareWriteBuffer();
-    size_t size = buffer.size();
-    ssize_t result = write(fd, buffer.data(), size);
+    auto queue = m_fds[fd].writeQueue();
+    struct iovec iov[MAX_WRITE_IOVECS];
+    size_t count = queue->fillIovec(iov, MAX_WRITE_IOVECS);
+    ssize_t result = writev(fd, iov, static_cast<int>(count));
     if (result == -1) {
         int err = errno;
         switch (err) {
         case EAGAIN:
         case EINTR:
-            // select will trigger write once again, nothing to do
+            // epoll will trigger write once again, nothing to do
             break;
         case EPIPE:
         default:
@@ -196,9 +263,9 @@ void SocketManager::readyForWrite(int fd) {
     }
 
     LOGD("written [%zd] bytes", result);
-    buffer.erase(buffer.begin(), buffer.begin() + result);
+    queue->consume(static_cast<size_t>(result));
 
-    if (buffer.empty())
+    if (queue->empty())
         removeWriteSocket(fd);
     LOGD("SocketManger readyForWrite on fd [%d] done", fd);
 }
@@ -213,13 +280,28 @@ void SocketManager::readyForAccept(int fd) {
         LOGW("Error in accept on socket [%d]: <%s>", fd, strerror(err));
         return;
     }
-    LOGD("Accept on sock [%d]. New client socket opened [%d]", fd, clientFd);
+    acceptClient(fd, clientFd);
+    LOGD("SocketManger readyForAccept on fd [%d] done", fd);
+}
 
-    auto &desc = createDescriptor(clientFd, m_fds[fd].isClient());
+void SocketManager::acceptClient(int listenFd, int clientFd) {
+    LOGD("Accept on sock [%d]. New client socket opened [%d]", listenFd, clientFd);
+
+    auto &desc = createDescriptor(clientFd, m_fds[listenFd].isClient());
     desc.setListen(false);
-    desc.setProtocol(m_fds[fd].protocol()->clone());
-    addReadSocket(clientFd);
-    LOGD("SocketManger readyForAccept on fd [%d] done", fd);
+    desc.setProtocol(m_fds[listenFd].protocol()->clone());
+#ifdef BUILD_WITH_IO_URING
+    if (m_ring) {
+        m_ring->prepRecv(clientFd, ringUserData(RingOperation::RECV, clientFd));
+        return;
+    }
+#endif
+    try {
+        addReadSocket(clientFd);
+    } catch (const UnexpectedErrorException &) {
+        desc.clear();
+        close(clientFd);
+    }
 }
 
 void SocketManager::closeSocket(int fd) {
@@ -227,16 +309,14 @@ void SocketManager::closeSocket(int fd) {
     Descriptor &desc = m_fds[fd];
     requestTaker()->contextClosed(RequestContext(nullptr, desc.writeQueue(), fd));
     removeReadSocket(fd);
-    removeWriteSocket(fd);
     desc.clear();
     close(fd);
     LOGD("SocketManger closeSocket fd [%d] done", fd);
 }
 
-bool SocketManager::handleRead(int fd, const RawBuffer &readbuffer) {
+bool SocketManager::handleRead(int fd) {
     LOGD("SocketManger handleRead on fd [%d] start", fd);
     auto &desc = m_fds[fd];
-    desc.pushReadBuffer(readbuffer);
 
     try {
         while(true) {
@@ -359,6 +439,7 @@ void SocketManager::createSignalSocket(ProtocolPtr protocol) {
     // but for now I'm making it as simple as possible.
     sigemptyset(&mask);
     sigaddset(&mask, SIGTERM); // systemd terminates service sending this signal
+    sigaddset(&mask, SIGUSR1); // logs statistics of check cache
 
     if (sigprocmask(SIG_BLOCK, &mask, NULL) == -1) {
         LOGE("sigprocmask failed: <%s>", strerror(errno));
@@ -388,25 +469,289 @@ Descriptor &SocketManager::createDescriptor(int fd, bool client) {
     auto &desc = m_fds[fd];
     desc.setUsed(true);
     desc.setClient(client);
+    desc.nextGeneration();
+    desc.setWriteListener([this, fd] () {
+        writeQueued(fd);
+    });
     return desc;
 }
 
 void SocketManager::addReadSocket(int fd) {
-    FD_SET(fd, &m_readSet);
+#ifdef BUILD_WITH_IO_URING
+    if (m_ring) {
+        // Listening sockets accept connections, signal descriptor is polled
+        if (m_fds[fd].isListen())
+            m_ring->prepAccept(fd, ringUserData(RingOperation::ACCEPT, fd));
+        else
+            m_ring->prepPoll(fd, ringUserData(RingOperation::POLL, fd));
+        return;
+    }
+#endif
+    controlEpoll(EPOLL_CTL_ADD, fd, EPOLLIN);
 }
 
 void SocketManager::removeReadSocket(int fd) {
-    FD_CLR(fd, &m_readSet);
+#ifdef BUILD_WITH_IO_URING
+    if (m_ring) {
+        // Cancelling is submitted at once, as it finds requests by descriptor still open
+        m_ring->prepCancel(fd, ringUserData(RingOperation::CANCEL, fd));
+        m_ring->submit();
+        return;
+    }
+#endif
+    controlEpoll(EPOLL_CTL_DEL, fd, 0);
 }
 
 void SocketManager::addWriteSocket(int fd) {
-    FD_SET(fd, &m_writeSet);
+#ifdef BUILD_WITH_IO_URING
+    if (m_ring) {
+        ringSend(fd);
+        return;
+    }
+#endif
+    auto &desc = m_fds[fd];
+    if (!desc.isWriteWatched()) {
+        controlEpoll(EPOLL_CTL_MOD, fd, EPOLLIN | EPOLLOUT);
+        desc.setWriteWatched(true);
+    }
 }
 
 void SocketManager::removeWriteSocket(int fd) {
-    FD_CLR(fd, &m_writeSet);
+#ifdef BUILD_WITH_IO_URING
+    // Data is sent as soon as it is queued, nothing is watched
+    if (m_ring)
+        return;
+#endif
+    auto &desc = m_fds[fd];
+    if (desc.isWriteWatched()) {
+        controlEpoll(EPOLL_CTL_MOD, fd, EPOLLIN);
+        desc.setWriteWatched(false);
+    }
+}
+
+void SocketManager::writeQueued(int fd) {
+    auto &desc = m_fds[fd];
+    if (!desc.isWriteQueued()) {
+        desc.setWriteQueued(true);
+        m_writeQueuedFds.push_back(fd);
+    }
+}
+
+void SocketManager::watchQueuedWrites(void) {
+    for (int fd : m_writeQueuedFds) {
+        auto &desc = m_fds[fd];
+        desc.setWriteQueued(false);
+        if (desc.isUsed() && desc.hasDataToWrite())
+            addWriteSocket(fd);
+    }
+    m_writeQueuedFds.clear();
+}
+
+void SocketManager::controlEpoll(int operation, int fd, std::uint32_t events) {
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = events;
+    event.data.fd = fd;
+
+    if (epoll_ctl(m_epollFd, operation, fd, &event) == -1) {
+        int err = errno;
+        LOGE("Error in epoll_ctl [%d] on descriptor [%d]: <%s>", operation, fd, strerror(err));
+        throw UnexpectedErrorException(err, strerror(err));
+    }
+}
+
+#ifdef BUILD_WITH_IO_URING
+void SocketManager::initRing(void) {
+    try {
+        m_ring.reset(new IoUring(RING_ENTRIES, RING_COMPLETION_ENTRIES, RING_BUFFER_COUNT,
+                                 DEFAULT_BUFFER_SIZE));
+        LOGI("Sockets are served with io_uring");
+    } catch (const UnexpectedErrorException &ex) {
+        LOGW("io_uring cannot be used <%s>, falling back to epoll", ex.what());
+    }
+}
+
+/*
+ * Listening sockets and connections have multishot accept and receive requests, signal and
+ * persistence descriptors are polled. Requests prepared while handling completions
+ * (including sends of queued data) are submitted in one batch with waiting for next ones.
+ */
+void SocketManager::ringLoop(void) {
+    LOGI("SocketManger ringLoop start");
+
+    int persistenceFd = m_logic->persistenceDescriptor();
+    m_ring->prepPoll(persistenceFd, ringUserData(RingOperation::POLL, persistenceFd));
+
+    m_working  = true;
+    while (m_working) {
+        int timeout = -1;
+        std::chrono::milliseconds timeLeft;
+        if (m_logic->pendingChanges(timeLeft)) {
+            timeout = static_cast<int>(timeLeft.count());
+        }
+
+        m_ring->submitAndWait(timeout);
+
+        IoUring::Completion completion;
+        while (m_working && m_ring->nextCompletion(completion)) {
+            handleCompletion(completion, persistenceFd);
+        }
+
+        m_logic->savePendingChanges();
+
+        watchQueuedWrites();
+    }
+    m_logic->savePendingChanges(true);
+    LOGI("SocketManger ringLoop done");
+}
+
+void SocketManager::handleCompletion(const IoUring::Completion &completion,
+                                     int persistenceFd) {
+    auto operation = static_cast<RingOperation>(completion.userData >> 56);
+    int fd = static_cast<int>(completion.userData & 0xffffffff);
+    bool more = completion.flags & IORING_CQE_F_MORE;
+
+    if (operation == RingOperation::SEND) {
+        completeSend(fd, completion);
+        return;
+    }
+
+    if (operation == RingOperation::POLL && fd == persistenceFd) {
+        m_logic->onSaveCompleted();
+        if (!more)
+            m_ring->prepPoll(fd, completion.userData);
+        return;
+    }
+
+    // Requests of closed descriptors end with cancellation
+    if (operation == RingOperation::CANCEL || !isCurrent(fd, completion)) {
+        if (IoUring::hasBuffer(completion))
+            m_ring->recycleBuffer(completion);
+        return;
+    }
+
+    switch (operation) {
+    case RingOperation::ACCEPT:
+        if (completion.result >= 0) {
+            acceptClient(fd, completion.result);
+        } else {
+            LOGW("Error in accept on socket [%d]: <%s>", fd, strerror(-completion.result));
+        }
+        if (!more)
+            m_ring->prepAccept(fd, completion.userData);
+        break;
+    case RingOperation::RECV:
+        completeRecv(fd, completion);
+        break;
+    case RingOperation::POLL:
+        if (completion.result < 0) {
+            LOGE("Error in poll on descriptor [%d]: <%s>", fd, strerror(-completion.result));
+            break;
+        }
+        readyForRead(fd);
+        if (!more && isCurrent(fd, completion))
+            m_ring->prepPoll(fd, completion.userData);
+        break;
+    default:
+        break;
+    }
+}
+
+void SocketManager::completeRecv(int fd, const IoUring::Completion &completion) {
+    if (completion.result > 0 && IoUring::hasBuffer(completion)) {
+        LOGD("read [%d] bytes", completion.result);
+        m_fds[fd].pushReadBuffer(m_ring->buffer(completion),
+                                 static_cast<size_t>(completion.result));
+        m_ring->recycleBuffer(completion);
+        bool handled = handleRead(fd);
+        if (!handled) {
+            LOGI("interpreting buffer read from [%d] failed", fd);
+            closeSocket(fd);
+        } else if (!(completion.flags & IORING_CQE_F_MORE) && isCurrent(fd, completion)) {
+            m_ring->prepRecv(fd, completion.userData);
+        }
+        return;
+    }
+
+    if (completion.result == -ENOBUFS) {
+        // Buffers are given back while completions are handled, so receiving continues
+        m_ring->prepRecv(fd, completion.userData);
+        return;
+    }
+
+    if (completion.result == 0) {
+        LOGN("Socket [%d] closed on other end", fd);
+    } else {
+        LOGW("While reading from [%d] socket, error [%d]:<%s>",
+             fd, -completion.result, strerror(-completion.result));
+    }
+    closeSocket(fd);
 }
 
+void SocketManager::completeSend(int fd, const IoUring::Completion &completion) {
+    auto it = m_sends.find(completion.userData);
+    if (it == m_sends.end())
+        return;
+    BinaryQueuePtr queue(std::move(it->second.queue));
+    m_sends.erase(it);
+
+    if (!isCurrent(fd, completion))
+        return;
+
+    auto &desc = m_fds[fd];
+    desc.setSending(false);
+    if (completion.result < 0) {
+        LOGD("Error during write to fd [%d]:<%s> ", fd, strerror(-completion.result));
+        closeSocket(fd);
+        return;
+    }
+
+    LOGD("written [%d] bytes", completion.result);
+    queue->consume(static_cast<size_t>(completion.result));
+
+    if (!queue->empty())
+        ringSend(fd);
+}
+
+void SocketManager::ringSend(int fd) {
+    auto &desc = m_fds[fd];
+    // Completion of send in progress sends the rest
+    if (desc.isSending())
+        return;
+
+    auto queue = desc.writeQueue();
+    if (queue->empty())
+        return;
+
+    auto userData = ringUserData(RingOperation::SEND, fd);
+    auto &send = m_sends[userData];
+    send.queue = queue;
+    send.iov.resize(MAX_WRITE_IOVECS);
+    send.iov.resize(queue->fillIovec(send.iov.data(), send.iov.size()));
+    send.message = msghdr();
+    send.message.msg_iov = send.iov.data();
+    send.message.msg_iovlen = send.iov.size();
+    m_ring->prepSendMessage(fd, &send.message, userData);
+    desc.setSending(true);
+}
+
+bool SocketManager::isCurrent(int fd, const IoUring::Completion &completion) const {
+    return fd < static_cast<int>(m_fds.size()) && m_fds[fd].isUsed()
+           && (completion.userData & 0x00ffffff00000000) ==
+              (ringUserData(RingOperation::CANCEL, fd) & 0x00ffffff00000000);
+}
+
+// Operation, 24 bits of descriptor generation and descriptor number
+std::uint64_t SocketManager::ringUserData(RingOperation operation, int fd) const {
+    std::uint64_t generation = 0;
+    if (fd < static_cast<int>(m_fds.size()))
+        generation = m_fds[fd].generation() & 0x00ffffff;
+
+    return (static_cast<std::uint64_t>(operation) << 56) | (generation << 32)
+           | static_cast<std::uint32_t>(fd);
+}
+#endif
+
 RequestTakerPtr SocketManager::requestTaker(void) {
     return std::static_pointer_cast<RequestTaker>(m_logic);
 }
@@ -23,9 +23,15 @@
 #ifndef SRC_SERVICE_SOCKETS_SOCKETMANAGER_H_
 #define SRC_SERVICE_SOCKETS_SOCKETMANAGER_H_
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <stdio.h>
+#ifdef BUILD_WITH_IO_URING
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unordered_map>
+#endif
 
 #include <common.h>
 
@@ -33,6 +39,9 @@
 #include <protocol/Protocol.h>
 #include <request/RequestTaker.h>
 #include "Descriptor.h"
+#ifdef BUILD_WITH_IO_URING
+#include "IoUring.h"
+#endif
 
 namespace Cynara {
 
@@ -64,18 +73,21 @@ private:
 
     bool m_working;
 
-    fd_set m_readSet;
-    fd_set m_writeSet;
+    int m_epollFd;
     int m_maxDesc;
+    // Descriptors, which got data queued for writing since the last check
+    std::vector<int> m_writeQueuedFds;
 
     void init(void);
     void mainLoop(void);
 
+    void handleEvent(int fd, std::uint32_t events);
     void readyForRead(int fd);
     void readyForWrite(int fd);
     void readyForAccept(int fd);
+    void acceptClient(int listenFd, int clientFd);
     void closeSocket(int fd);
-    bool handleRead(int fd, const RawBuffer &readbuffer);
+    bool handleRead(int fd);
 
     void createDomainSocket(ProtocolPtr protocol, const std::string &path, mode_t mask,
                             bool client);
@@ -91,8 +103,42 @@ private:
     void removeReadSocket(int fd);
     void addWriteSocket(int fd);
     void removeWriteSocket(int fd);
+    void writeQueued(int fd);
+    void watchQueuedWrites(void);
+    void controlEpoll(int operation, int fd, std::uint32_t events);
 
     RequestTakerPtr requestTaker(void);
+
+#ifdef BUILD_WITH_IO_URING
+    enum class RingOperation : std::uint8_t {
+        ACCEPT = 1,
+        RECV,
+        POLL,
+        SEND,
+        CANCEL
+    };
+
+    // Queued data is sent straight from write queue, which is kept (with message describing
+    // its data) until send completes, even if its descriptor is closed meanwhile
+    struct RingSend {
+        BinaryQueuePtr queue;
+        std::vector<struct iovec> iov;
+        struct msghdr message;
+    };
+
+    // When set, sockets are served by io_uring instead of epoll
+    std::unique_ptr<IoUring> m_ring;
+    std::unordered_map<std::uint64_t, RingSend> m_sends;
+
+    void initRing(void);
+    void ringLoop(void);
+    void handleCompletion(const IoUring::Completion &completion, int persistenceFd);
+    void completeRecv(int fd, const IoUring::Completion &completion);
+    void completeSend(int fd, const IoUring::Completion &completion);
+    void ringSend(int fd);
+    bool isCurrent(int fd, const IoUring::Completion &completion) const;
+    std::uint64_t ringUserData(RingOperation operation, int fd) const;
+#endif
 };
 
 } // namespace Cynara
@@ -21,6 +21,8 @@
  */
 
 #include <array>
+#include <ios>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
@@ -59,6 +61,8 @@ PolicyCollection BucketDeserializer::loadPolicies(void) {
         }
         ++lineNum;
     }
+    // Rest of stream is consumed, so stream verifying its checksum sees whole contents
+    m_inStream->ignore(std::numeric_limits<std::streamsize>::max());
 
     return policies;
 }
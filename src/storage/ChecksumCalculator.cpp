@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/storage/ChecksumCalculator.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file contains ChecksumCalculator implementation.
+ */
+
+#include "ChecksumCalculator.h"
+
+namespace Cynara {
+
+void ChecksumCalculator::update(const void *data, std::size_t size) {
+    switch (m_algorithm) {
+    case ChecksumValidator::Algorithm::MD5:
+        m_md5.update(data, size);
+        break;
+    case ChecksumValidator::Algorithm::CRC32C:
+        m_crc32c.update(data, size);
+        break;
+    }
+}
+
+const std::string ChecksumCalculator::final(void) {
+    switch (m_algorithm) {
+    case ChecksumValidator::Algorithm::CRC32C:
+        return ChecksumValidator::crc32cTag + m_crc32c.final();
+    case ChecksumValidator::Algorithm::MD5:
+    default:
+        return m_md5.final();
+    }
+}
+
+} // namespace Cynara
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/storage/ChecksumCalculator.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file contains ChecksumCalculator header.
+ */
+
+#ifndef SRC_STORAGE_CHECKSUMCALCULATOR_H_
+#define SRC_STORAGE_CHECKSUMCALCULATOR_H_
+
+#include <cstddef>
+#include <string>
+
+#include <crc32c.h>
+#include <md5wrapper.h>
+
+#include <storage/ChecksumValidator.h>
+
+namespace Cynara {
+
+// Computes checksum of data passed in consecutive parts, tagged with its algorithm
+class ChecksumCalculator {
+public:
+    ChecksumCalculator(ChecksumValidator::Algorithm algorithm) : m_algorithm(algorithm) {}
+
+    void update(const void *data, std::size_t size);
+    // Returns checksum of all passed data; calculator must not be updated afterwards
+    const std::string final(void);
+
+private:
+    const ChecksumValidator::Algorithm m_algorithm;
+    MD5Generator m_md5;
+    CRC32CGenerator m_crc32c;
+};
+
+} // namespace Cynara
+
+#endif // SRC_STORAGE_CHECKSUMCALCULATOR_H_
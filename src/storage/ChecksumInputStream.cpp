@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/storage/ChecksumInputStream.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file contains ChecksumInputStream implementation.
+ */
+
+#include <ios>
+
+#include <exceptions/ChecksumRecordCorruptedException.h>
+#include <log/log.h>
+
+#include "ChecksumInputStream.h"
+
+namespace Cynara {
+
+ChecksumInputStream::ChecksumInputStream(const std::string &filename,
+                                         const std::string &checksum)
+    : std::istream(nullptr), m_buffer(filename, checksum) {
+    rdbuf(&m_buffer);
+    // Exception thrown by buffer is rethrown instead of only setting badbit
+    exceptions(std::ios_base::badbit);
+}
+
+ChecksumInputStream::Buffer::Buffer(const std::string &filename, const std::string &checksum)
+    : m_data(BUFFER_SIZE), m_calculator(ChecksumValidator::algorithm(checksum)),
+      m_checksum(checksum), m_verified(false) {
+    m_file.open(filename, std::ios_base::in | std::ios_base::binary);
+}
+
+ChecksumInputStream::Buffer::int_type ChecksumInputStream::Buffer::underflow(void) {
+    if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+    }
+
+    std::streamsize size = m_file.is_open() ? m_file.sgetn(m_data.data(), m_data.size()) : 0;
+    if (size > 0) {
+        m_calculator.update(m_data.data(), static_cast<std::size_t>(size));
+        setg(m_data.data(), m_data.data(), m_data.data() + size);
+        return traits_type::to_int_type(*gptr());
+    }
+
+    if (!m_verified) {
+        m_verified = true;
+        m_file.close();
+        if (m_calculator.final() != m_checksum) {
+            LOGE("Checksum mismatch, expected: <%s>", m_checksum.c_str());
+            throw ChecksumRecordCorruptedException(m_checksum);
+        }
+    }
+    return traits_type::eof();
+}
+
+} // namespace Cynara
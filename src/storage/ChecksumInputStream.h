@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/storage/ChecksumInputStream.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       This file contains ChecksumInputStream header.
+ */
+
+#ifndef SRC_STORAGE_CHECKSUMINPUTSTREAM_H_
+#define SRC_STORAGE_CHECKSUMINPUTSTREAM_H_
+
+#include <cstddef>
+#include <fstream>
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <storage/ChecksumCalculator.h>
+
+namespace Cynara {
+
+/*
+ * Input file stream computing checksum of the bytes as they are read, so database file
+ * is read only once. Algorithm is the one the expected checksum was made with. When end of file
+ * is reached and checksum does not match the expected one, ChecksumRecordCorruptedException
+ * is thrown out of the reading operation.
+ */
+class ChecksumInputStream : public std::istream {
+public:
+    ChecksumInputStream(const std::string &filename, const std::string &checksum);
+    virtual ~ChecksumInputStream() {}
+
+    bool is_open(void) const {
+        return m_buffer.is_open();
+    }
+
+private:
+    class Buffer : public std::streambuf {
+    public:
+        Buffer(const std::string &filename, const std::string &checksum);
+
+        bool is_open(void) const {
+            return m_file.is_open();
+        }
+
+    protected:
+        virtual int_type underflow(void);
+
+    private:
+        static const std::size_t BUFFER_SIZE = 64 * 1024;
+
+        std::filebuf m_file;
+        std::vector<char> m_data;
+        ChecksumCalculator m_calculator;
+        const std::string m_checksum;
+        bool m_verified;
+    };
+
+    Buffer m_buffer;
+};
+
+} // namespace Cynara
+
+#endif // SRC_STORAGE_CHECKSUMINPUTSTREAM_H_
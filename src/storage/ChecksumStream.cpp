@@ -64,7 +64,8 @@ std::ios_base::fmtflags ChecksumStream::flags(std::ios_base::fmtflags flags) {
 
 void ChecksumStream::save() {
     m_outStream.close();
-    *m_chsStream << m_filename << m_fieldSeparator << ChecksumValidator::generate(m_bufStream.str())
+    *m_chsStream << m_filename << m_fieldSeparator << ChecksumValidator::generate(m_bufStream.str(),
+                                                                            m_algorithm)
                  << m_recordSeparator;
 }
 
@@ -29,12 +29,15 @@
 #include <sstream>
 #include <string>
 
+#include <storage/ChecksumValidator.h>
+
 namespace Cynara {
 
 class ChecksumStream {
 public:
-    ChecksumStream(const std::string &filename, const std::shared_ptr<std::ofstream> &stream)
-    : m_chsStream(stream), m_filename(filename) {
+    ChecksumStream(const std::string &filename, const std::shared_ptr<std::ofstream> &stream,
+                   ChecksumValidator::Algorithm algorithm = ChecksumValidator::Algorithm::MD5)
+    : m_chsStream(stream), m_filename(filename), m_algorithm(algorithm) {
     }
     ~ChecksumStream();
 
@@ -54,6 +57,7 @@ private:
     std::ofstream m_outStream;
     std::stringstream m_bufStream;
     const std::string m_filename;
+    const ChecksumValidator::Algorithm m_algorithm;
     static const char m_fieldSeparator;
     static const char m_recordSeparator;
 };
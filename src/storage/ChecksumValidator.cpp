@@ -24,9 +24,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <fstream>
+#include <map>
 #include <memory>
 #include <new>
-#include <sstream>
 
 #include <config/PathConfig.h>
 #include <exceptions/ChecksumRecordCorruptedException.h>
@@ -34,10 +34,14 @@
 #include <log/log.h>
 #include <md5wrapper.h>
 
+#include <storage/ChecksumCalculator.h>
+
 #include "ChecksumValidator.h"
 
 namespace Cynara {
 
+const std::string ChecksumValidator::crc32cTag("$crc32c$");
+
 void ChecksumValidator::load(std::istream &stream) {
     m_sums.clear();
 
@@ -57,16 +61,60 @@ void ChecksumValidator::load(std::istream &stream) {
     }
 };
 
+const std::string ChecksumValidator::digest(void) const {
+    std::map<std::string, std::string> sortedSums(m_sums.begin(), m_sums.end());
+
+    std::string records;
+    for (const auto &sum : sortedSums) {
+        records += sum.first + PathConfig::StoragePath::fieldSeparator + sum.second +
+                   PathConfig::StoragePath::recordSeparator;
+    }
+    return generate(records);
+}
+
 const std::string ChecksumValidator::generate(const std::string &data) {
     return generateMD5(data);
 }
 
+const std::string ChecksumValidator::generate(const std::string &data, Algorithm algorithm) {
+    ChecksumCalculator calculator(algorithm);
+    calculator.update(data.data(), data.size());
+    return calculator.final();
+}
+
+ChecksumValidator::Algorithm ChecksumValidator::algorithm(const std::string &checksum) {
+    if (checksum.compare(0, crc32cTag.size(), crc32cTag) == 0) {
+        return Algorithm::CRC32C;
+    }
+    return Algorithm::MD5;
+}
+
 void ChecksumValidator::compare(std::istream &stream, const std::string &pathname,
                                 bool isBackupValid) {
-    if (isChecksumIndex(pathname)) {
+    std::string checksum;
+    if (!expected(pathname, isBackupValid, checksum)) {
         return;
     }
 
+    ChecksumCalculator calculator(algorithm(checksum));
+    char buffer[4096];
+    std::streamsize size;
+    while ((size = stream.rdbuf()->sgetn(buffer, sizeof(buffer))) > 0) {
+        calculator.update(buffer, static_cast<std::size_t>(size));
+    }
+    stream.seekg(0);
+
+    if (checksum != calculator.final()) {
+        throw ChecksumRecordCorruptedException(checksum);
+    }
+};
+
+bool ChecksumValidator::expected(const std::string &pathname, bool isBackupValid,
+                                 std::string &checksum) const {
+    if (isChecksumIndex(pathname)) {
+        return false;
+    }
+
     std::unique_ptr<char, decltype(free)*> pathnameDuplicate(strdup(pathname.c_str()), free);
     if (pathnameDuplicate == nullptr) {
         LOGE("Insufficient memory available to allocate duplicate filename: <%s>",
@@ -75,7 +123,6 @@ void ChecksumValidator::compare(std::istream &stream, const std::string &pathnam
     }
 
     std::string filename(::basename(pathnameDuplicate.get()));
-    std::stringstream copyStream;
 
     if (isBackupValid) {
         auto backupSuffixPos = filename.rfind(PathConfig::StoragePath::backupFilenameSuffix);
@@ -87,15 +134,11 @@ void ChecksumValidator::compare(std::istream &stream, const std::string &pathnam
         }
     }
 
-    std::copy(std::istreambuf_iterator<char>(stream),
-              std::istreambuf_iterator<char>(),
-              std::ostreambuf_iterator<char>(copyStream));
-    stream.seekg(0);
-
-    if (m_sums[filename] != generate(copyStream.str())) {
-        throw ChecksumRecordCorruptedException(m_sums[filename]);
-    }
-};
+    // File without checksum record cannot match any contents
+    checksum.clear();
+    find(filename, checksum);
+    return true;
+}
 
 const std::string ChecksumValidator::parseFilename(const std::string &line,
                                                    std::size_t &beginToken) {
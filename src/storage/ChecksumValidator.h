@@ -35,16 +35,41 @@ typedef std::unique_ptr<ChecksumValidator> ChecksumValidatorUniquePtr;
 
 class ChecksumValidator {
 public:
+    // Algorithm is told from checksum by its tag prefix; MD5 checksums are not tagged
+    enum class Algorithm {
+        MD5,
+        CRC32C
+    };
+
+    static const std::string crc32cTag;
+
     ChecksumValidator(const std::string &path) : m_dbPath(path) {}
 
     void load(std::istream &stream);
     void compare(std::istream &stream, const std::string &pathname, bool isBackupValid);
+    // Gives checksum the file should have; returns false for files not covered by checksums
+    bool expected(const std::string &pathname, bool isBackupValid, std::string &checksum) const;
 
     void clear(void) {
         m_sums.clear();
     }
 
+    // Finds checksum loaded for given file (named as in checksum records)
+    bool find(const std::string &filename, std::string &checksum) const {
+        auto it = m_sums.find(filename);
+        if (it == m_sums.end()) {
+            return false;
+        }
+        checksum = it->second;
+        return true;
+    }
+
+    // Checksum of all loaded records, independent of their order in checksum file
+    const std::string digest(void) const;
+
     static const std::string generate(const std::string &data);
+    static const std::string generate(const std::string &data, Algorithm algorithm);
+    static Algorithm algorithm(const std::string &checksum);
 
 protected:
     typedef std::unordered_map<std::string, std::string> Checksums;
@@ -0,0 +1,609 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/storage/DatabaseImage.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Implementation of Cynara::DatabaseImage
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <map>
+#include <memory>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <config/PathConfig.h>
+#include <exceptions/BucketNotExistsException.h>
+#include <exceptions/UnexpectedErrorException.h>
+#include <log/log.h>
+#include <md5wrapper.h>
+#include <types/Policy.h>
+#include <types/PolicyKeyHelpers.h>
+#include <types/PolicyType.h>
+
+#include "DatabaseImage.h"
+
+namespace Cynara {
+
+namespace {
+
+const char imageMagic[8] = { 'C', 'Y', 'N', 'A', 'R', 'A', 'D', 'B' };
+// Version 2 had no hash indexes
+const std::uint32_t imageVersion = 3;
+const std::size_t digestLength = 32;
+
+} // namespace
+
+struct DatabaseImage::Header {
+    char magic[sizeof(imageMagic)];
+    std::uint32_t version;
+    Index stringCount;
+    Index bucketCount;
+    Index policyCount;
+    Index slotCount;
+    Index stringDataSize;
+    char snapshotDigest[digestLength];
+    // Checksum of everything following the header
+    char checksum[digestLength];
+};
+
+struct DatabaseImage::StringRecord {
+    Index offset;
+    Index length;
+};
+
+struct DatabaseImage::BucketRecord {
+    Index id;
+    Index policyType;
+    Index metadata;
+    Index firstPolicy;
+    Index policyCount;
+    Index firstSlot;
+    Index slotCount;
+};
+
+struct DatabaseImage::PolicyRecord {
+    Index client;
+    Index user;
+    Index privilege;
+    Index policyType;
+    Index metadata;
+};
+
+struct DatabaseImage::Variant {
+    Index client;
+    Index user;
+    Index privilege;
+};
+
+struct DatabaseImage::EvaluatedBucket {
+    const BucketRecord *bucket;
+    PolicyResult result;
+    bool done;
+};
+
+DatabaseImage::DatabaseImage(const std::string &filename) : m_filename(filename),
+    m_image(nullptr), m_size(0), m_header(nullptr), m_strings(nullptr), m_buckets(nullptr),
+    m_policies(nullptr), m_slots(nullptr), m_stringData(nullptr) {
+}
+
+DatabaseImage::~DatabaseImage() {
+    close();
+}
+
+bool DatabaseImage::open(const std::string &snapshotDigest) {
+    close();
+
+    int fd = TEMP_FAILURE_RETRY(::open(m_filename.c_str(), O_RDONLY));
+    if (fd < 0) {
+        int err = errno;
+        if (err != ENOENT) {
+            LOGW("Cannot open database image <%s>: %s", m_filename.c_str(), strerror(err));
+        }
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd);
+        LOGW("Database image <%s> is too short", m_filename.c_str());
+        return false;
+    }
+
+    const auto size = static_cast<std::size_t>(st.st_size);
+    void *image = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (image == MAP_FAILED) {
+        int err = errno;
+        (void) err;
+        LOGW("Cannot map database image <%s>: %s", m_filename.c_str(), strerror(err));
+        return false;
+    }
+    m_image = image;
+    m_size = size;
+
+    if (!validate(snapshotDigest, m_size)) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void DatabaseImage::close(void) {
+    if (m_image != nullptr) {
+        munmap(m_image, m_size);
+    }
+
+    m_image = nullptr;
+    m_size = 0;
+    m_header = nullptr;
+    m_strings = nullptr;
+    m_buckets = nullptr;
+    m_policies = nullptr;
+    m_slots = nullptr;
+    m_stringData = nullptr;
+}
+
+bool DatabaseImage::validate(const std::string &snapshotDigest, std::size_t size) {
+    const char *base = static_cast<const char *>(m_image);
+    m_header = reinterpret_cast<const Header *>(base);
+
+    if (memcmp(m_header->magic, imageMagic, sizeof(imageMagic)) != 0
+        || m_header->version != imageVersion) {
+        LOGW("Database image <%s> has unknown format", m_filename.c_str());
+        return false;
+    }
+
+    if (snapshotDigest.size() != digestLength
+        || snapshotDigest.compare(0, digestLength, m_header->snapshotDigest, digestLength) != 0) {
+        LOGN("Database image <%s> does not match database", m_filename.c_str());
+        return false;
+    }
+
+    // Computed in 64 bits, so that corrupted counts cannot overflow
+    std::uint64_t expectedSize = sizeof(Header)
+        + static_cast<std::uint64_t>(m_header->stringCount) * sizeof(StringRecord)
+        + static_cast<std::uint64_t>(m_header->bucketCount) * sizeof(BucketRecord)
+        + static_cast<std::uint64_t>(m_header->policyCount) * sizeof(PolicyRecord)
+        + static_cast<std::uint64_t>(m_header->slotCount) * sizeof(Index)
+        + m_header->stringDataSize;
+    if (expectedSize != size) {
+        LOGW("Database image <%s> has invalid size", m_filename.c_str());
+        return false;
+    }
+
+    const std::string checksum = generateMD5(base + sizeof(Header), size - sizeof(Header));
+    if (checksum.compare(0, digestLength, m_header->checksum, digestLength) != 0) {
+        LOGW("Database image <%s> is corrupted", m_filename.c_str());
+        return false;
+    }
+
+    m_strings = reinterpret_cast<const StringRecord *>(base + sizeof(Header));
+    m_buckets = reinterpret_cast<const BucketRecord *>(m_strings + m_header->stringCount);
+    m_policies = reinterpret_cast<const PolicyRecord *>(m_buckets + m_header->bucketCount);
+    m_slots = reinterpret_cast<const Index *>(m_policies + m_header->policyCount);
+    m_stringData = reinterpret_cast<const char *>(m_slots + m_header->slotCount);
+
+    // Records are trusted after this point, so every reference is checked once here
+    const auto stringCount = m_header->stringCount;
+    for (Index i = 0; i < stringCount; ++i) {
+        const auto &record = m_strings[i];
+        bool valid = static_cast<std::uint64_t>(record.offset) + record.length
+                     <= m_header->stringDataSize;
+        // Strings are searched by bisection
+        if (valid && i > 0) {
+            const auto &previous = m_strings[i - 1];
+            valid = std::lexicographical_compare(
+                m_stringData + previous.offset, m_stringData + previous.offset + previous.length,
+                m_stringData + record.offset, m_stringData + record.offset + record.length);
+        }
+
+        if (!valid) {
+            LOGW("Database image <%s> has invalid string record", m_filename.c_str());
+            return false;
+        }
+    }
+
+    for (Index i = 0; i < m_header->policyCount; ++i) {
+        const auto &policy = m_policies[i];
+        if (policy.client >= stringCount || policy.user >= stringCount
+            || policy.privilege >= stringCount || policy.metadata >= stringCount) {
+            LOGW("Database image <%s> has invalid policy record", m_filename.c_str());
+            return false;
+        }
+    }
+
+    for (Index i = 0; i < m_header->bucketCount; ++i) {
+        const auto &bucket = m_buckets[i];
+        bool valid = bucket.id < stringCount && bucket.metadata < stringCount
+            && (i == 0 || m_buckets[i - 1].id < bucket.id)
+            && static_cast<std::uint64_t>(bucket.firstPolicy) + bucket.policyCount
+               <= m_header->policyCount
+            && static_cast<std::uint64_t>(bucket.firstSlot) + bucket.slotCount
+               <= m_header->slotCount
+            // Index of bucket always has an empty slot, so probing ends
+            && (bucket.slotCount & (bucket.slotCount - 1)) == 0
+            && (bucket.policyCount == 0 || bucket.slotCount > bucket.policyCount);
+
+        for (Index slot = 0; valid && slot < bucket.slotCount; ++slot) {
+            valid = m_slots[bucket.firstSlot + slot] <= bucket.policyCount;
+        }
+
+        if (!valid) {
+            LOGW("Database image <%s> has invalid bucket record", m_filename.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void DatabaseImage::load(Buckets &buckets) const {
+    buckets.clear();
+
+    // Every string becomes a key feature once, so policies share it instead of parsing it again
+    std::vector<PolicyKeyFeature> features;
+    features.reserve(m_header->stringCount);
+    for (Index i = 0; i < m_header->stringCount; ++i) {
+        features.push_back(PolicyKeyFeature::create(string(i)));
+    }
+
+    for (Index i = 0; i < m_header->bucketCount; ++i) {
+        const auto &record = m_buckets[i];
+        const auto bucketId = string(record.id);
+        auto &bucket = buckets.insert({ bucketId, PolicyBucket(bucketId,
+                                        result(record.policyType, record.metadata)) })
+                              .first->second;
+
+        for (Index j = 0; j < record.policyCount; ++j) {
+            const auto &policy = m_policies[record.firstPolicy + j];
+            bucket.insertPolicy(std::make_shared<Policy>(
+                PolicyKey(features[policy.client], features[policy.user],
+                          features[policy.privilege]),
+                result(policy.policyType, policy.metadata)));
+        }
+    }
+}
+
+bool DatabaseImage::hasBucket(const PolicyBucketId &bucketId) const {
+    return findBucket(findString(bucketId)) != nullptr;
+}
+
+PolicyResult DatabaseImage::check(const PolicyKey &key, const PolicyBucketId &startBucketId,
+                                  bool recursive) const {
+    const auto *startBucket = findBucket(findString(startBucketId));
+    if (startBucket == nullptr) {
+        throw BucketNotExistsException(startBucketId);
+    }
+
+    // Variants of key, as in PolicyKeyVariants; ones made of strings not in image cannot match
+    const Index features[] = { findString(key.client().toString()),
+                               findString(key.user().toString()),
+                               findString(key.privilege().toString()) };
+    const Index wildcard = findString(PolicyKeyHelpers::wildcard().toString());
+
+    std::vector<Variant> variants;
+    for (unsigned shape = 0; shape < 8; ++shape) {
+        Index variant[3];
+        bool possible = true;
+        for (unsigned feature = 0; feature < 3; ++feature) {
+            const bool isWildcard = (shape & (1u << feature)) != 0;
+            if (isWildcard && features[feature] == wildcard) {
+                // Same as variant without this wildcard
+                possible = false;
+            }
+            variant[feature] = isWildcard ? wildcard : features[feature];
+            possible = possible && variant[feature] != npos;
+        }
+
+        if (possible) {
+            variants.push_back({ variant[0], variant[1], variant[2] });
+        }
+    }
+
+    std::vector<EvaluatedBucket> evaluated;
+    evaluated.push_back({ startBucket, PredefinedPolicyType::NONE, false });
+    return minimalPolicy(*startBucket, variants, recursive, evaluated);
+}
+
+// Same rules as Storage::minimalPolicy() and Storage::bucketMinimalPolicy()
+PolicyResult DatabaseImage::minimalPolicy(const BucketRecord &bucket,
+                                          const std::vector<Variant> &variants, bool recursive,
+                                          std::vector<EvaluatedBucket> &evaluated) const {
+    bool hasMinimal = false;
+    PolicyResult minimal = result(bucket.policyType, bucket.metadata);
+
+    auto proposeMinimal = [&minimal, &hasMinimal](const PolicyResult &candidate) {
+        if (hasMinimal == false || candidate < minimal) {
+            minimal = candidate;
+        }
+        hasMinimal = true;
+    };
+
+    for (const auto &variant : variants) {
+        const auto *policy = findPolicy(bucket, variant);
+        if (policy == nullptr) {
+            continue;
+        }
+
+        switch (policy->policyType) {
+            case PredefinedPolicyType::DENY:
+                return result(policy->policyType, policy->metadata);
+            case PredefinedPolicyType::BUCKET: {
+                    if (recursive == false) {
+                        continue;
+                    }
+
+                    const auto *linked = findBucket(policy->metadata);
+                    if (linked == nullptr) {
+                        throw BucketNotExistsException(string(policy->metadata));
+                    }
+
+                    auto evaluatedIt = std::find_if(evaluated.begin(), evaluated.end(),
+                        [linked] (const EvaluatedBucket &entry) {
+                            return entry.bucket == linked;
+                        });
+
+                    PolicyResult minimumOfBucket = PredefinedPolicyType::NONE;
+                    if (evaluatedIt != evaluated.end()) {
+                        if (evaluatedIt->done) {
+                            minimumOfBucket = evaluatedIt->result;
+                        }
+                    } else {
+                        const auto index = evaluated.size();
+                        evaluated.push_back({ linked, PredefinedPolicyType::NONE, false });
+                        minimumOfBucket = minimalPolicy(*linked, variants, true, evaluated);
+                        evaluated[index].result = minimumOfBucket;
+                        evaluated[index].done = true;
+                    }
+
+                    if (minimumOfBucket != PredefinedPolicyType::NONE) {
+                        proposeMinimal(minimumOfBucket);
+                    }
+                    continue;
+                }
+            default:
+                break;
+        }
+
+        proposeMinimal(result(policy->policyType, policy->metadata));
+    }
+
+    return minimal;
+}
+
+DatabaseImage::Index DatabaseImage::findString(const std::string &value) const {
+    Index first = 0;
+    Index last = m_header->stringCount;
+
+    while (first < last) {
+        const Index middle = first + (last - first) / 2;
+        const auto &record = m_strings[middle];
+        const int cmp = value.compare(0, std::string::npos, m_stringData + record.offset,
+                                      record.length);
+        if (cmp == 0) {
+            return middle;
+        } else if (cmp < 0) {
+            last = middle;
+        } else {
+            first = middle + 1;
+        }
+    }
+
+    return npos;
+}
+
+const DatabaseImage::BucketRecord *DatabaseImage::findBucket(Index bucketId) const {
+    if (bucketId == npos) {
+        return nullptr;
+    }
+
+    const auto *end = m_buckets + m_header->bucketCount;
+    const auto *bucket = std::lower_bound(m_buckets, end, bucketId,
+        [] (const BucketRecord &record, Index id) {
+            return record.id < id;
+        });
+
+    return (bucket != end && bucket->id == bucketId) ? bucket : nullptr;
+}
+
+const DatabaseImage::PolicyRecord *DatabaseImage::findPolicy(const BucketRecord &bucket,
+                                                             const Variant &variant) const {
+    if (bucket.slotCount == 0) {
+        return nullptr;
+    }
+
+    const Index mask = bucket.slotCount - 1;
+    Index slot = PolicyKeyHelpers::hashKey(variant.client, variant.user, variant.privilege)
+                 & mask;
+
+    while (const Index entry = m_slots[bucket.firstSlot + slot]) {
+        const auto *policy = &m_policies[bucket.firstPolicy + entry - 1];
+        if (policy->client == variant.client && policy->user == variant.user
+            && policy->privilege == variant.privilege) {
+            return policy;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return nullptr;
+}
+
+std::string DatabaseImage::string(Index index) const {
+    const auto &record = m_strings[index];
+    return std::string(m_stringData + record.offset, record.length);
+}
+
+PolicyResult DatabaseImage::result(Index policyType, Index metadata) const {
+    return PolicyResult(static_cast<PolicyType>(policyType), string(metadata));
+}
+
+void DatabaseImage::dump(const Buckets &buckets, const std::string &snapshotDigest,
+                         const std::string &filename) {
+    // Strings are sorted, so order of their indexes is the order of strings
+    std::map<std::string, Index> stringIndexes;
+    for (const auto &bucketIter : buckets) {
+        const auto &bucket = bucketIter.second;
+        stringIndexes[bucket.id()];
+        stringIndexes[bucket.defaultPolicy().metadata()];
+        for (const auto &policy : bucket) {
+            stringIndexes[policy->key().client().toString()];
+            stringIndexes[policy->key().user().toString()];
+            stringIndexes[policy->key().privilege().toString()];
+            stringIndexes[policy->result().metadata()];
+        }
+    }
+
+    std::vector<StringRecord> strings;
+    std::string stringData;
+    for (auto &stringIter : stringIndexes) {
+        stringIter.second = static_cast<Index>(strings.size());
+        strings.push_back({ static_cast<Index>(stringData.size()),
+                            static_cast<Index>(stringIter.first.size()) });
+        stringData += stringIter.first;
+    }
+
+    std::vector<const PolicyBucket *> sortedBuckets;
+    for (const auto &bucketIter : buckets) {
+        sortedBuckets.push_back(&bucketIter.second);
+    }
+    std::sort(sortedBuckets.begin(), sortedBuckets.end(),
+              [] (const PolicyBucket *first, const PolicyBucket *second) {
+                  return first->id() < second->id();
+              });
+
+    std::vector<BucketRecord> bucketRecords;
+    std::vector<PolicyRecord> policies;
+    std::vector<Index> slots;
+    for (const auto *bucket : sortedBuckets) {
+        BucketRecord record;
+        record.id = stringIndexes[bucket->id()];
+        record.policyType = bucket->defaultPolicy().policyType();
+        record.metadata = stringIndexes[bucket->defaultPolicy().metadata()];
+        record.firstPolicy = static_cast<Index>(policies.size());
+        record.policyCount = static_cast<Index>(bucket->size());
+        record.firstSlot = static_cast<Index>(slots.size());
+        record.slotCount = 0;
+
+        if (record.policyCount > 0) {
+            // At most half of slots are used, so probing sequences stay short
+            record.slotCount = 2;
+            while (record.slotCount < 2 * record.policyCount) {
+                record.slotCount *= 2;
+            }
+        }
+        slots.resize(slots.size() + record.slotCount, 0);
+
+        for (const auto &policy : *bucket) {
+            PolicyRecord policyRecord;
+            policyRecord.client = stringIndexes[policy->key().client().toString()];
+            policyRecord.user = stringIndexes[policy->key().user().toString()];
+            policyRecord.privilege = stringIndexes[policy->key().privilege().toString()];
+            policyRecord.policyType = policy->result().policyType();
+            policyRecord.metadata = stringIndexes[policy->result().metadata()];
+
+            const Index mask = record.slotCount - 1;
+            Index slot = PolicyKeyHelpers::hashKey(policyRecord.client, policyRecord.user,
+                                                   policyRecord.privilege) & mask;
+            while (slots[record.firstSlot + slot] != 0) {
+                slot = (slot + 1) & mask;
+            }
+            policies.push_back(policyRecord);
+            slots[record.firstSlot + slot] = static_cast<Index>(policies.size())
+                                             - record.firstPolicy;
+        }
+
+        bucketRecords.push_back(record);
+    }
+
+    std::string body;
+    auto append = [&body] (const void *data, std::size_t size) {
+        body.append(static_cast<const char *>(data), size);
+    };
+    append(strings.data(), strings.size() * sizeof(StringRecord));
+    append(bucketRecords.data(), bucketRecords.size() * sizeof(BucketRecord));
+    append(policies.data(), policies.size() * sizeof(PolicyRecord));
+    append(slots.data(), slots.size() * sizeof(Index));
+    body += stringData;
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, imageMagic, sizeof(imageMagic));
+    header.version = imageVersion;
+    header.stringCount = static_cast<Index>(strings.size());
+    header.bucketCount = static_cast<Index>(bucketRecords.size());
+    header.policyCount = static_cast<Index>(policies.size());
+    header.slotCount = static_cast<Index>(slots.size());
+    header.stringDataSize = static_cast<Index>(stringData.size());
+    snapshotDigest.copy(header.snapshotDigest, digestLength);
+    generateMD5(body).copy(header.checksum, digestLength);
+
+    // Image is replaced atomically, so it is never seen partially written
+    const std::string tmpFilename = filename + PathConfig::StoragePath::backupFilenameSuffix;
+    int fd = TEMP_FAILURE_RETRY(::open(tmpFilename.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                                       S_IRUSR | S_IWUSR));
+    if (fd < 0) {
+        int err = errno;
+        LOGE("'open' function error [%d] : <%s>", err, strerror(err));
+        throw UnexpectedErrorException(err, strerror(err));
+    }
+
+    body.insert(0, reinterpret_cast<const char *>(&header), sizeof(header));
+    std::size_t written = 0;
+    while (written < body.size()) {
+        auto ret = TEMP_FAILURE_RETRY(write(fd, body.data() + written, body.size() - written));
+        if (ret < 0) {
+            int err = errno;
+            ::close(fd);
+            LOGE("'write' function error [%d] : <%s>", err, strerror(err));
+            throw UnexpectedErrorException(err, strerror(err));
+        }
+        written += static_cast<std::size_t>(ret);
+    }
+
+    int ret = fsync(fd);
+    int err = errno;
+    ::close(fd);
+    if (ret < 0) {
+        LOGE("'fsync' function error [%d] : <%s>", err, strerror(err));
+        throw UnexpectedErrorException(err, strerror(err));
+    }
+
+    if (rename(tmpFilename.c_str(), filename.c_str()) < 0) {
+        err = errno;
+        LOGE("'rename' function error [%d] : <%s>", err, strerror(err));
+        throw UnexpectedErrorException(err, strerror(err));
+    }
+
+    const std::string dirname = filename.substr(0, filename.rfind('/') + 1);
+    int dirFd = TEMP_FAILURE_RETRY(::open(dirname.empty() ? "." : dirname.c_str(),
+                                          O_RDONLY | O_DIRECTORY));
+    if (dirFd >= 0) {
+        fsync(dirFd);
+        ::close(dirFd);
+    }
+}
+
+} /* namespace Cynara */
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/storage/DatabaseImage.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Headers for Cynara::DatabaseImage
+ */
+
+#ifndef SRC_STORAGE_DATABASEIMAGE_H_
+#define SRC_STORAGE_DATABASEIMAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <types/PolicyBucket.h>
+#include <types/PolicyBucketId.h>
+#include <types/PolicyKey.h>
+#include <types/PolicyResult.h>
+
+#include <storage/Buckets.h>
+
+namespace Cynara {
+
+/*
+ * Binary image of database snapshot, used in place of text files when it matches the snapshot.
+ * Image consists of sorted table of distinct strings, fixed size bucket and policy records
+ * referring to strings by their position, and an open addressing hash index of every bucket.
+ * It is mapped into memory as a whole, so policies can be loaded without parsing and checks
+ * can be answered directly from the mapped file.
+ */
+class DatabaseImage {
+public:
+    DatabaseImage(const std::string &filename);
+    ~DatabaseImage();
+
+    DatabaseImage(const DatabaseImage &) = delete;
+    DatabaseImage &operator=(const DatabaseImage &) = delete;
+
+    // Maps image of snapshot with given digest; fails if image is missing, stale or corrupted
+    bool open(const std::string &snapshotDigest);
+    void close(void);
+
+    bool isOpen(void) const {
+        return m_image != nullptr;
+    }
+
+    void load(Buckets &buckets) const;
+    bool hasBucket(const PolicyBucketId &bucketId) const;
+    PolicyResult check(const PolicyKey &key,
+                       const PolicyBucketId &startBucketId = defaultPolicyBucketId,
+                       bool recursive = true) const;
+
+    static void dump(const Buckets &buckets, const std::string &snapshotDigest,
+                     const std::string &filename);
+
+private:
+    typedef std::uint32_t Index;
+    static const Index npos = static_cast<Index>(-1);
+
+    struct Header;
+    struct StringRecord;
+    struct BucketRecord;
+    struct PolicyRecord;
+    struct Variant;
+    struct EvaluatedBucket;
+
+    bool validate(const std::string &snapshotDigest, std::size_t size);
+
+    Index findString(const std::string &value) const;
+    const BucketRecord *findBucket(Index bucketId) const;
+    const PolicyRecord *findPolicy(const BucketRecord &bucket, const Variant &variant) const;
+    std::string string(Index index) const;
+    PolicyResult result(Index policyType, Index metadata) const;
+
+    PolicyResult minimalPolicy(const BucketRecord &bucket, const std::vector<Variant> &variants,
+                               bool recursive, std::vector<EvaluatedBucket> &evaluated) const;
+
+    const std::string m_filename;
+    void *m_image;
+    std::size_t m_size;
+
+    const Header *m_header;
+    const StringRecord *m_strings;
+    const BucketRecord *m_buckets;
+    const PolicyRecord *m_policies;
+    const Index *m_slots;
+    const char *m_stringData;
+};
+
+} /* namespace Cynara */
+
+#endif /* SRC_STORAGE_DATABASEIMAGE_H_ */
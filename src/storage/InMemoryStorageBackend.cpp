@@ -26,6 +26,7 @@
 #include <functional>
 #include <memory>
 #include <new>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string.h>
@@ -45,6 +46,7 @@
 #include <types/PolicyType.h>
 
 #include <storage/BucketDeserializer.h>
+#include <storage/ChecksumInputStream.h>
 #include <storage/Integrity.h>
 #include <storage/StorageDeserializer.h>
 #include <storage/StorageSerializer.h>
@@ -53,8 +55,13 @@
 
 namespace Cynara {
 
-InMemoryStorageBackend::InMemoryStorageBackend(const std::string &path) : m_dbPath(path),
-    m_checksum(path), m_integrity(path) {
+InMemoryStorageBackend::InMemoryStorageBackend(const std::string &path,
+                                               std::size_t journalSizeLimit, bool imageEnabled,
+                                               ChecksumValidator::Algorithm checksumAlgorithm)
+    : m_dbPath(path), m_checksum(path), m_checksumAlgorithm(checksumAlgorithm),
+      m_integrity(path), m_journal(path, journalSizeLimit),
+      m_image(path + PathConfig::StoragePath::imageFilename), m_imageEnabled(imageEnabled),
+      m_allBucketsDirty(true) {
 }
 
 void InMemoryStorageBackend::load(void) {
@@ -62,7 +69,9 @@ void InMemoryStorageBackend::load(void) {
     std::string bucketSuffix = "";
     std::string indexFilename = m_dbPath + PathConfig::StoragePath::indexFilename;
     std::string chsFilename = m_dbPath + PathConfig::StoragePath::checksumFilename;
+    std::string snapshotChecksum;
 
+    m_image.close();
     if (isBackupValid) {
         bucketSuffix += PathConfig::StoragePath::backupFilenameSuffix;
         indexFilename += PathConfig::StoragePath::backupFilenameSuffix;
@@ -70,50 +79,243 @@ void InMemoryStorageBackend::load(void) {
     }
 
     try {
-        std::ifstream chsStream;
-        openFileStream(chsStream, chsFilename, isBackupValid);
-        m_checksum.load(chsStream);
-
-        auto indexStream = std::make_shared<std::ifstream>();
-        openFileStream(*indexStream, indexFilename, isBackupValid);
-
-        StorageDeserializer storageDeserializer(indexStream,
-            std::bind(&InMemoryStorageBackend::bucketStreamOpener, this,
-                      std::placeholders::_1, bucketSuffix, isBackupValid));
-
-        storageDeserializer.initBuckets(buckets());
-        storageDeserializer.loadBuckets(buckets());
+        auto chsStream = openFileStream(chsFilename, isBackupValid);
+        m_checksum.load(*chsStream);
+        snapshotChecksum = m_checksum.digest();
+
+        // Image is used only if it was made of the very same snapshot. It stays mapped
+        // and its policies are loaded only, when database is changed or listed.
+        if (m_image.open(snapshotChecksum)) {
+            LOGI("Using binary image of database");
+        } else {
+            auto indexStream = openFileStream(indexFilename, isBackupValid);
+
+            StorageDeserializer storageDeserializer(indexStream,
+                std::bind(&InMemoryStorageBackend::bucketStreamOpener, this,
+                          std::placeholders::_1, bucketSuffix, isBackupValid));
+
+            storageDeserializer.initBuckets(buckets());
+            storageDeserializer.loadBuckets(buckets());
+        }
     } catch (const DatabaseException &) {
         LOGC("Reading cynara database failed.");
+        m_image.close();
         buckets().clear();
         throw DatabaseCorruptedException();
     }
-    m_checksum.clear();
+    // Checksums are kept, so next save can reuse records of buckets not changed in between
+    m_dirtyBuckets.clear();
+    m_allBucketsDirty = false;
 
     if (!hasBucket(defaultPolicyBucketId)) {
         LOGN("Creating defaultBucket.");
         this->buckets().insert({ defaultPolicyBucketId, PolicyBucket(defaultPolicyBucketId) });
+        markDirty(defaultPolicyBucketId);
     }
 
     postLoadCleanup(isBackupValid);
+    // Links of image policies are indexed, when they are loaded
+    if (!m_image.isOpen()) {
+        indexLinks();
+    }
+
+    // Changes saved after the snapshot; replayed changes are marked dirty like any other
+    m_journal.replay(snapshotChecksum, *this);
 }
 
-void InMemoryStorageBackend::saveBackup(void) {
-    std::string checksumFilename = m_dbPath + PathConfig::StoragePath::checksumFilename;
+void InMemoryStorageBackend::saveBackup(SaveState &state) {
+    std::string checksumFilename = m_dbPath + PathConfig::StoragePath::checksumFilename +
+                                   PathConfig::StoragePath::backupFilenameSuffix;
     auto chsStream = std::make_shared<std::ofstream>();
-    openDumpFileStream<std::ofstream>(*chsStream,
-            checksumFilename + PathConfig::StoragePath::backupFilenameSuffix);
+    openDumpFileStream<std::ofstream>(*chsStream, checksumFilename);
 
-    dumpDatabase(chsStream);
+    dumpDatabase(state, chsStream);
+    chsStream->close();
+
+    // Remember checksums of saved files for the next save
+    std::ifstream savedChsStream(checksumFilename);
+    std::ostringstream records;
+    records << savedChsStream.rdbuf();
+    state.checksumRecords = records.str();
+
+    std::istringstream recordsStream(state.checksumRecords);
+    state.checksum.load(recordsStream);
 }
 
 void InMemoryStorageBackend::save(void) {
-    saveBackup();
+    auto task = prepareSave();
+    if (!task) {
+        return;
+    }
+
+    try {
+        task();
+    } catch (...) {
+        completeSave(false);
+        throw;
+    }
+    completeSave(true);
+}
+
+/*
+ * Files are written by returned task, which uses only the taken state, so backend can be changed
+ * while the task runs. Copies of buckets share their contents with backend, until backend changes
+ * them, so taking the state does not copy any policies.
+ */
+StorageBackend::SaveTask InMemoryStorageBackend::prepareSave(void) {
+    auto state = std::make_shared<SaveState>(m_checksum);
+
+    if (m_journal.enabled() && !m_allBucketsDirty && !m_journal.full()) {
+        if (!m_journal.prepareCommit(state->records, state->truncate)) {
+            return SaveTask();
+        }
+
+        m_saveState = state;
+        return [this, state] () {
+            m_journal.append(state->records, state->truncate);
+        };
+    }
+
+    state->snapshot = true;
+    state->changedBucketIds = changedBuckets();
+    for (const auto &bucketIter : buckets()) {
+        const auto &bucket = bucketIter.second;
+        // Files of unchanged buckets are reused, so only image needs their policies
+        if (m_imageEnabled || state->changedBucketIds.count(bucketIter.first)) {
+            state->buckets.insert(bucketIter);
+        } else {
+            state->buckets.insert({ bucketIter.first,
+                                    PolicyBucket(bucket.id(), bucket.defaultPolicy()) });
+        }
+    }
+
+    // Changes made from now on are saved next time; journaled ones are part of the snapshot
+    m_dirtyBuckets.clear();
+    m_allBucketsDirty = false;
+    m_journal.discardPending();
 
-    m_integrity.syncDatabase(buckets(), true);
-    m_integrity.createBackupGuard();
-    m_integrity.revalidatePrimaryDatabase(buckets());
+    m_saveState = state;
+    return [this, state] () {
+        saveSnapshot(*state);
+    };
+}
+
+void InMemoryStorageBackend::completeSave(bool succeeded) {
+    auto state = std::move(m_saveState);
+    if (!state) {
+        return;
+    }
+
+    if (!succeeded) {
+        // Files may be left in any state of the save, so nothing of them is reused
+        m_allBucketsDirty = true;
+        return;
+    }
+
+    if (state->snapshot) {
+        std::istringstream recordsStream(state->checksumRecords);
+        m_checksum.load(recordsStream);
+        m_journal.started(state->snapshotChecksum, state->journalHeader.size());
+    }
+}
+
+/*
+ * Only buckets changed since last snapshot are written. Backup files of other buckets are hard
+ * links to their primary files, so backup guard protocol sees complete backup database.
+ */
+void InMemoryStorageBackend::saveSnapshot(SaveState &state) {
+    try {
+        saveBackup(state);
+
+        m_integrity.syncDatabase(state.changedBucketIds, true);
+        m_integrity.createBackupGuard();
+    } catch (...) {
+        // Backup without guard is never loaded, so its links to primary files are dropped
+        m_integrity.deleteBackupDatabase(state.buckets);
+        throw;
+    }
+    m_integrity.revalidatePrimaryDatabase(state.buckets, state.changedBucketIds);
     //guard is removed during revalidation
+
+    state.snapshotChecksum = state.checksum.digest();
+
+    // Journal of previous snapshot is not valid anymore, even if this one is left behind
+    if (m_journal.enabled()) {
+        state.journalHeader = m_journal.header(state.snapshotChecksum);
+        m_journal.append(state.journalHeader, true);
+    } else {
+        m_journal.removeFile();
+    }
+
+    // Image of previous snapshot does not match the new one, so it is never loaded again
+    if (m_imageEnabled) {
+        DatabaseImage::dump(state.buckets, state.snapshotChecksum,
+                            m_dbPath + PathConfig::StoragePath::imageFilename);
+    }
+}
+
+void InMemoryStorageBackend::loadImage(void) {
+    if (!m_image.isOpen()) {
+        return;
+    }
+
+    LOGI("Loading policies of binary image of database");
+    m_image.load(m_buckets);
+    m_image.close();
+    indexLinks();
+}
+
+void InMemoryStorageBackend::markDirty(const PolicyBucketId &bucketId) {
+    if (!m_allBucketsDirty) {
+        m_dirtyBuckets.insert(bucketId);
+    }
+}
+
+PolicyBucket::BucketIds InMemoryStorageBackend::changedBuckets(void) {
+    PolicyBucket::BucketIds bucketIds;
+    std::string checksum;
+
+    for (const auto &bucketIter : buckets()) {
+        const auto &bucketId = bucketIter.first;
+        // Bucket without checksum record cannot be reused, even if it was not changed
+        if (m_allBucketsDirty || m_dirtyBuckets.count(bucketId)
+            || !m_checksum.find(PathConfig::StoragePath::bucketFilenamePrefix + bucketId,
+                                checksum)) {
+            bucketIds.insert(bucketId);
+        }
+    }
+    return bucketIds;
+}
+
+void InMemoryStorageBackend::indexLinks(void) {
+    m_linkingBuckets.clear();
+    for (const auto &bucketIter : buckets()) {
+        for (const auto &linkedBucketId : bucketIter.second.getSubBuckets()) {
+            m_linkingBuckets[linkedBucketId].insert(bucketIter.first);
+        }
+    }
+}
+
+void InMemoryStorageBackend::updateLink(const PolicyBucketId &bucketId, const PolicyPtr &policy) {
+    if (!policy || policy->result().policyType() != PredefinedPolicyType::BUCKET) {
+        return;
+    }
+
+    const auto &linkedBucketId = policy->result().metadata();
+    if (buckets().at(bucketId).linksTo(linkedBucketId)) {
+        m_linkingBuckets[linkedBucketId].insert(bucketId);
+    } else {
+        removeLink(bucketId, linkedBucketId);
+    }
+}
+
+void InMemoryStorageBackend::removeLink(const PolicyBucketId &bucketId,
+                                        const PolicyBucketId &linkedBucketId) {
+    const auto linkingIter = m_linkingBuckets.find(linkedBucketId);
+    if (linkingIter != m_linkingBuckets.end() && linkingIter->second.erase(bucketId)
+        && linkingIter->second.empty()) {
+        m_linkingBuckets.erase(linkingIter);
+    }
 }
 
 PolicyBucket InMemoryStorageBackend::searchDefaultBucket(const PolicyKey &key) {
@@ -130,10 +332,33 @@ PolicyBucket InMemoryStorageBackend::searchBucket(const PolicyBucketId &bucketId
     }
 }
 
+void InMemoryStorageBackend::matchBucket(const PolicyBucketId &bucketId,
+                                         const PolicyKeyVariants &variants,
+                                         PolicyMatches &matches) {
+    const auto bucketIter = buckets().find(bucketId);
+    if (bucketIter == buckets().end()) {
+        throw BucketNotExistsException(bucketId);
+    }
+    bucketIter->second.match(variants, matches);
+}
+
+bool InMemoryStorageBackend::check(const PolicyKey &key, const PolicyBucketId &startBucketId,
+                                   bool recursive, PolicyResult &result) {
+    if (!m_image.isOpen()) {
+        return false;
+    }
+
+    result = m_image.check(key, startBucketId, recursive);
+    return true;
+}
+
 void InMemoryStorageBackend::insertPolicy(const PolicyBucketId &bucketId, PolicyPtr policy) {
     try {
         auto &bucket = buckets().at(bucketId);
-        bucket.insertPolicy(policy);
+        updateLink(bucketId, bucket.insertPolicy(policy));
+        updateLink(bucketId, policy);
+        markDirty(bucketId);
+        m_journal.insertPolicy(bucketId, policy);
     } catch (const std::out_of_range &) {
         throw BucketNotExistsException(bucketId);
     }
@@ -143,6 +368,8 @@ void InMemoryStorageBackend::createBucket(const PolicyBucketId &bucketId,
                                           const PolicyResult &defaultPolicy) {
     PolicyBucket newBucket(bucketId, defaultPolicy);
     buckets().insert({ bucketId, newBucket });
+    markDirty(bucketId);
+    m_journal.setBucket(bucketId, defaultPolicy);
 }
 
 void InMemoryStorageBackend::updateBucket(const PolicyBucketId &bucketId,
@@ -150,19 +377,28 @@ void InMemoryStorageBackend::updateBucket(const PolicyBucketId &bucketId,
     try {
         auto &bucket = buckets().at(bucketId);
         bucket.setDefaultPolicy(defaultPolicy);
+        m_journal.setBucket(bucketId, defaultPolicy);
     } catch (const std::out_of_range &) {
         throw BucketNotExistsException(bucketId);
     }
 }
 
 void InMemoryStorageBackend::deleteBucket(const PolicyBucketId &bucketId) {
-    auto bucketErased = buckets().erase(bucketId);
-    if (bucketErased == 0) {
+    const auto bucketIter = buckets().find(bucketId);
+    if (bucketIter == buckets().end()) {
         throw BucketNotExistsException(bucketId);
     }
+    for (const auto &linkedBucketId : bucketIter->second.getSubBuckets()) {
+        removeLink(bucketId, linkedBucketId);
+    }
+    buckets().erase(bucketIter);
+    m_journal.deleteBucket(bucketId);
 }
 
 bool InMemoryStorageBackend::hasBucket(const PolicyBucketId &bucketId) {
+    if (m_image.isOpen()) {
+        return m_image.hasBucket(bucketId);
+    }
     return buckets().find(bucketId) != buckets().end();
 }
 
@@ -170,28 +406,41 @@ void InMemoryStorageBackend::deletePolicy(const PolicyBucketId &bucketId, const
     try {
         // TODO: Move the erase code to PolicyCollection maybe?
         auto &bucket = buckets().at(bucketId);
-        bucket.deletePolicy(key);
+        updateLink(bucketId, bucket.deletePolicy(key));
+        markDirty(bucketId);
+        m_journal.deletePolicy(bucketId, key);
     } catch (const std::out_of_range &) {
         throw BucketNotExistsException(bucketId);
     }
 }
 
 void InMemoryStorageBackend::deleteLinking(const PolicyBucketId &bucketId) {
-    auto bucketIdMatches = [&bucketId] (PolicyPtr policy) -> bool {
-        auto policyResult = policy->result();
-
-        // Check bucket id only if policy is a bucket policy
-        // TODO: Maybe move the test to PolicyResult
-        if (policyResult.policyType() == PredefinedPolicyType::BUCKET) {
-            return policyResult.metadata() == bucketId;
+    const auto linkingIter = m_linkingBuckets.find(bucketId);
+    if (linkingIter != m_linkingBuckets.end()) {
+        for (const auto &linkingBucketId : linkingIter->second) {
+            buckets().at(linkingBucketId).deleteLinks(bucketId);
+            markDirty(linkingBucketId);
         }
-        return false;
-    };
+        m_linkingBuckets.erase(linkingIter);
+    }
+    m_journal.deleteLinking(bucketId);
+}
 
-    for (auto &bucketIter : buckets()) {
-        auto &bucket = bucketIter.second;
-        bucket.deletePolicy(bucketIdMatches);
+PolicyBucket::BucketIds InMemoryStorageBackend::getSubBuckets(
+        const PolicyBucketId &bucketId) const {
+    const auto bucketIter = buckets().find(bucketId);
+    if (bucketIter == buckets().end()) {
+        throw BucketNotExistsException(bucketId);
     }
+    return bucketIter->second.getSubBuckets();
+}
+
+PolicyBucket::Policies InMemoryStorageBackend::listLinks(const PolicyBucketId &bucketId) const {
+    const auto bucketIter = buckets().find(bucketId);
+    if (bucketIter == buckets().end()) {
+        throw BucketNotExistsException(bucketId);
+    }
+    return bucketIter->second.listLinks();
 }
 
 PolicyBucket::Policies InMemoryStorageBackend::listPolicies(const PolicyBucketId &bucketId,
@@ -214,52 +463,82 @@ void InMemoryStorageBackend::erasePolicies(const PolicyBucketId &bucketId, bool
         bucketIds.erase(it);
         try {
             auto &policyBucket = buckets().at(policyBucketId);
+            const auto subBuckets = policyBucket.getSubBuckets();
             if (recursive) {
-                auto subBuckets = policyBucket.getSubBuckets();
                 bucketIds.insert(subBuckets.begin(), subBuckets.end());
             }
-            policyBucket.deletePolicy([&filter] (PolicyPtr policy) -> bool {
-                 return policy->key().matchFilter(filter);
-            });
+            if (policyBucket.deletePolicies(filter) > 0) {
+                markDirty(policyBucketId);
+                for (const auto &linkedBucketId : subBuckets) {
+                    if (!policyBucket.linksTo(linkedBucketId)) {
+                        removeLink(policyBucketId, linkedBucketId);
+                    }
+                }
+            }
         } catch (const std::out_of_range &) {
             throw BucketNotExistsException(policyBucketId);
         }
     }
+    m_journal.erasePolicies(bucketId, recursive, filter);
 }
 
-void InMemoryStorageBackend::dumpDatabase(const std::shared_ptr<std::ofstream> &chsStream) {
+void InMemoryStorageBackend::dumpDatabase(const SaveState &state,
+                                          const std::shared_ptr<std::ofstream> &chsStream) {
     auto indexStream = std::make_shared<ChecksumStream>(PathConfig::StoragePath::indexFilename,
-            chsStream);
+            chsStream, m_checksumAlgorithm);
     std::string indexFilename = m_dbPath + PathConfig::StoragePath::indexFilename;
     openDumpFileStream<ChecksumStream>(*indexStream,
             indexFilename + PathConfig::StoragePath::backupFilenameSuffix);
 
     StorageSerializer<ChecksumStream> storageSerializer(indexStream);
-    storageSerializer.dump(buckets(), std::bind(&InMemoryStorageBackend::bucketDumpStreamOpener,
-                           this, std::placeholders::_1, chsStream));
+    storageSerializer.dumpIndex(state.buckets);
+
+    PolicyBucket::BucketIds unchangedBucketIds;
+    for (const auto &bucketIter : state.buckets) {
+        const auto &bucketId = bucketIter.first;
+        if (state.changedBucketIds.count(bucketId)) {
+            bucketDumpStreamOpener(bucketId, chsStream)->dump(bucketIter.second);
+            continue;
+        }
+
+        const auto bucketFilename = PathConfig::StoragePath::bucketFilenamePrefix + bucketId;
+        std::string checksum;
+        state.checksum.find(bucketFilename, checksum);
+        *chsStream << bucketFilename << PathConfig::StoragePath::fieldSeparator << checksum
+                   << PathConfig::StoragePath::recordSeparator;
+        unchangedBucketIds.insert(bucketId);
+    }
+
+    m_integrity.linkBackupBuckets(unchangedBucketIds);
 }
 
-void InMemoryStorageBackend::openFileStream(std::ifstream &stream, const std::string &filename,
-                                            bool isBackupValid) {
-    // TODO: Consider adding exceptions to streams and handling them:
-    // stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-    stream.open(filename);
+std::shared_ptr<std::istream> InMemoryStorageBackend::openFileStream(
+        const std::string &filename, bool isBackupValid) {
+    std::string checksum;
+    if (!m_checksum.expected(filename, isBackupValid, checksum)) {
+        // TODO: Consider adding exceptions to streams and handling them:
+        // stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+        auto stream = std::make_shared<std::ifstream>(filename);
+        if (!stream->is_open()) {
+            throw FileNotFoundException(filename);
+        }
+        return stream;
+    }
 
-    if (!stream.is_open()) {
+    // Checksum is verified while the file is read, so it is read only once
+    auto stream = std::make_shared<ChecksumInputStream>(filename, checksum);
+    if (!stream->is_open()) {
         throw FileNotFoundException(filename);
     }
-
-    m_checksum.compare(stream, filename, isBackupValid);
+    return stream;
 }
 
 std::shared_ptr<BucketDeserializer> InMemoryStorageBackend::bucketStreamOpener(
         const PolicyBucketId &bucketId, const std::string &filenameSuffix, bool isBackupValid) {
     std::string bucketFilename = m_dbPath + PathConfig::StoragePath::bucketFilenamePrefix +
             bucketId + filenameSuffix;
-    auto bucketStream = std::make_shared<std::ifstream>();
     try {
-        openFileStream(*bucketStream, bucketFilename, isBackupValid);
-        return std::make_shared<BucketDeserializer>(bucketStream);
+        return std::make_shared<BucketDeserializer>(openFileStream(bucketFilename, isBackupValid));
     } catch (const FileNotFoundException &) {
         return nullptr;
     } catch (const std::bad_alloc &) {
@@ -272,8 +551,11 @@ std::shared_ptr<StorageSerializer<ChecksumStream> > InMemoryStorageBackend::buck
     std::string bucketFilename = m_dbPath + PathConfig::StoragePath::bucketFilenamePrefix +
                                  bucketId + PathConfig::StoragePath::backupFilenameSuffix;
     auto bucketStream = std::make_shared<ChecksumStream>(
-            PathConfig::StoragePath::bucketFilenamePrefix + bucketId, chsStream);
+            PathConfig::StoragePath::bucketFilenamePrefix + bucketId, chsStream,
+            m_checksumAlgorithm);
 
+    // Backup left by failed save may still be linked to primary file, which must stay intact
+    m_integrity.deleteBackupBucket(bucketId);
     openDumpFileStream<ChecksumStream>(*bucketStream, bucketFilename);
     return std::make_shared<StorageSerializer<ChecksumStream> >(bucketStream);
 }
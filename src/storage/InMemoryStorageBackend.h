@@ -24,6 +24,7 @@
 #define SRC_STORAGE_INMEMORYSTORAGEBACKEND_H_
 
 #include <fstream>
+#include <map>
 #include <memory>
 #include <string>
 
@@ -32,13 +33,17 @@
 #include <types/PolicyBucket.h>
 #include <types/PolicyBucketId.h>
 #include <types/PolicyKey.h>
+#include <types/PolicyKeyVariants.h>
+#include <types/PolicyMatches.h>
 #include <types/PolicyResult.h>
 
 #include <storage/BucketDeserializer.h>
 #include <storage/Buckets.h>
 #include <storage/ChecksumStream.h>
 #include <storage/ChecksumValidator.h>
+#include <storage/DatabaseImage.h>
 #include <storage/Integrity.h>
+#include <storage/Journal.h>
 #include <storage/StorageBackend.h>
 #include <storage/StorageSerializer.h>
 
@@ -47,14 +52,27 @@ namespace Cynara {
 class InMemoryStorageBackend : public StorageBackend {
 public:
     InMemoryStorageBackend() = delete;
-    InMemoryStorageBackend(const std::string &path);
+    // With journal enabled, save() only appends changes to journal until it grows over the limit.
+    // With image enabled, every snapshot is also written as binary image for faster loading.
+    // Checks are answered from loaded image, until database is changed.
+    // Files are saved with checksums of given algorithm; any supported one is accepted on load.
+    InMemoryStorageBackend(const std::string &path, std::size_t journalSizeLimit = 0,
+                           bool imageEnabled = false,
+                           ChecksumValidator::Algorithm checksumAlgorithm =
+                               ChecksumValidator::Algorithm::MD5);
     virtual ~InMemoryStorageBackend() {};
 
     virtual void load(void);
     virtual void save(void);
+    virtual SaveTask prepareSave(void);
+    virtual void completeSave(bool succeeded);
 
     virtual PolicyBucket searchDefaultBucket(const PolicyKey &key);
     virtual PolicyBucket searchBucket(const PolicyBucketId &bucketId, const PolicyKey &key);
+    virtual void matchBucket(const PolicyBucketId &bucketId, const PolicyKeyVariants &variants,
+                             PolicyMatches &matches);
+    virtual bool check(const PolicyKey &key, const PolicyBucketId &startBucketId, bool recursive,
+                       PolicyResult &result);
     virtual void insertPolicy(const PolicyBucketId &bucketId, PolicyPtr policy);
     virtual void createBucket(const PolicyBucketId &bucketId, const PolicyResult &defaultPolicy);
     virtual void updateBucket(const PolicyBucketId &bucketId, const PolicyResult &defaultPolicy);
@@ -62,14 +80,36 @@ public:
     virtual bool hasBucket(const PolicyBucketId &bucketId);
     virtual void deletePolicy(const PolicyBucketId &bucketId, const PolicyKey &key);
     virtual void deleteLinking(const PolicyBucketId &bucketId);
+    virtual PolicyBucket::BucketIds getSubBuckets(const PolicyBucketId &bucketId) const;
+    virtual PolicyBucket::Policies listLinks(const PolicyBucketId &bucketId) const;
     virtual PolicyBucket::Policies listPolicies(const PolicyBucketId &bucketId,
                                                 const PolicyKey &filter) const;
     virtual void erasePolicies(const PolicyBucketId &bucketId, bool recursive,
                                const PolicyKey &filter);
 
 protected:
-    void dumpDatabase(const std::shared_ptr<std::ofstream> &chsStream);
-    void openFileStream(std::ifstream &stream, const std::string &filename, bool isBackupValid);
+    // Everything needed to write files of a save, taken when the save is prepared
+    struct SaveState {
+        SaveState(const ChecksumValidator &checksumValidator)
+            : snapshot(false), checksum(checksumValidator), truncate(false) {}
+
+        bool snapshot;
+        // Contents are shared with backend; unchanged buckets have none, unless image is made
+        Buckets buckets;
+        PolicyBucket::BucketIds changedBucketIds;
+        // Checksums of unchanged buckets; after writing, checksums of the saved snapshot
+        ChecksumValidator checksum;
+        std::string checksumRecords;
+        std::string snapshotChecksum;
+        std::string journalHeader;
+        // Journal records, if no snapshot is saved
+        std::string records;
+        bool truncate;
+    };
+
+    void dumpDatabase(const SaveState &state, const std::shared_ptr<std::ofstream> &chsStream);
+    std::shared_ptr<std::istream> openFileStream(const std::string &filename,
+                                                 bool isBackupValid);
     std::shared_ptr<BucketDeserializer> bucketStreamOpener(const PolicyBucketId &bucketId,
                                                            const std::string &fileNameSuffix,
                                                            bool isBackupValid);
@@ -80,19 +120,44 @@ protected:
             const PolicyBucketId &bucketId, const std::shared_ptr<std::ofstream> &chsStream);
 
     virtual void postLoadCleanup(bool isBackupValid);
-    void saveBackup(void);
+    // Write files only, using nothing but state and configuration of backend
+    void saveSnapshot(SaveState &state);
+    void saveBackup(SaveState &state);
+    // Policies of mapped image are loaded, when they are needed for anything but a check
+    void loadImage(void);
+
+    void markDirty(const PolicyBucketId &bucketId);
+    PolicyBucket::BucketIds changedBuckets(void);
+
+    void indexLinks(void);
+    // Accounts for link of policy (if any) inserted to or removed from given bucket
+    void updateLink(const PolicyBucketId &bucketId, const PolicyPtr &policy);
+    void removeLink(const PolicyBucketId &bucketId, const PolicyBucketId &linkedBucketId);
 
 private:
     std::string m_dbPath;
     Buckets m_buckets;
     ChecksumValidator m_checksum;
+    const ChecksumValidator::Algorithm m_checksumAlgorithm;
     Integrity m_integrity;
+    Journal m_journal;
+    DatabaseImage m_image;
+    bool m_imageEnabled;
+    // Buckets, which files differ from their contents, unless all of them do
+    PolicyBucket::BucketIds m_dirtyBuckets;
+    bool m_allBucketsDirty;
+    std::shared_ptr<SaveState> m_saveState;
+    // Buckets having policies linking to bucket, by bucket linked to
+    std::map<PolicyBucketId, PolicyBucket::BucketIds> m_linkingBuckets;
 
 protected:
     virtual Buckets &buckets(void) {
+        loadImage();
         return m_buckets;
     }
     virtual const Buckets &buckets(void) const {
+        // Loading image changes only representation of the same policies
+        const_cast<InMemoryStorageBackend *>(this)->loadImage();
         return m_buckets;
     }
 };
@@ -65,14 +65,17 @@ void Integrity::createBackupGuard(void) const {
 }
 
 void Integrity::syncDatabase(const Buckets &buckets, bool syncBackup) {
+    syncDatabase(bucketIds(buckets), syncBackup);
+}
+
+void Integrity::syncDatabase(const PolicyBucket::BucketIds &bucketIds, bool syncBackup) {
     std::string suffix = "";
 
     if (syncBackup) {
         suffix += StorageConfig::backupFilenameSuffix;
     }
 
-    for (const auto &bucketIter : buckets) {
-        const auto &bucketId = bucketIter.first;
+    for (const auto &bucketId : bucketIds) {
         const auto &bucketFilename = m_dbPath + StorageConfig::bucketFilenamePrefix +
                 bucketId + suffix;
 
@@ -85,8 +88,15 @@ void Integrity::syncDatabase(const Buckets &buckets, bool syncBackup) {
 }
 
 void Integrity::revalidatePrimaryDatabase(const Buckets &buckets) {
-    createPrimaryHardLinks(buckets);
-    syncDatabase(buckets, false);
+    revalidatePrimaryDatabase(buckets, bucketIds(buckets));
+}
+
+// Primary files of buckets not changed are the same files as their backups, so they are left
+// untouched
+void Integrity::revalidatePrimaryDatabase(const Buckets &buckets,
+                                          const PolicyBucket::BucketIds &changedBucketIds) {
+    createPrimaryHardLinks(changedBucketIds);
+    syncDatabase(changedBucketIds, false);
 
     deleteHardLink(m_dbPath + StorageConfig::guardFilename);
     syncDirectory(m_dbPath);
@@ -94,6 +104,34 @@ void Integrity::revalidatePrimaryDatabase(const Buckets &buckets) {
     deleteBackupHardLinks(buckets);
 }
 
+// Makes backup files of buckets not changed since last save, without copying their contents
+void Integrity::linkBackupBuckets(const PolicyBucket::BucketIds &bucketIds) {
+    for (const auto &bucketId : bucketIds) {
+        const auto &bucketFilename = m_dbPath + StorageConfig::bucketFilenamePrefix + bucketId;
+
+        deleteHardLink(bucketFilename + StorageConfig::backupFilenameSuffix);
+        createHardLink(bucketFilename, bucketFilename + StorageConfig::backupFilenameSuffix);
+    }
+}
+
+// Backup file may be a hard link to primary one, so it is never written in place
+void Integrity::deleteBackupBucket(const PolicyBucketId &bucketId) {
+    deleteHardLink(m_dbPath + StorageConfig::bucketFilenamePrefix + bucketId +
+                   StorageConfig::backupFilenameSuffix);
+}
+
+void Integrity::deleteBackupDatabase(const Buckets &buckets) {
+    deleteBackupHardLinks(buckets);
+}
+
+PolicyBucket::BucketIds Integrity::bucketIds(const Buckets &buckets) {
+    PolicyBucket::BucketIds ids;
+    for (const auto &bucketIter : buckets) {
+        ids.insert(bucketIter.first);
+    }
+    return ids;
+}
+
 void Integrity::deleteNonIndexedFiles(BucketPresenceTester tester) {
     DIR *dirPtr = nullptr;
     struct dirent *direntPtr;
@@ -116,7 +154,7 @@ void Integrity::deleteNonIndexedFiles(BucketPresenceTester tester) {
 
     while (errno = 0, (direntPtr = readdir(dirPtr)) != nullptr) {
         std::string filename = direntPtr->d_name;
-        //ignore all special files (working dir, parent dir, index, checksums)
+        //ignore all special files (working dir, parent dir, index, checksums, journal, image)
         if (isSpecialDirectory(filename) || isSpecialDatabaseEntry(filename)) {
             continue;
         }
@@ -192,9 +230,8 @@ void Integrity::syncDirectory(const std::string &dirname, mode_t mode) {
     syncElement(dirname, O_DIRECTORY, mode);
 }
 
-void Integrity::createPrimaryHardLinks(const Buckets &buckets) {
-    for (const auto &bucketIter : buckets) {
-        const auto &bucketId = bucketIter.first;
+void Integrity::createPrimaryHardLinks(const PolicyBucket::BucketIds &bucketIds) {
+    for (const auto &bucketId : bucketIds) {
         const auto &bucketFilename = m_dbPath + StorageConfig::bucketFilenamePrefix + bucketId;
 
         deleteHardLink(bucketFilename);
@@ -254,7 +291,9 @@ bool Integrity::isSpecialDirectory(const std::string &filename) {
 
 bool Integrity::isSpecialDatabaseEntry(const std::string &filename) {
     return PathConfig::StoragePath::indexFilename == filename ||
-           PathConfig::StoragePath::checksumFilename == filename;
+           PathConfig::StoragePath::checksumFilename == filename ||
+           PathConfig::StoragePath::journalFilename == filename ||
+           PathConfig::StoragePath::imageFilename == filename;
 }
 
 } /* namespace Cynara */
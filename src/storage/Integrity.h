@@ -41,15 +41,23 @@ public:
     virtual bool backupGuardExists(void) const;
     virtual void createBackupGuard(void) const;
     virtual void syncDatabase(const Buckets &buckets, bool syncBackup);
+    virtual void syncDatabase(const PolicyBucket::BucketIds &bucketIds, bool syncBackup);
     virtual void revalidatePrimaryDatabase(const Buckets &buckets);
+    virtual void revalidatePrimaryDatabase(const Buckets &buckets,
+                                           const PolicyBucket::BucketIds &changedBucketIds);
+    virtual void linkBackupBuckets(const PolicyBucket::BucketIds &bucketIds);
+    virtual void deleteBackupBucket(const PolicyBucketId &bucketId);
+    virtual void deleteBackupDatabase(const Buckets &buckets);
     virtual void deleteNonIndexedFiles(BucketPresenceTester tester);
 
+    static PolicyBucket::BucketIds bucketIds(const Buckets &buckets);
+
 protected:
     static void syncElement(const std::string &filename, int flags = O_RDONLY,
                             mode_t mode = S_IRUSR | S_IWUSR);
     static void syncDirectory(const std::string &dirname, mode_t mode = S_IRUSR | S_IWUSR);
 
-    void createPrimaryHardLinks(const Buckets &buckets);
+    void createPrimaryHardLinks(const PolicyBucket::BucketIds &bucketIds);
     void deleteBackupHardLinks(const Buckets &buckets);
 
     static void createHardLink(const std::string &oldName, const std::string &newName);
@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/storage/Journal.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Implementation of Cynara::Journal
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <sstream>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <config/PathConfig.h>
+#include <exceptions/BucketRecordCorruptedException.h>
+#include <exceptions/ChecksumRecordCorruptedException.h>
+#include <exceptions/Exception.h>
+#include <exceptions/UnexpectedErrorException.h>
+#include <log/log.h>
+#include <types/Policy.h>
+
+#include <storage/ChecksumValidator.h>
+
+#include "Journal.h"
+
+namespace Cynara {
+
+namespace {
+
+// Record types
+const std::string snapshotRecord("S");
+const std::string insertPolicyRecord("I");
+const std::string deletePolicyRecord("D");
+const std::string setBucketRecord("B");
+const std::string deleteBucketRecord("R");
+const std::string deleteLinkingRecord("L");
+const std::string erasePoliciesRecord("E");
+
+} // namespace
+
+Journal::Journal(const std::string &path, std::size_t sizeLimit) : m_dbPath(path),
+    m_filename(path + PathConfig::StoragePath::journalFilename), m_size(0),
+    m_sizeLimit(sizeLimit), m_replaying(false) {
+}
+
+void Journal::insertPolicy(const PolicyBucketId &bucketId, const PolicyPtr &policy) {
+    const auto &key = policy->key();
+    const auto &result = policy->result();
+    record({ insertPolicyRecord, bucketId, key.client().toString(), key.user().toString(),
+             key.privilege().toString(), dumpPolicyType(result.policyType()),
+             result.metadata() });
+}
+
+void Journal::deletePolicy(const PolicyBucketId &bucketId, const PolicyKey &key) {
+    record({ deletePolicyRecord, bucketId, key.client().toString(), key.user().toString(),
+             key.privilege().toString() });
+}
+
+void Journal::setBucket(const PolicyBucketId &bucketId, const PolicyResult &defaultPolicy) {
+    record({ setBucketRecord, bucketId, dumpPolicyType(defaultPolicy.policyType()),
+             defaultPolicy.metadata() });
+}
+
+void Journal::deleteBucket(const PolicyBucketId &bucketId) {
+    record({ deleteBucketRecord, bucketId });
+}
+
+void Journal::deleteLinking(const PolicyBucketId &bucketId) {
+    record({ deleteLinkingRecord, bucketId });
+}
+
+void Journal::erasePolicies(const PolicyBucketId &bucketId, bool recursive,
+                            const PolicyKey &filter) {
+    record({ erasePoliciesRecord, bucketId, recursive ? "1" : "0", filter.client().toString(),
+             filter.user().toString(), filter.privilege().toString() });
+}
+
+bool Journal::prepareCommit(std::string &records, bool &truncate) {
+    if (m_pending.empty()) {
+        return false;
+    }
+
+    records.clear();
+    // File still belongs to an older snapshot (if any)
+    truncate = (m_size == 0);
+    if (truncate) {
+        records = header(m_snapshotChecksum);
+    }
+    records += m_pending;
+    m_pending.clear();
+    m_size += records.size();
+    return true;
+}
+
+void Journal::append(const std::string &records, bool truncate) const {
+    write(records, truncate ? O_TRUNC : O_APPEND);
+}
+
+std::string Journal::header(const std::string &snapshotChecksum) const {
+    return format({ snapshotRecord, snapshotChecksum });
+}
+
+void Journal::started(const std::string &snapshotChecksum, std::size_t headerSize) {
+    m_snapshotChecksum = snapshotChecksum;
+    m_size = headerSize;
+}
+
+void Journal::removeFile(void) const {
+    if (unlink(m_filename.c_str()) < 0) {
+        int err = errno;
+        if (err != ENOENT) {
+            LOGE("'unlink' function error [%d] : <%s>", err, strerror(err));
+            throw UnexpectedErrorException(err, strerror(err));
+        }
+    }
+}
+
+std::size_t Journal::replay(const std::string &snapshotChecksum, StorageBackend &backend) {
+    m_snapshotChecksum = snapshotChecksum;
+    m_pending.clear();
+    m_size = 0;
+
+    std::ifstream stream(m_filename);
+    if (!stream.is_open()) {
+        return 0;
+    }
+
+    std::size_t replayed = 0;
+    std::size_t validSize = 0;
+    std::string line;
+    m_replaying = true;
+    while (std::getline(stream, line, PathConfig::StoragePath::recordSeparator)) {
+        // Record not terminated with separator was torn by a crash
+        if (stream.eof()) {
+            LOGW("Journal ends with incomplete record");
+            break;
+        }
+
+        try {
+            auto fields = splitFields(line, 2);
+            if (fields.size() != 2 || ChecksumValidator::generate(fields[1]) != fields[0]) {
+                throw ChecksumRecordCorruptedException(line);
+            }
+
+            if (validSize == 0) {
+                auto header = splitFields(fields[1], 2);
+                if (header.size() != 2 || header[0] != snapshotRecord
+                    || header[1] != snapshotChecksum) {
+                    LOGN("Journal does not apply to loaded database, ignoring it");
+                    break;
+                }
+            } else {
+                apply(fields[1], backend);
+                ++replayed;
+            }
+        } catch (const Exception &ex) {
+            LOGE("Journal replay stopped at corrupted record: <%s>", ex.what());
+            break;
+        }
+        validSize += line.size() + 1;
+    }
+    m_replaying = false;
+    stream.close();
+
+    if (validSize > 0) {
+        truncate(validSize);
+    }
+    m_size = validSize;
+
+    LOGI("Replayed %zu journal records", replayed);
+    return replayed;
+}
+
+void Journal::record(const std::vector<std::string> &fields) {
+    if (m_replaying || !enabled()) {
+        return;
+    }
+
+    m_pending += format(fields);
+}
+
+std::string Journal::format(const std::vector<std::string> &fields) const {
+    std::string contents;
+    for (const auto &field : fields) {
+        if (!contents.empty()) {
+            contents += PathConfig::StoragePath::fieldSeparator;
+        }
+        contents += field;
+    }
+
+    std::string line = ChecksumValidator::generate(contents);
+    line += PathConfig::StoragePath::fieldSeparator;
+    line += contents;
+    line += PathConfig::StoragePath::recordSeparator;
+    return line;
+}
+
+void Journal::apply(const std::string &line, StorageBackend &backend) {
+    auto recordType = splitFields(line, 2).front();
+
+    if (recordType == insertPolicyRecord) {
+        auto fields = splitFields(line, 7);
+        if (fields.size() == 7) {
+            backend.insertPolicy(fields[1], std::make_shared<Policy>(
+                                 PolicyKey(fields[2], fields[3], fields[4]),
+                                 PolicyResult(parsePolicyType(fields[5]), fields[6])));
+            return;
+        }
+    } else if (recordType == deletePolicyRecord) {
+        auto fields = splitFields(line, 5);
+        if (fields.size() == 5) {
+            backend.deletePolicy(fields[1], PolicyKey(fields[2], fields[3], fields[4]));
+            return;
+        }
+    } else if (recordType == setBucketRecord) {
+        auto fields = splitFields(line, 4);
+        if (fields.size() == 4) {
+            PolicyResult defaultPolicy(parsePolicyType(fields[2]), fields[3]);
+            if (backend.hasBucket(fields[1])) {
+                backend.updateBucket(fields[1], defaultPolicy);
+            } else {
+                backend.createBucket(fields[1], defaultPolicy);
+            }
+            return;
+        }
+    } else if (recordType == deleteBucketRecord) {
+        auto fields = splitFields(line, 2);
+        if (fields.size() == 2) {
+            backend.deleteBucket(fields[1]);
+            return;
+        }
+    } else if (recordType == deleteLinkingRecord) {
+        auto fields = splitFields(line, 2);
+        if (fields.size() == 2) {
+            backend.deleteLinking(fields[1]);
+            return;
+        }
+    } else if (recordType == erasePoliciesRecord) {
+        auto fields = splitFields(line, 6);
+        if (fields.size() == 6) {
+            backend.erasePolicies(fields[1], fields[2] == "1",
+                                  PolicyKey(fields[3], fields[4], fields[5]));
+            return;
+        }
+    }
+
+    throw BucketRecordCorruptedException(line);
+}
+
+// Splits line into at most count fields; the last one takes the rest of the line
+std::vector<std::string> Journal::splitFields(const std::string &line, std::size_t count) {
+    std::vector<std::string> fields;
+    std::size_t beginToken = 0;
+
+    while (fields.size() + 1 < count) {
+        auto endToken = line.find(PathConfig::StoragePath::fieldSeparator, beginToken);
+        if (endToken == std::string::npos) {
+            break;
+        }
+        fields.push_back(line.substr(beginToken, endToken - beginToken));
+        beginToken = endToken + 1;
+    }
+    fields.push_back(line.substr(beginToken));
+
+    return fields;
+}
+
+std::string Journal::dumpPolicyType(const PolicyType &policyType) {
+    std::stringstream stream;
+    stream << "0x" << std::uppercase << std::hex << policyType;
+    return stream.str();
+}
+
+PolicyType Journal::parsePolicyType(const std::string &field) {
+    try {
+        return static_cast<PolicyType>(std::stoi(field, nullptr, 16));
+    } catch (...) {
+        throw BucketRecordCorruptedException(field);
+    }
+}
+
+void Journal::write(const std::string &data, int flags) const {
+    int fd = TEMP_FAILURE_RETRY(open(m_filename.c_str(), O_WRONLY | O_CREAT | flags,
+                                     S_IRUSR | S_IWUSR));
+    if (fd < 0) {
+        int err = errno;
+        LOGE("'open' function error [%d] : <%s>", err, strerror(err));
+        throw UnexpectedErrorException(err, strerror(err));
+    }
+
+    std::size_t written = 0;
+    while (written < data.size()) {
+        auto ret = TEMP_FAILURE_RETRY(::write(fd, data.data() + written, data.size() - written));
+        if (ret < 0) {
+            int err = errno;
+            close(fd);
+            LOGE("'write' function error [%d] : <%s>", err, strerror(err));
+            throw UnexpectedErrorException(err, strerror(err));
+        }
+        written += static_cast<std::size_t>(ret);
+    }
+
+    int ret = fdatasync(fd);
+    int err = errno;
+    close(fd);
+    if (ret < 0) {
+        LOGE("'fdatasync' function error [%d] : <%s>", err, strerror(err));
+        throw UnexpectedErrorException(err, strerror(err));
+    }
+
+    if (flags & O_TRUNC) {
+        // File may have been created, so its directory entry has to be durable too
+        int dirFd = TEMP_FAILURE_RETRY(open(m_dbPath.c_str(), O_RDONLY | O_DIRECTORY));
+        if (dirFd >= 0) {
+            fsync(dirFd);
+            close(dirFd);
+        }
+    }
+}
+
+void Journal::truncate(std::size_t size) const {
+    if (::truncate(m_filename.c_str(), static_cast<off_t>(size)) < 0) {
+        int err = errno;
+        LOGE("'truncate' function error [%d] : <%s>", err, strerror(err));
+        throw UnexpectedErrorException(err, strerror(err));
+    }
+}
+
+} /* namespace Cynara */
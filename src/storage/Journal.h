@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        src/storage/Journal.h
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Headers for Cynara::Journal
+ */
+
+#ifndef SRC_STORAGE_JOURNAL_H_
+#define SRC_STORAGE_JOURNAL_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <types/pointers.h>
+#include <types/PolicyBucketId.h>
+#include <types/PolicyKey.h>
+#include <types/PolicyResult.h>
+
+#include <storage/StorageBackend.h>
+
+namespace Cynara {
+
+/*
+ * Append-only log of storage mutations made since the last database snapshot.
+ * First record names the snapshot (by digest of its checksum records), which the journal applies
+ * to. Journal of any other snapshot is stale and is never replayed. Every record carries
+ * checksum of its own contents, so replay stops at a record torn by a crash.
+ */
+class Journal {
+public:
+    static const std::size_t DEFAULT_SIZE_LIMIT = 1024 * 1024;
+
+    // Journal with size limit of 0 is disabled and does not record anything
+    Journal(const std::string &path, std::size_t sizeLimit);
+    virtual ~Journal() {};
+
+    bool enabled(void) const {
+        return m_sizeLimit > 0;
+    }
+
+    // Full journal should be compacted into a new snapshot
+    bool full(void) const {
+        return m_size >= m_sizeLimit;
+    }
+
+    void insertPolicy(const PolicyBucketId &bucketId, const PolicyPtr &policy);
+    void deletePolicy(const PolicyBucketId &bucketId, const PolicyKey &key);
+    void setBucket(const PolicyBucketId &bucketId, const PolicyResult &defaultPolicy);
+    void deleteBucket(const PolicyBucketId &bucketId);
+    void deleteLinking(const PolicyBucketId &bucketId);
+    void erasePolicies(const PolicyBucketId &bucketId, bool recursive, const PolicyKey &filter);
+
+    bool hasPending(void) const {
+        return !m_pending.empty();
+    }
+
+    std::size_t size(void) const {
+        return m_size;
+    }
+
+    /*
+     * Saving is split, so files can be written in another thread: prepareCommit() takes pending
+     * records (preceded by header, if file still belongs to an older snapshot) and append()
+     * writes them with a single fdatasync. append(), header() and removeFile() use no state
+     * changed by records.
+     */
+    bool prepareCommit(std::string &records, bool &truncate);
+    void append(const std::string &records, bool truncate) const;
+    // Records already included in a snapshot being saved are not committed
+    void discardPending(void) {
+        m_pending.clear();
+    }
+    // Journal of a new snapshot starts with header written with append(..., true)
+    std::string header(const std::string &snapshotChecksum) const;
+    void started(const std::string &snapshotChecksum, std::size_t headerSize);
+    void removeFile(void) const;
+    // Applies records following given snapshot; returns number of replayed records
+    std::size_t replay(const std::string &snapshotChecksum, StorageBackend &backend);
+
+protected:
+    void record(const std::vector<std::string> &fields);
+    std::string format(const std::vector<std::string> &fields) const;
+    void apply(const std::string &line, StorageBackend &backend);
+
+    static std::vector<std::string> splitFields(const std::string &line, std::size_t count);
+    static std::string dumpPolicyType(const PolicyType &policyType);
+    static PolicyType parsePolicyType(const std::string &field);
+
+    void write(const std::string &data, int flags) const;
+    void truncate(std::size_t size) const;
+
+private:
+    const std::string m_dbPath;
+    const std::string m_filename;
+    std::string m_snapshotChecksum;
+    std::string m_pending;
+    std::size_t m_size;
+    const std::size_t m_sizeLimit;
+    bool m_replaying;
+};
+
+} /* namespace Cynara */
+
+#endif /* SRC_STORAGE_JOURNAL_H_ */
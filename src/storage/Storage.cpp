@@ -22,8 +22,11 @@
  */
 
 #include <memory>
+#include <set>
+#include <unordered_set>
 #include <vector>
 
+#include <exceptions/BucketLinkCycleException.h>
 #include <exceptions/BucketNotExistsException.h>
 #include <exceptions/DefaultBucketDeletionException.h>
 #include <exceptions/DefaultBucketSetNoneException.h>
@@ -32,6 +35,10 @@
 #include <types/PolicyBucket.h>
 #include <types/PolicyBucketId.h>
 #include <types/PolicyCollection.h>
+#include <types/PolicyKeyHelpers.h>
+#include <types/PolicyKeyVariants.h>
+#include <types/PolicyMapKey.h>
+#include <types/PolicyMatches.h>
 #include <types/PolicyResult.h>
 #include <types/PolicyType.h>
 
@@ -42,14 +49,23 @@ namespace Cynara {
 PolicyResult Storage::checkPolicy(const PolicyKey &key,
                                   const PolicyBucketId &startBucketId /*= defaultPolicyBucketId*/,
                                   bool recursive /*= true*/) {
-    auto policies = m_backend.searchBucket(startBucketId, key);
-    return minimalPolicy(policies, key, recursive);
+    PolicyResult result;
+    if (m_backend.check(key, startBucketId, recursive, result)) {
+        return result;
+    }
+
+    const PolicyKeyVariants variants(key);
+    PolicyMatches matches;
+    m_evaluatedBuckets.clear();
+    m_evaluatedBuckets.push_back({ &startBucketId, PredefinedPolicyType::NONE, false });
+    m_backend.matchBucket(startBucketId, variants, matches);
+    return minimalPolicy(matches, variants, recursive);
 };
 
-PolicyResult Storage::minimalPolicy(const PolicyBucket &bucket, const PolicyKey &key,
-                                    bool recursive) {
+PolicyResult Storage::minimalPolicy(const PolicyMatches &matches,
+                                    const PolicyKeyVariants &variants, bool recursive) {
     bool hasMinimal = false;
-    PolicyResult minimal = bucket.defaultPolicy();
+    PolicyResult minimal = matches.defaultPolicy();
 
     auto proposeMinimal = [&minimal, &hasMinimal](const PolicyResult &candidate) {
         if (hasMinimal == false) {
@@ -60,7 +76,7 @@ PolicyResult Storage::minimalPolicy(const PolicyBucket &bucket, const PolicyKey
         hasMinimal = true;
     };
 
-    for (const auto policy : bucket) {
+    for (const auto policy : matches) {
         const auto &policyResult = policy->result();
 
         switch (policyResult.policyType()) {
@@ -68,8 +84,8 @@ PolicyResult Storage::minimalPolicy(const PolicyBucket &bucket, const PolicyKey
                 return policyResult; // Do not expect lower value than DENY
             case PredefinedPolicyType::BUCKET: {
                     if (recursive == true) {
-                        auto bucketResults = m_backend.searchBucket(policyResult.metadata(), key);
-                        auto minimumOfBucket = minimalPolicy(bucketResults, key, true);
+                        auto minimumOfBucket = bucketMinimalPolicy(policyResult.metadata(),
+                                                                   variants);
                         if (minimumOfBucket != PredefinedPolicyType::NONE) {
                             proposeMinimal(minimumOfBucket);
                         }
@@ -87,7 +103,35 @@ PolicyResult Storage::minimalPolicy(const PolicyBucket &bucket, const PolicyKey
     return minimal;
 }
 
+PolicyResult Storage::bucketMinimalPolicy(const PolicyBucketId &bucketId,
+                                          const PolicyKeyVariants &variants) {
+    // Bucket linked from many places is evaluated only once per check
+    for (const auto &evaluated : m_evaluatedBuckets) {
+        if (*evaluated.bucketId == bucketId) {
+            // Bucket not done yet links to itself - possible only in database loaded from disk
+            return evaluated.done ? evaluated.result : PredefinedPolicyType::NONE;
+        }
+    }
+
+    // Vector may grow during recursion, so entry is remembered by index
+    const auto index = m_evaluatedBuckets.size();
+    m_evaluatedBuckets.push_back({ &bucketId, PredefinedPolicyType::NONE, false });
+
+    PolicyMatches bucketMatches;
+    m_backend.matchBucket(bucketId, variants, bucketMatches);
+    auto minimumOfBucket = minimalPolicy(bucketMatches, variants, true);
+
+    m_evaluatedBuckets[index].result = minimumOfBucket;
+    m_evaluatedBuckets[index].done = true;
+    return minimumOfBucket;
+}
+
 void Storage::insertPolicies(const std::map<PolicyBucketId, std::vector<Policy>> &policiesByBucketId) {
+    setPolicies(policiesByBucketId, {});
+}
+
+void Storage::setPolicies(const std::map<PolicyBucketId, std::vector<Policy>> &policiesByBucketId,
+                          const std::map<PolicyBucketId, std::vector<PolicyKey>> &keysByBucketId) {
 
     auto pointedBucketExists = [this] (const Policy &policy) -> void {
         if (policy.result().policyType() == PredefinedPolicyType::BUCKET) {
@@ -111,6 +155,8 @@ void Storage::insertPolicies(const std::map<PolicyBucketId, std::vector<Policy>>
         std::for_each(policies.cbegin(), policies.cend(), pointedBucketExists);
     }
 
+    checkLinksAcyclic(policiesByBucketId, keysByBucketId);
+
     // Then insert policies
     for (const auto &group : policiesByBucketId) {
         const PolicyBucketId &bucketId = group.first;
@@ -119,6 +165,96 @@ void Storage::insertPolicies(const std::map<PolicyBucketId, std::vector<Policy>>
             m_backend.insertPolicy(bucketId, std::make_shared<Policy>(policy));
         }
     }
+
+    deletePolicies(keysByBucketId);
+}
+
+void Storage::checkLinksAcyclic(
+        const std::map<PolicyBucketId, std::vector<Policy>> &policiesByBucketId,
+        const std::map<PolicyBucketId, std::vector<PolicyKey>> &keysByBucketId) {
+
+    typedef std::unordered_set<PolicyMapKey, PolicyMapKeyHash> MapKeys;
+
+    std::map<PolicyBucketId, MapKeys> removedKeys;
+    for (const auto &group : keysByBucketId) {
+        auto &keys = removedKeys[group.first];
+        for (const auto &key : group.second) {
+            keys.insert(PolicyKeyHelpers::mapKey(key));
+        }
+    }
+
+    // Links of buckets touched by request, as they will be after it
+    std::map<PolicyBucketId, PolicyBucket::BucketIds> touchedLinks;
+    std::map<PolicyBucketId, PolicyBucket::BucketIds> newLinks;
+    for (const auto &group : policiesByBucketId) {
+        const auto &bucketId = group.first;
+        const auto removedIter = removedKeys.find(bucketId);
+        MapKeys replacedKeys;
+        if (removedIter != removedKeys.end()) {
+            replacedKeys = removedIter->second;
+        }
+
+        for (const auto &policy : group.second) {
+            const auto mapKey = PolicyKeyHelpers::mapKey(policy.key());
+            const bool removed = removedIter != removedKeys.end()
+                                 && removedIter->second.count(mapKey) > 0;
+            replacedKeys.insert(mapKey);
+            if (!removed && policy.result().policyType() == PredefinedPolicyType::BUCKET) {
+                newLinks[bucketId].insert(policy.result().metadata());
+            }
+        }
+
+        auto &links = touchedLinks[bucketId];
+        for (const auto &link : m_backend.listLinks(bucketId)) {
+            if (replacedKeys.count(PolicyKeyHelpers::mapKey(link.key())) == 0) {
+                links.insert(link.result().metadata());
+            }
+        }
+        const auto newIter = newLinks.find(bucketId);
+        if (newIter != newLinks.end()) {
+            links.insert(newIter->second.begin(), newIter->second.end());
+        }
+    }
+
+    auto subBuckets = [this, &touchedLinks, &removedKeys] (const PolicyBucketId &bucketId) {
+        const auto touchedIter = touchedLinks.find(bucketId);
+        if (touchedIter != touchedLinks.end()) {
+            return touchedIter->second;
+        }
+
+        const auto removedIter = removedKeys.find(bucketId);
+        if (removedIter == removedKeys.end()) {
+            return m_backend.getSubBuckets(bucketId);
+        }
+
+        PolicyBucket::BucketIds bucketIds;
+        for (const auto &link : m_backend.listLinks(bucketId)) {
+            if (removedIter->second.count(PolicyKeyHelpers::mapKey(link.key())) == 0) {
+                bucketIds.insert(link.result().metadata());
+            }
+        }
+        return bucketIds;
+    };
+
+    // Every new cycle goes through a new link, so look for a way back to bucket linking out
+    for (const auto &links : newLinks) {
+        const auto &linkingBucketId = links.first;
+        std::set<PolicyBucketId> visited;
+        std::vector<PolicyBucketId> toVisit(links.second.begin(), links.second.end());
+
+        while (!toVisit.empty()) {
+            const auto bucketId = toVisit.back();
+            toVisit.pop_back();
+
+            if (bucketId == linkingBucketId) {
+                throw BucketLinkCycleException(linkingBucketId);
+            }
+            if (visited.insert(bucketId).second) {
+                const auto bucketIds = subBuckets(bucketId);
+                toVisit.insert(toVisit.end(), bucketIds.begin(), bucketIds.end());
+            }
+        }
+    }
 }
 
 void Storage::addOrUpdateBucket(const PolicyBucketId &bucketId,
@@ -172,4 +308,12 @@ void Storage::save(void) {
     m_backend.save();
 }
 
+StorageBackend::SaveTask Storage::prepareSave(void) {
+    return m_backend.prepareSave();
+}
+
+void Storage::completeSave(bool succeeded) {
+    m_backend.completeSave(succeeded);
+}
+
 } // namespace Cynara
@@ -32,6 +32,8 @@
 #include <types/PolicyBucket.h>
 #include <types/PolicyBucketId.h>
 #include <types/PolicyKey.h>
+#include <types/PolicyKeyVariants.h>
+#include <types/PolicyMatches.h>
 #include <types/PolicyResult.h>
 
 #include <storage/StorageBackend.h>
@@ -49,6 +51,9 @@ public:
 
     void insertPolicies(const std::map<PolicyBucketId, std::vector<Policy>> &policiesByBucketId);
     void deletePolicies(const std::map<PolicyBucketId, std::vector<PolicyKey>> &keysByBucketId);
+    // Inserts, then deletes; links are checked against the state after both
+    void setPolicies(const std::map<PolicyBucketId, std::vector<Policy>> &policiesByBucketId,
+                     const std::map<PolicyBucketId, std::vector<PolicyKey>> &keysByBucketId);
 
     void addOrUpdateBucket(const PolicyBucketId &bucketId, const PolicyResult &defaultBucketPolicy);
     void deleteBucket(const PolicyBucketId &bucketId);
@@ -60,12 +65,28 @@ public:
 
     void load(void);
     void save(void);
+    StorageBackend::SaveTask prepareSave(void);
+    void completeSave(bool succeeded);
 
 protected:
-    PolicyResult minimalPolicy(const PolicyBucket &bucket, const PolicyKey &key, bool recursive);
+    PolicyResult minimalPolicy(const PolicyMatches &matches, const PolicyKeyVariants &variants,
+                               bool recursive);
+    PolicyResult bucketMinimalPolicy(const PolicyBucketId &bucketId,
+                                     const PolicyKeyVariants &variants);
+    void checkLinksAcyclic(
+            const std::map<PolicyBucketId, std::vector<Policy>> &policiesByBucketId,
+            const std::map<PolicyBucketId, std::vector<PolicyKey>> &keysByBucketId);
 
 private:
+    // Bucket visited during current check, done when its result is known
+    struct EvaluatedBucket {
+        const PolicyBucketId *bucketId;
+        PolicyResult result;
+        bool done;
+    };
+
     StorageBackend &m_backend; // backend strategy
+    std::vector<EvaluatedBucket> m_evaluatedBuckets; // reused by every check
 };
 
 } // namespace Cynara
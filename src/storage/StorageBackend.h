@@ -23,11 +23,15 @@
 #ifndef SRC_STORAGE_STORAGEBACKEND_H_
 #define SRC_STORAGE_STORAGEBACKEND_H_
 
+#include <functional>
 #include <string>
 
+#include <attributes/attributes.h>
 #include <types/pointers.h>
 #include <types/PolicyBucket.h>
 #include <types/PolicyKey.h>
+#include <types/PolicyKeyVariants.h>
+#include <types/PolicyMatches.h>
 #include <types/PolicyBucketId.h>
 #include <types/PolicyResult.h>
 
@@ -40,6 +44,13 @@ public:
     // TODO: Remove searchDefaultBucket()
     virtual PolicyBucket searchDefaultBucket(const PolicyKey &key) = 0;
     virtual PolicyBucket searchBucket(const PolicyBucketId &bucket, const PolicyKey &key) = 0;
+    virtual void matchBucket(const PolicyBucketId &bucket, const PolicyKeyVariants &variants,
+                             PolicyMatches &matches) = 0;
+    // Backend may answer whole check on its own, e.g. from a mapped image; false if it cannot
+    virtual bool check(const PolicyKey &key UNUSED, const PolicyBucketId &startBucketId UNUSED,
+                       bool recursive UNUSED, PolicyResult &result UNUSED) {
+        return false;
+    }
 
     virtual void insertPolicy(const PolicyBucketId &bucket, PolicyPtr policy) = 0;
 
@@ -52,12 +63,27 @@ public:
 
     virtual void deletePolicy(const PolicyBucketId &bucketId, const PolicyKey &key) = 0;
     virtual void deleteLinking(const PolicyBucketId &bucket) = 0;
+    virtual PolicyBucket::BucketIds getSubBuckets(const PolicyBucketId &bucketId) const = 0;
+    virtual PolicyBucket::Policies listLinks(const PolicyBucketId &bucketId) const = 0;
     virtual PolicyBucket::Policies listPolicies(const PolicyBucketId &bucketId,
                                                 const PolicyKey &filter) const = 0;
     virtual void erasePolicies(const PolicyBucketId &bucketId, bool recursive,
                                const PolicyKey &filter) = 0;
     virtual void load(void) = 0;
     virtual void save(void) = 0;
+
+    /*
+     * Split save: prepareSave() takes everything to be saved, so the returned task can be run
+     * in another thread while backend is changed further. Result of the task is passed
+     * to completeSave(). Backends, which cannot save in background, save in prepareSave().
+     */
+    typedef std::function<void(void)> SaveTask;
+
+    virtual SaveTask prepareSave(void) {
+        save();
+        return SaveTask();
+    }
+    virtual void completeSave(bool succeeded UNUSED) {}
 };
 
 } /* namespace Cynara */
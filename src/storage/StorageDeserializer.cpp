@@ -20,13 +20,22 @@
  * @brief       Implementation for Cynara::StorageDeserializer
  */
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <ios>
 #include <istream>
+#include <limits>
 #include <memory>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 #include <config/PathConfig.h>
 #include <exceptions/BucketDeserializationException.h>
 #include <exceptions/BucketRecordCorruptedException.h>
+#include <log/log.h>
 #include <types/PolicyType.h>
 
 #include <storage/BucketDeserializer.h>
@@ -37,8 +46,10 @@
 namespace Cynara {
 
 StorageDeserializer::StorageDeserializer(std::shared_ptr<std::istream> inStream,
-                                         BucketStreamOpener bucketStreamOpener)
-        : m_inStream(inStream), m_bucketStreamOpener(bucketStreamOpener) {
+                                         BucketStreamOpener bucketStreamOpener,
+                                         std::size_t loadThreads)
+        : m_inStream(inStream), m_bucketStreamOpener(bucketStreamOpener),
+          m_loadThreads(loadThreads) {
 }
 
 void StorageDeserializer::initBuckets(Buckets &buckets) {
@@ -59,23 +70,82 @@ void StorageDeserializer::initBuckets(Buckets &buckets) {
         buckets.insert({ bucketId, PolicyBucket(bucketId, PolicyResult(policyType, metadata)) });
         ++lineNum;
     }
+    // Rest of stream is consumed, so stream verifying its checksum sees whole contents
+    m_inStream->ignore(std::numeric_limits<std::streamsize>::max());
 }
 
+/*
+ * Bucket files are independent, so they are opened, verified and parsed by several threads,
+ * each thread filling whole buckets taken in turn. Errors are reported as by loading buckets
+ * one by one: exception of the first failed bucket (in order of buckets) is thrown.
+ */
 void StorageDeserializer::loadBuckets(Buckets &buckets) {
+    std::vector<Buckets::value_type *> toLoad;
+    toLoad.reserve(buckets.size());
     for (auto &bucketIter : buckets) {
-        const auto &bucketId = bucketIter.first;
-        auto &bucket = bucketIter.second;
-
-        auto bucketDeserializer = m_bucketStreamOpener(bucketId);
-        if (bucketDeserializer != nullptr) {
-            const auto policies = bucketDeserializer->loadPolicies();
-            for (const auto policy : policies) {
-                bucket.insertPolicy(policy);
+        toLoad.push_back(&bucketIter);
+    }
+
+    std::vector<std::exception_ptr> errors(toLoad.size());
+    std::atomic<std::size_t> next(0);
+    std::atomic<std::size_t> firstFailed(toLoad.size());
+
+    auto worker = [this, &toLoad, &errors, &next, &firstFailed] () {
+        for (std::size_t i = next++; i < toLoad.size(); i = next++) {
+            // Buckets after failed one are not needed, the ones before are still loaded
+            if (i > firstFailed) {
+                continue;
             }
-        } else {
-            throw BucketDeserializationException(bucketId);
+
+            try {
+                loadBucket(toLoad[i]->first, toLoad[i]->second);
+            } catch (...) {
+                errors[i] = std::current_exception();
+                std::size_t failed = firstFailed;
+                while (i < failed && !firstFailed.compare_exchange_weak(failed, i)) {}
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    const auto count = threadsCount(toLoad.size());
+    for (std::size_t i = 1; i < count; ++i) {
+        try {
+            threads.emplace_back(worker);
+        } catch (const std::system_error &ex) {
+            // Fewer threads only make loading slower
+            LOGW("Could not start database loading thread: <%s>", ex.what());
+            break;
         }
     }
+
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (const auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+void StorageDeserializer::loadBucket(const PolicyBucketId &bucketId, PolicyBucket &bucket) {
+    auto bucketDeserializer = m_bucketStreamOpener(bucketId);
+    if (bucketDeserializer == nullptr) {
+        throw BucketDeserializationException(bucketId);
+    }
+
+    const auto policies = bucketDeserializer->loadPolicies();
+    for (const auto &policy : policies) {
+        bucket.insertPolicy(policy);
+    }
+}
+
+std::size_t StorageDeserializer::threadsCount(std::size_t bucketsCount) const {
+    std::size_t count = m_loadThreads ? m_loadThreads : std::thread::hardware_concurrency();
+    return std::max<std::size_t>(1, std::min(count, bucketsCount));
 }
 
 PolicyBucketId StorageDeserializer::parseBucketId(const std::string &line,
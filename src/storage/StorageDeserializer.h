@@ -22,6 +22,7 @@
 #ifndef SRC_STORAGE_STORAGEDESERIALIZER_H_
 #define SRC_STORAGE_STORAGEDESERIALIZER_H_
 
+#include <cstddef>
 #include <functional>
 #include <fstream>
 #include <memory>
@@ -40,8 +41,9 @@ class StorageDeserializer {
 public:
     typedef std::function<std::shared_ptr<BucketDeserializer>(const std::string &)>
                 BucketStreamOpener;
+    // Opener is called concurrently by loading threads; 0 threads means one per CPU core
     StorageDeserializer(std::shared_ptr<std::istream> inStream,
-                        BucketStreamOpener m_bucketStreamOpener);
+                        BucketStreamOpener m_bucketStreamOpener, std::size_t loadThreads = 0);
     void initBuckets(Buckets &buckets);
     void loadBuckets(Buckets &buckets);
 
@@ -51,8 +53,12 @@ public:
                                                       std::size_t &beginToken);
 
 private:
+    void loadBucket(const PolicyBucketId &bucketId, PolicyBucket &bucket);
+    std::size_t threadsCount(std::size_t bucketsCount) const;
+
     std::shared_ptr<std::istream> m_inStream;
     BucketStreamOpener m_bucketStreamOpener;
+    std::size_t m_loadThreads;
 };
 
 } /* namespace Cynara */
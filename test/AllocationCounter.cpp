@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        test/AllocationCounter.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Replacement of global operator new counting allocations for benchmarks
+ */
+
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+#include "Benchmark.h"
+
+namespace {
+
+bool countingEnabled = false;
+std::size_t allocationsCount = 0;
+// Bytes allocated minus bytes freed while counting, as reported by malloc
+std::ptrdiff_t heapGrowth = 0;
+
+} // namespace anonymous
+
+void *operator new(std::size_t size) {
+    void *ptr = std::malloc(size ? size : 1);
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+
+    if (countingEnabled) {
+        ++allocationsCount;
+        heapGrowth += malloc_usable_size(ptr);
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept {
+    if (countingEnabled && ptr != nullptr)
+        heapGrowth -= malloc_usable_size(ptr);
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+namespace Cynara {
+
+namespace Benchmark {
+
+std::size_t countAllocations(Function fn) {
+    allocationsCount = 0;
+    countingEnabled = true;
+    fn();
+    countingEnabled = false;
+    return allocationsCount;
+}
+
+std::ptrdiff_t measureHeapGrowth(Function fn) {
+    heapGrowth = 0;
+    countingEnabled = true;
+    fn();
+    countingEnabled = false;
+    return heapGrowth;
+}
+
+}  // namespace Benchmark
+
+}  // namespace Cynara
@@ -24,6 +24,8 @@
 #define TEST_BENCHMARK_H_
 
 #include <chrono>
+#include <cstddef>
+#include <functional>
 
 namespace Cynara {
 
@@ -42,6 +44,12 @@ Precision measure(Function fn) {
     return std::chrono::duration_cast<Precision>(t1 - t0);
 }
 
+// Counts heap allocations made by fn (see AllocationCounter.cpp)
+std::size_t countAllocations(Function fn);
+
+// Measures how much memory allocated with operator new grew during fn
+std::ptrdiff_t measureHeapGrowth(Function fn);
+
 }  // namespace Benchmark
 
 }  // namespace Cynara
@@ -20,7 +20,9 @@
  * @brief       Tests of ChecksumGenerator
  */
 
+#include <cstdlib>
 #include <string>
+#include <unistd.h>
 
 #include <cynara-error.h>
 
@@ -119,3 +121,35 @@ TEST_F(ChsgenCommandlineTest, suffixErasing) {
         ASSERT_TRUE(err.empty());
     }
 }
+
+/**
+ * @brief   Verify if checksum generator returns valid CRC32C records
+ * @test    Expected result:
+ * - CYNARA_API_SUCCESS returned from checksum generator
+ * - record with tagged CRC32C checksum in output stream
+ * - empty error stream
+ */
+TEST_F(ChsgenCommandlineTest, crc32cRecordGeneration) {
+    char filenameTemplate[] = "/tmp/cynara-chsgen-XXXXXX";
+    int fd = mkstemp(filenameTemplate);
+    ASSERT_LE(0, fd);
+    ASSERT_EQ(9, write(fd, "123456789", 9));
+    close(fd);
+    const std::string pathname(filenameTemplate);
+    const std::string filename(pathname.substr(pathname.rfind('/') + 1));
+
+    std::string err;
+    std::string out;
+
+    clearOutput();
+    prepare_argv({ execName, pathname, "-a", "crc32c" });
+
+    Cynara::ChecksumGenerator chsgen(this->argc(), this->argv());
+    const auto ret = chsgen.run();
+    getOutput(out, err);
+    unlink(pathname.c_str());
+
+    ASSERT_EQ(CYNARA_API_SUCCESS, ret);
+    ASSERT_EQ(filename + fieldSeparator + "$crc32c$e3069283\n", out);
+    ASSERT_TRUE(err.empty());
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        test/common/containers/binaryqueue.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Tests of BinaryQueue
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <sys/uio.h>
+
+#include <containers/BinaryQueue.h>
+
+using namespace Cynara;
+
+namespace {
+
+std::string joined(const struct iovec *iov, size_t count) {
+    std::string result;
+    for (size_t i = 0; i < count; ++i) {
+        result.append(static_cast<const char *>(iov[i].iov_base), iov[i].iov_len);
+    }
+    return result;
+}
+
+} // namespace anonymous
+
+TEST(BinaryQueue, fillIovec_buckets) {
+    BinaryQueue queue;
+    queue.appendUnmanaged(strdup("abc"), 3);
+    queue.appendUnmanaged(strdup("de"), 2);
+    queue.appendUnmanaged(strdup("fghi"), 4);
+
+    struct iovec iov[4];
+    ASSERT_EQ(3u, queue.fillIovec(iov, 4));
+    ASSERT_EQ("abcdefghi", joined(iov, 3));
+
+    ASSERT_EQ(2u, queue.fillIovec(iov, 2));
+    ASSERT_EQ("abcde", joined(iov, 2));
+
+    // Data is only described, not removed
+    ASSERT_EQ(9u, queue.size());
+}
+
+TEST(BinaryQueue, fillIovec_partially_consumed) {
+    BinaryQueue queue;
+    queue.appendUnmanaged(strdup("abc"), 3);
+    queue.appendUnmanaged(strdup("de"), 2);
+
+    struct iovec iov[4];
+    queue.consume(2);
+    ASSERT_EQ(2u, queue.fillIovec(iov, 4));
+    ASSERT_EQ("cde", joined(iov, 2));
+
+    queue.consume(3);
+    ASSERT_EQ(0u, queue.fillIovec(iov, 4));
+}
+
+TEST(BinaryQueue, appendReserve_reuses_storage) {
+    BinaryQueue queue;
+    char *reserved = static_cast<char *>(queue.appendReserve(8));
+    memcpy(reserved, "abcd", 4);
+    queue.appendCommit(4);
+    ASSERT_EQ(4u, queue.size());
+
+    char data[4];
+    queue.flattenConsume(data, sizeof(data));
+    ASSERT_EQ("abcd", std::string(data, sizeof(data)));
+    ASSERT_TRUE(queue.empty());
+
+    // Consumed storage is used again
+    ASSERT_EQ(reserved, queue.appendReserve(8));
+}
+
+TEST(BinaryQueue, appendReserve_keeps_unconsumed_data) {
+    BinaryQueue queue;
+    memcpy(queue.appendReserve(4), "abcd", 4);
+    queue.appendCommit(4);
+    queue.consume(1);
+
+    // Unconsumed data is compacted or moved to grown storage
+    memcpy(queue.appendReserve(64), "efgh", 4);
+    queue.appendCommit(4);
+    memcpy(queue.appendReserve(2), "ij", 2);
+    queue.appendCommit(2);
+
+    std::string data(queue.size(), 0);
+    queue.flattenConsume(&data[0], data.size());
+    ASSERT_EQ("bcdefghij", data);
+}
+
+TEST(BinaryQueue, appendReserve_storage_not_moved) {
+    BinaryQueue queue;
+    memcpy(queue.appendReserve(4), "abcd", 4);
+    queue.appendCommit(4);
+
+    // Moved data does not refer to storage, which is reused by its former owner
+    BinaryQueue other;
+    other.appendMoveFrom(queue);
+    memcpy(queue.appendReserve(4), "efgh", 4);
+    queue.appendCommit(4);
+
+    std::string data(other.size(), 0);
+    other.flattenConsume(&data[0], data.size());
+    ASSERT_EQ("abcd", data);
+}
+
+TEST(BinaryQueue, linearize_first_bucket) {
+    BinaryQueue queue;
+    queue.appendCopy("abcd", 4);
+    queue.appendCopy("ef", 2);
+
+    const void *first = queue.linearize(3);
+    ASSERT_EQ("abc", std::string(static_cast<const char *>(first), 3));
+    ASSERT_EQ(first, queue.linearize(4));
+    ASSERT_EQ(6u, queue.size());
+}
+
+TEST(BinaryQueue, linearize_merges_buckets) {
+    BinaryQueue queue;
+    queue.appendUnmanaged(strdup("abc"), 3);
+    queue.appendUnmanaged(strdup("de"), 2);
+    queue.appendUnmanaged(strdup("fg"), 2);
+    queue.consume(1);
+
+    const char *data = static_cast<const char *>(queue.linearize(5));
+    ASSERT_EQ("bcdef", std::string(data, 5));
+    ASSERT_EQ(6u, queue.size());
+
+    std::string rest(queue.size(), 0);
+    queue.flattenConsume(&rest[0], rest.size());
+    ASSERT_EQ("bcdefg", rest);
+}
+
+TEST(BinaryQueue, appendCopy_across_chunks) {
+    BinaryQueue queue;
+    std::string expected;
+    for (size_t i = 0; expected.size() < 100000; ++i) {
+        std::string piece(i * 37 % 5000, static_cast<char>('a' + i % 26));
+        queue.appendCopy(piece.data(), piece.size());
+        expected += piece;
+    }
+    ASSERT_EQ(expected.size(), queue.size());
+
+    std::string data(queue.size(), 0);
+    queue.flattenConsume(&data[0], data.size());
+    ASSERT_EQ(expected, data);
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(BinaryQueue, appendCopy_data_not_moved) {
+    BinaryQueue queue;
+    queue.appendCopy("abc", 3);
+
+    struct iovec iov[1];
+    ASSERT_EQ(1u, queue.fillIovec(iov, 1));
+
+    // Data described for pending write stays in place, when more data is appended
+    std::string big(50000, 'x');
+    queue.appendCopy(big.data(), big.size());
+    queue.appendCopy("de", 2);
+
+    struct iovec again[1];
+    ASSERT_EQ(1u, queue.fillIovec(again, 1));
+    ASSERT_EQ(iov[0].iov_base, again[0].iov_base);
+    ASSERT_EQ("abc", std::string(static_cast<const char *>(again[0].iov_base), 3));
+    ASSERT_EQ(50005u, queue.size());
+}
+
+TEST(BinaryQueue, appendMoveFrom_small_data) {
+    BinaryQueue queue;
+    queue.appendCopy("abc", 3);
+
+    BinaryQueue other;
+    other.appendMoveFrom(queue);
+    ASSERT_TRUE(queue.empty());
+
+    // Small data kept inside moved out binary queue is not shared with its former owner
+    queue.appendCopy("xyz", 3);
+    other.appendCopy("de", 2);
+
+    std::string data(other.size(), 0);
+    other.flattenConsume(&data[0], data.size());
+    ASSERT_EQ("abcde", data);
+
+    queue.flattenConsume(&data[0], 3);
+    ASSERT_EQ("xyz", data.substr(0, 3));
+}
+
+TEST(BinaryQueue, appendCopyFrom_keeps_source) {
+    BinaryQueue queue;
+    queue.appendCopy("abc", 3);
+    std::string big(20000, 'y');
+    queue.appendCopy(big.data(), big.size());
+
+    BinaryQueue other;
+    other.appendCopy("_", 1);
+    other.appendCopyFrom(queue);
+    ASSERT_EQ(20003u, queue.size());
+    ASSERT_EQ(20004u, other.size());
+
+    std::string data(other.size(), 0);
+    other.flattenConsume(&data[0], data.size());
+    ASSERT_EQ("_abc" + big, data);
+}
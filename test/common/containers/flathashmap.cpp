@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        test/common/containers/flathashmap.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Tests of FlatHashMap
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+
+#include <containers/FlatHashMap.h>
+
+using namespace Cynara;
+
+namespace {
+
+typedef FlatHashMap<std::string, int> Map;
+
+std::map<std::string, int> contents(const Map &map) {
+    std::map<std::string, int> result;
+    for (const auto &entry : map) {
+        result.insert({ entry.first, entry.second });
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(FlatHashMap, insert_find) {
+    Map map;
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(map.end(), map.find("missing"));
+
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(map.insert({ std::to_string(i), i }).second);
+    }
+    ASSERT_FALSE(map.insert({ "7", 0 }).second);
+    map["1000"] = 1000;
+
+    ASSERT_EQ(1001u, map.size());
+    for (int i = 0; i <= 1000; ++i) {
+        auto it = map.find(std::to_string(i));
+        ASSERT_NE(map.end(), it);
+        ASSERT_EQ(i, it->second);
+    }
+    ASSERT_EQ(1001u, contents(map).size());
+}
+
+/**
+ * @brief   Erasing while iterating visits every other entry once, like with std::unordered_map
+ */
+TEST(FlatHashMap, erase_while_iterating) {
+    Map map;
+    for (int i = 0; i < 100; ++i) {
+        map[std::to_string(i)] = i;
+    }
+
+    int visited = 0;
+    for (auto it = map.begin(); it != map.end();) {
+        ++visited;
+        if (it->second % 2) {
+            map.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+
+    ASSERT_EQ(100, visited);
+    ASSERT_EQ(50u, map.size());
+    for (const auto &entry : map) {
+        ASSERT_EQ(0, entry.second % 2);
+    }
+    ASSERT_EQ(1u, map.erase("0"));
+    ASSERT_EQ(0u, map.erase("1"));
+    ASSERT_EQ(map.end(), map.find("0"));
+}
+
+/**
+ * @brief   Repeated inserting and erasing reuses slots instead of growing the table
+ */
+TEST(FlatHashMap, churn_keeps_capacity) {
+    Map map;
+    for (int i = 0; i < 10; ++i) {
+        map[std::to_string(i)] = i;
+    }
+    const auto capacity = map.capacity();
+
+    for (int i = 10; i < 10000; ++i) {
+        map.erase(std::to_string(i - 10));
+        map[std::to_string(i)] = i;
+    }
+
+    ASSERT_EQ(capacity, map.capacity());
+    ASSERT_EQ(10u, map.size());
+    for (int i = 9990; i < 10000; ++i) {
+        ASSERT_EQ(1u, map.count(std::to_string(i)));
+    }
+}
+
+TEST(FlatHashMap, copy_move) {
+    Map map;
+    for (int i = 0; i < 100; ++i) {
+        map[std::to_string(i)] = i;
+    }
+
+    Map copy(map);
+    ASSERT_EQ(contents(map), contents(copy));
+    copy.erase("1");
+    ASSERT_EQ(1u, map.count("1"));
+
+    Map moved(std::move(copy));
+    ASSERT_EQ(99u, moved.size());
+    ASSERT_TRUE(copy.empty());
+
+    map = moved;
+    ASSERT_EQ(contents(moved), contents(map));
+    map.clear();
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(map.begin(), map.end());
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        test/common/containers/performance/binaryqueue.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Performance tests of BinaryQueue throughput and allocations
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <containers/BinaryQueue.h>
+
+#include "../../../Benchmark.h"
+
+using namespace Cynara;
+
+namespace {
+
+const std::size_t MESSAGES_NUMBER = 1000000;
+const std::size_t TRANSFER_BYTES = 200 * 1024 * 1024;
+
+// Appends messages in batches and consumes them one by one, as sockets queues do
+void transfer(BinaryQueue &queue, std::vector<char> &message, std::size_t batchSize,
+              std::size_t messagesNumber) {
+    for (std::size_t sent = 0; sent < messagesNumber; sent += batchSize) {
+        for (std::size_t i = 0; i < batchSize; ++i) {
+            queue.appendCopy(message.data(), message.size());
+        }
+        for (std::size_t i = 0; i < batchSize; ++i) {
+            queue.flattenConsume(message.data(), message.size());
+        }
+    }
+}
+
+// Reads frames into reserved memory and parses them in place, as read queues do
+void receive(BinaryQueue &queue, std::size_t frameSize, std::size_t framesNumber) {
+    const std::size_t readSize = 8192;
+    std::size_t received = 0;
+
+    while (received < framesNumber) {
+        char *buffer = static_cast<char *>(queue.appendReserve(readSize));
+        memset(buffer, 'f', readSize);
+        queue.appendCommit(readSize);
+
+        while (queue.size() >= frameSize) {
+            queue.linearize(frameSize);
+            queue.consume(frameSize);
+            ++received;
+        }
+    }
+}
+
+void measureTransfer(::testing::Test *test, std::size_t messageSize, std::size_t batchSize) {
+    using std::chrono::microseconds;
+
+    const std::size_t messagesNumber = std::min(MESSAGES_NUMBER, TRANSFER_BYTES / messageSize);
+
+    std::vector<char> message(messageSize, 'm');
+    BinaryQueue queue;
+    transfer(queue, message, batchSize, batchSize);
+
+    auto allocations = Benchmark::countAllocations([&] () {
+        transfer(queue, message, batchSize, messagesNumber / 10);
+    });
+    auto result = Benchmark::measure<microseconds>([&] () {
+        transfer(queue, message, batchSize, messagesNumber);
+    });
+
+    // Chunks and ring of buckets are reused in steady state
+    ASSERT_EQ(0u, allocations);
+
+    auto name = "performance_transfer_" + std::to_string(messageSize);
+    auto megabytes = result.count() ? messagesNumber * messageSize / result.count() : 0;
+    test->RecordProperty(name, std::to_string(megabytes) + " [MB/s]");
+}
+
+} // namespace
+
+TEST(Performance, binaryqueue_transfer_small) {
+    measureTransfer(this, 24, 64);
+}
+
+TEST(Performance, binaryqueue_transfer_medium) {
+    measureTransfer(this, 1000, 64);
+}
+
+TEST(Performance, binaryqueue_transfer_large) {
+    measureTransfer(this, 40000, 4);
+}
+
+TEST(Performance, binaryqueue_receive) {
+    using std::chrono::microseconds;
+
+    // Frames cross boundaries of reads, so some of them are merged
+    const std::size_t frameSize = 300;
+
+    BinaryQueue queue;
+    receive(queue, frameSize, 1000);
+
+    auto allocations = Benchmark::countAllocations([&queue] () {
+        receive(queue, frameSize, MESSAGES_NUMBER / 10);
+    });
+    auto result = Benchmark::measure<microseconds>([&queue] () {
+        receive(queue, frameSize, MESSAGES_NUMBER);
+    });
+
+    ASSERT_EQ(0u, allocations);
+
+    auto framesPerSecond = result.count() ? MESSAGES_NUMBER * 1000000 / result.count() : 0;
+    RecordProperty("performance_receive", std::to_string(framesPerSecond) + " [frames/s]");
+}
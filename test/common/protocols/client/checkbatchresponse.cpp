@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        test/common/protocols/client/checkbatchresponse.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Tests for Cynara::CheckBatchResponse usage in Cynara::ProtocolClient
+ */
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cynara-error.h>
+#include <protocol/ProtocolClient.h>
+#include <response/CheckBatchResponse.h>
+
+#include <ResponseTestHelper.h>
+#include <TestDataCollection.h>
+
+namespace {
+
+template<>
+void compare(const Cynara::CheckBatchResponse &resp1, const Cynara::CheckBatchResponse &resp2) {
+    EXPECT_EQ(resp1.getReturnValues(), resp2.getReturnValues());
+    EXPECT_EQ(resp1.getResults(), resp2.getResults());
+    EXPECT_EQ(resp1.sequenceNumber(), resp2.sequenceNumber());
+}
+
+} /* namespace anonymous */
+
+using namespace Cynara;
+using namespace ResponseTestHelper;
+using namespace TestDataCollection;
+
+/* *** compare by objects test cases *** */
+
+/**
+ * @brief   Verify if CheckBatchResponse with one result is properly (de)serialized
+ * @test    Expected result:
+ * - result is resolved allow
+ */
+TEST(ProtocolClient, CheckBatchResponse01) {
+    std::vector<int32_t> retValues = { CYNARA_API_SUCCESS };
+    std::vector<PolicyResult> results = { Results::allow };
+
+    auto response = std::make_shared<CheckBatchResponse>(retValues, results, SN::min);
+    auto protocol = std::make_shared<ProtocolClient>();
+    testResponse(response, protocol);
+}
+
+/**
+ * @brief   Verify if CheckBatchResponse with resolved and not resolved results is properly
+ *          (de)serialized
+ * @test    Expected result:
+ * - results are resolved deny, not resolved plugin and resolved plugin with metadata
+ */
+TEST(ProtocolClient, CheckBatchResponse02) {
+    std::vector<int32_t> retValues = { CYNARA_API_SUCCESS, CYNARA_API_ACCESS_NOT_RESOLVED,
+                                       CYNARA_API_SUCCESS };
+    std::vector<PolicyResult> results = { Results::deny, Results::plugin_1, Results::plugin_2 };
+
+    auto response = std::make_shared<CheckBatchResponse>(retValues, results, SN::max);
+    auto protocol = std::make_shared<ProtocolClient>();
+    testResponse(response, protocol);
+}
+
+/* *** compare by serialized data test cases *** */
+
+/**
+ * @brief   Verify if CheckBatchResponse with resolved and not resolved results is properly
+ *          (de)serialized
+ * @test    Expected result:
+ * - results are resolved deny, not resolved plugin and resolved plugin with metadata
+ */
+TEST(ProtocolClient, CheckBatchResponseBinary01) {
+    std::vector<int32_t> retValues = { CYNARA_API_SUCCESS, CYNARA_API_ACCESS_NOT_RESOLVED,
+                                       CYNARA_API_SUCCESS };
+    std::vector<PolicyResult> results = { Results::deny, Results::plugin_1, Results::plugin_2 };
+
+    auto response = std::make_shared<CheckBatchResponse>(retValues, results, SN::mid);
+    auto protocol = std::make_shared<ProtocolClient>();
+    binaryTestResponse(response, protocol);
+}
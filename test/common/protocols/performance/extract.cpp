@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        test/common/protocols/performance/extract.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Performance tests of request extraction from received frames
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <containers/BinaryQueue.h>
+#include <containers/RawBuffer.h>
+#include <protocol/Protocol.h>
+#include <protocol/ProtocolAdmin.h>
+#include <protocol/ProtocolClient.h>
+#include <protocol/ProtocolMonitorGet.h>
+#include <request/AdminCheckRequest.h>
+#include <request/CheckRequest.h>
+#include <request/MonitorGetEntriesRequest.h>
+#include <request/RequestContext.h>
+#include <response/ResponseTaker.h>
+#include <types/PolicyBucket.h>
+#include <types/PolicyKey.h>
+
+#include "../../../Benchmark.h"
+
+using namespace Cynara;
+
+namespace {
+
+const std::size_t FRAMES_NUMBER = 100000;
+
+/*
+ * Serializes frames with given protocol and puts them in one bucket, as if they were
+ * received from socket at once. Then measures, how fast all of them are extracted.
+ */
+void measureExtract(::testing::Test *test, ProtocolPtr protocol,
+                    std::function<RequestPtr(std::size_t)> makeRequest,
+                    const std::string &name) {
+    using std::chrono::microseconds;
+
+    auto frames = std::make_shared<BinaryQueue>();
+    RequestContext context(ResponseTakerPtr(), frames);
+    for (std::size_t i = 0; i < FRAMES_NUMBER; ++i) {
+        makeRequest(i)->execute(*protocol, context);
+    }
+
+    RawBuffer data(frames->size());
+    frames->flattenConsume(data.data(), data.size());
+    auto queue = std::make_shared<BinaryQueue>();
+    queue->appendCopy(data.data(), data.size());
+
+    std::size_t extracted = 0;
+    auto result = Benchmark::measure<microseconds>([&] () {
+        while (protocol->extractRequestFromBuffer(queue)) {
+            ++extracted;
+        }
+    });
+
+    ASSERT_EQ(FRAMES_NUMBER, extracted);
+    ASSERT_EQ(static_cast<std::size_t>(0), queue->size());
+
+    auto framesPerSecond = result.count() ? FRAMES_NUMBER * 1000000 / result.count() : 0;
+    test->RecordProperty("performance_" + name,
+                         std::to_string(framesPerSecond) + " [frames/s]");
+}
+
+PolicyKey makeKey(std::size_t i) {
+    return PolicyKey("client" + std::to_string(i % 100), "user" + std::to_string(i % 10),
+                     "http://tizen.org/privilege/privilege" + std::to_string(i % 50));
+}
+
+} // namespace
+
+TEST(Performance, extract_check) {
+    measureExtract(this, std::make_shared<ProtocolClient>(), [] (std::size_t i) -> RequestPtr {
+        return std::make_shared<CheckRequest>(makeKey(i), i);
+    }, "check");
+}
+
+TEST(Performance, extract_admin_check) {
+    measureExtract(this, std::make_shared<ProtocolAdmin>(), [] (std::size_t i) -> RequestPtr {
+        return std::make_shared<AdminCheckRequest>(makeKey(i), defaultPolicyBucketId, true, i);
+    }, "admin_check");
+}
+
+TEST(Performance, extract_monitor_get_entries) {
+    measureExtract(this, std::make_shared<ProtocolMonitorGet>(), [] (std::size_t i) -> RequestPtr {
+        return std::make_shared<MonitorGetEntriesRequest>(i % 100 + 1, i);
+    }, "monitor_get_entries");
+}
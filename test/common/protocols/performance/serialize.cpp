@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        test/common/protocols/performance/serialize.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Performance tests of response serialization
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <containers/BinaryQueue.h>
+#include <protocol/ProtocolAdmin.h>
+#include <protocol/ProtocolClient.h>
+#include <request/RequestContext.h>
+#include <response/CheckResponse.h>
+#include <response/ListResponse.h>
+#include <response/ResponseTaker.h>
+#include <types/Policy.h>
+#include <types/PolicyKey.h>
+#include <types/PolicyResult.h>
+#include <types/PolicyType.h>
+
+#include "../../../Benchmark.h"
+
+using namespace Cynara;
+
+namespace {
+
+const std::size_t RESPONSES_NUMBER = 100000;
+
+} // namespace
+
+TEST(Performance, serialize_check_response) {
+    using std::chrono::microseconds;
+
+    auto queue = std::make_shared<BinaryQueue>();
+    RequestContext context(ResponseTakerPtr(), queue);
+    ProtocolClient protocol;
+    PolicyResult result(PredefinedPolicyType::ALLOW, "metadata");
+    CheckResponse response(result, 1);
+
+    // Whole frame is one bucket, so only the bucket and its list node are allocated
+    auto allocations = Benchmark::countAllocations([&] () {
+        response.execute(protocol, context);
+    });
+    ASSERT_LE(allocations, static_cast<std::size_t>(2));
+
+    queue->clear();
+    auto duration = Benchmark::measure<microseconds>([&] () {
+        for (std::size_t i = 0; i < RESPONSES_NUMBER; ++i) {
+            response.execute(protocol, context);
+        }
+    });
+    ASSERT_FALSE(queue->empty());
+
+    auto responsesPerSecond = duration.count() ? RESPONSES_NUMBER * 1000000 / duration.count()
+                                               : 0;
+    RecordProperty("performance_check_response",
+                   std::to_string(responsesPerSecond) + " [responses/s]");
+}
+
+TEST(Performance, serialize_list_response_10000) {
+    auto queue = std::make_shared<BinaryQueue>();
+    RequestContext context(ResponseTakerPtr(), queue);
+    ProtocolAdmin protocol;
+
+    std::vector<Policy> policies;
+    for (std::size_t p = 0; p < 10000; ++p) {
+        policies.push_back(Policy(PolicyKey("client" + std::to_string(p), "user",
+                                            "http://tizen.org/privilege/privilege"),
+                                  PolicyResult(PredefinedPolicyType::ALLOW)));
+    }
+    ListResponse response(policies, true, false, 1);
+
+    auto allocations = Benchmark::countAllocations([&] () {
+        response.execute(protocol, context);
+    });
+    ASSERT_LE(allocations, static_cast<std::size_t>(2));
+
+    RecordProperty("performance_list_response_allocations", std::to_string(allocations));
+}
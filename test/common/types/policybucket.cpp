@@ -27,6 +27,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cynara-admin-types.h>
+
 #include "exceptions/InvalidBucketIdException.h"
 #include "types/PolicyBucket.h"
 #include "types/PolicyCollection.h"
@@ -152,6 +154,160 @@ TEST_F(PolicyBucketFixture, filtered_wildcard_none) {
     ASSERT_THAT(filtered, IsEmpty());
 }
 
+TEST_F(PolicyBucketFixture, match_wildcard) {
+    using ::testing::UnorderedElementsAre;
+
+    PolicyBucket bucket("match_wildcard", PredefinedPolicyType::ALLOW, wildcardPolicies);
+    PolicyMatches matches;
+    bucket.match(PolicyKey("c1", "u1", "p2"), matches);
+
+    ASSERT_THAT(matches, UnorderedElementsAre(wildcardPolicies.at(0).get(),
+                                              wildcardPolicies.at(1).get(),
+                                              wildcardPolicies.at(3).get()));
+    ASSERT_EQ(PredefinedPolicyType::ALLOW, matches.defaultPolicy());
+}
+
+TEST_F(PolicyBucketFixture, match_wildcard_key) {
+    using ::testing::UnorderedElementsAre;
+
+    // Variants of key already containing wildcards must not be reported twice
+    PolicyBucket bucket("match_wildcard_key", wildcardPolicies);
+    PolicyMatches matches;
+    bucket.match(PolicyKey("*", "*", "*"), matches);
+
+    ASSERT_THAT(matches, UnorderedElementsAre(wildcardPolicies.at(3).get()));
+}
+
+TEST_F(PolicyBucketFixture, insert_replaces) {
+    using ::testing::IsEmpty;
+    using ::testing::UnorderedElementsAre;
+
+    // Inserting policy with the same key replaces the old one
+    PolicyBucket bucket("insert_replaces");
+    auto replacement = Policy::simpleWithKey(PolicyKey(pk1), PredefinedPolicyType::DENY);
+    bucket.insertPolicy(Policy::simpleWithKey(PolicyKey(pk1), PredefinedPolicyType::ALLOW));
+    bucket.insertPolicy(replacement);
+
+    ASSERT_THAT(bucket, UnorderedElementsAre(replacement));
+
+    bucket.deletePolicy(pk1);
+    ASSERT_THAT(bucket, IsEmpty());
+}
+
+TEST_F(PolicyBucketFixture, match_after_shape_changes) {
+    using ::testing::IsEmpty;
+    using ::testing::UnorderedElementsAre;
+
+    // Shapes of deleted policies must not be probed, shapes of inserted ones must be
+    PolicyBucket bucket("match_after_shape_changes", wildcardPolicies);
+    const PolicyKey key("c1", "u1", "p1");
+    PolicyMatches matches;
+
+    bucket.deletePolicy(PolicyKey("*", "*", "p1"));
+    bucket.deletePolicy([] (PolicyPtr policy) {
+        return policy->key().client() == "*";
+    });
+    bucket.match(key, matches);
+    ASSERT_THAT(matches, UnorderedElementsAre(wildcardPolicies.at(0).get()));
+
+    bucket.deletePolicy(PolicyKey("c1", "u1", "*"));
+    bucket.match(key, matches);
+    ASSERT_THAT(matches, IsEmpty());
+
+    auto policy = Policy::simpleWithKey(PolicyKey("*", "u1", "p1"), PredefinedPolicyType::ALLOW);
+    bucket.insertPolicy(policy);
+    bucket.match(key, matches);
+    ASSERT_THAT(matches, UnorderedElementsAre(policy.get()));
+}
+
+TEST_F(PolicyBucketFixture, links_follow_changes) {
+    using ::testing::ElementsAre;
+    using ::testing::IsEmpty;
+    using ::testing::SizeIs;
+    using ::testing::UnorderedElementsAre;
+
+    // Links are known of policies given at construction, inserted and replaced ones
+    PolicyBucket bucket("links_follow_changes", PolicyCollection({
+        Policy::bucketWithKey(pk1, "linked1"),
+        Policy::simpleWithKey(pk2, PredefinedPolicyType::ALLOW)
+    }));
+    ASSERT_THAT(bucket.getSubBuckets(), ElementsAre("linked1"));
+
+    bucket.insertPolicy(Policy::bucketWithKey(pk2, "linked2"));
+    bucket.insertPolicy(Policy::bucketWithKey(pk3, "linked2"));
+    ASSERT_THAT(bucket.getSubBuckets(), ElementsAre("linked1", "linked2"));
+
+    auto replaced = bucket.insertPolicy(Policy::simpleWithKey(pk1, PredefinedPolicyType::DENY));
+    ASSERT_EQ(PolicyResult(PredefinedPolicyType::BUCKET, "linked1"), replaced->result());
+    ASSERT_FALSE(bucket.linksTo("linked1"));
+    ASSERT_THAT(bucket.listLinks(), UnorderedElementsAre(*Policy::bucketWithKey(pk2, "linked2"),
+                                                         *Policy::bucketWithKey(pk3, "linked2")));
+
+    // All policies linking to the bucket are deleted, others stay
+    ASSERT_EQ(2u, bucket.deleteLinks("linked2"));
+    ASSERT_THAT(bucket.getSubBuckets(), IsEmpty());
+    ASSERT_THAT(bucket, SizeIs(1));
+    ASSERT_NE(nullptr, bucket.deletePolicy(pk1));
+    ASSERT_THAT(bucket, IsEmpty());
+    ASSERT_EQ(nullptr, bucket.deletePolicy(pk1));
+}
+
+TEST_F(PolicyBucketFixture, filter_follows_changes) {
+    using ::testing::IsEmpty;
+    using ::testing::UnorderedElementsAre;
+
+    const std::string any(CYNARA_ADMIN_ANY);
+    PolicyBucket bucket("filter_follows_changes", wildcardPolicies);
+
+    // Listing with filter indexes policies, later changes have to be indexed too
+    ASSERT_THAT(bucket.listPolicies(PolicyKey(any, "u1", any)),
+                UnorderedElementsAre(*wildcardPolicies.at(0), *wildcardPolicies.at(1)));
+
+    auto policy = Policy::simpleWithKey(PolicyKey("c2", "u1", "p2"), PredefinedPolicyType::DENY);
+    bucket.insertPolicy(policy);
+    bucket.deletePolicy(PolicyKey("c1", "u1", "*"));
+    ASSERT_THAT(bucket.listPolicies(PolicyKey(any, "u1", any)),
+                UnorderedElementsAre(*wildcardPolicies.at(1), *policy));
+    ASSERT_THAT(bucket.listPolicies(PolicyKey(any, "u1", "p2")),
+                UnorderedElementsAre(*wildcardPolicies.at(1), *policy));
+    ASSERT_THAT(bucket.listPolicies(PolicyKey("c1", any, any)), IsEmpty());
+    ASSERT_THAT(bucket.listPolicies(PolicyKey("unknown", any, any)), IsEmpty());
+
+    // Wildcard in filter matches only wildcard in policy
+    ASSERT_EQ(3u, bucket.deletePolicies(PolicyKey("*", any, any)));
+    ASSERT_THAT(bucket, UnorderedElementsAre(policy));
+    ASSERT_EQ(0u, bucket.deletePolicies(PolicyKey(any, "u2", any)));
+    ASSERT_EQ(1u, bucket.deletePolicies(PolicyKey(any, any, any)));
+    ASSERT_THAT(bucket, IsEmpty());
+}
+
+TEST_F(PolicyBucketFixture, copies_change_independently) {
+    using ::testing::ElementsAre;
+    using ::testing::IsEmpty;
+    using ::testing::UnorderedElementsAre;
+
+    const auto link = Policy::bucketWithKey(pk1, "linked");
+    const auto allow = Policy::simpleWithKey(pk2, PredefinedPolicyType::ALLOW);
+    const auto deny = Policy::simpleWithKey(pk3, PredefinedPolicyType::DENY);
+    PolicyBucket bucket("copies_change_independently", PolicyCollection({ link, allow }));
+    // Features indexed before copying are indexed again by the changed copy
+    ASSERT_THAT(bucket.listPolicies(pk2), ElementsAre(*allow));
+    const PolicyBucket copy(bucket);
+
+    bucket.insertPolicy(deny);
+    ASSERT_EQ(1u, bucket.deleteLinks("linked"));
+    ASSERT_EQ(allow, bucket.deletePolicy(pk2));
+    ASSERT_THAT(bucket, ElementsAre(deny));
+    ASSERT_THAT(bucket.getSubBuckets(), IsEmpty());
+    ASSERT_THAT(bucket.listPolicies(pk3), ElementsAre(*deny));
+    ASSERT_THAT(bucket.listPolicies(pk2), IsEmpty());
+
+    ASSERT_THAT(copy, UnorderedElementsAre(link, allow));
+    ASSERT_THAT(copy.getSubBuckets(), ElementsAre("linked"));
+    ASSERT_THAT(copy.listPolicies(pk2), ElementsAre(*allow));
+    ASSERT_THAT(copy.listPolicies(pk3), IsEmpty());
+}
+
 /**
  * @brief   Validate PolicyBucketIds during creation - passing bucket ids
  * @test    Scenario:
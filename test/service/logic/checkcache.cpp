@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        test/service/logic/checkcache.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Tests of CheckCache
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <service/logic/CheckCache.h>
+#include <common/types/PolicyKey.h>
+#include <common/types/PolicyResult.h>
+#include <common/types/PolicyType.h>
+
+#include "../../helpers.h"
+
+using namespace Cynara;
+
+TEST(CheckCache, miss_then_hit) {
+    CheckCache cache(16);
+    auto key = Helpers::generatePolicyKey();
+    PolicyResult result;
+
+    ASSERT_FALSE(cache.get(key, result));
+    cache.update(key, PolicyResult(PredefinedPolicyType::ALLOW));
+    ASSERT_TRUE(cache.get(key, result));
+    ASSERT_EQ(PredefinedPolicyType::ALLOW, result);
+
+    ASSERT_EQ(1u, cache.hits());
+    ASSERT_EQ(1u, cache.misses());
+}
+
+TEST(CheckCache, other_key_misses) {
+    CheckCache cache(1);
+    auto key1 = Helpers::generatePolicyKey("1");
+    auto key2 = Helpers::generatePolicyKey("2");
+    PolicyResult result;
+
+    // Single slot, so the keys replace each other
+    cache.update(key1, PolicyResult(PredefinedPolicyType::ALLOW));
+    ASSERT_FALSE(cache.get(key2, result));
+    cache.update(key2, PolicyResult(PredefinedPolicyType::DENY));
+    ASSERT_FALSE(cache.get(key1, result));
+    ASSERT_TRUE(cache.get(key2, result));
+    ASSERT_EQ(PredefinedPolicyType::DENY, result);
+}
+
+TEST(CheckCache, invalidate) {
+    CheckCache cache(16);
+    auto key = Helpers::generatePolicyKey();
+    PolicyResult result;
+
+    cache.update(key, PolicyResult(PredefinedPolicyType::ALLOW));
+    cache.invalidate();
+    ASSERT_FALSE(cache.get(key, result));
+
+    cache.update(key, PolicyResult(PredefinedPolicyType::DENY));
+    ASSERT_TRUE(cache.get(key, result));
+    ASSERT_EQ(PredefinedPolicyType::DENY, result);
+}
+
+TEST(CheckCache, no_capacity) {
+    CheckCache cache(0);
+    auto key = Helpers::generatePolicyKey();
+    PolicyResult result;
+
+    cache.update(key, PolicyResult(PredefinedPolicyType::ALLOW));
+    ASSERT_FALSE(cache.get(key, result));
+}
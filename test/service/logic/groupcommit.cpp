@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        test/service/logic/groupcommit.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Tests of GroupCommit
+ */
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <service/logic/GroupCommit.h>
+#include <common/request/RequestContext.h>
+
+using namespace Cynara;
+
+namespace {
+
+typedef GroupCommit::Clock Clock;
+using std::chrono::milliseconds;
+
+} // namespace
+
+TEST(GroupCommit, disabled_by_default) {
+    GroupCommit groupCommit;
+    ASSERT_FALSE(groupCommit.enabled());
+    ASSERT_TRUE(groupCommit.empty());
+    ASSERT_FALSE(groupCommit.due());
+}
+
+TEST(GroupCommit, due_after_window) {
+    GroupCommit groupCommit;
+    groupCommit.configure(milliseconds(20), 100);
+    ASSERT_TRUE(groupCommit.enabled());
+
+    const auto start = Clock::now();
+    groupCommit.add(RequestContext(), 1, start);
+    groupCommit.add(RequestContext(), 2, start + milliseconds(15));
+
+    // Window is started by the first change of the batch
+    ASSERT_FALSE(groupCommit.due(start + milliseconds(19)));
+    ASSERT_EQ(milliseconds(5), groupCommit.timeLeft(start + milliseconds(15)));
+    ASSERT_TRUE(groupCommit.due(start + milliseconds(20)));
+    ASSERT_EQ(milliseconds(0), groupCommit.timeLeft(start + milliseconds(25)));
+
+    auto acknowledgements = groupCommit.take();
+    ASSERT_EQ(2u, acknowledgements.size());
+    ASSERT_EQ(1, acknowledgements[0].sequenceNumber);
+    ASSERT_EQ(2, acknowledgements[1].sequenceNumber);
+    ASSERT_TRUE(groupCommit.empty());
+    ASSERT_FALSE(groupCommit.due(start + milliseconds(25)));
+}
+
+TEST(GroupCommit, due_at_operation_limit) {
+    GroupCommit groupCommit;
+    groupCommit.configure(milliseconds(1000), 3);
+
+    const auto start = Clock::now();
+    groupCommit.add(RequestContext(), 1, start);
+    groupCommit.add(RequestContext(), 2, start);
+    ASSERT_FALSE(groupCommit.due(start));
+    groupCommit.add(RequestContext(), 3, start);
+    ASSERT_TRUE(groupCommit.due(start));
+}
+
+TEST(GroupCommit, window_restarts_with_new_batch) {
+    GroupCommit groupCommit;
+    groupCommit.configure(milliseconds(20), 100);
+
+    const auto start = Clock::now();
+    groupCommit.add(RequestContext(), 1, start);
+    groupCommit.take();
+
+    groupCommit.add(RequestContext(), 2, start + milliseconds(30));
+    ASSERT_FALSE(groupCommit.due(start + milliseconds(40)));
+    ASSERT_TRUE(groupCommit.due(start + milliseconds(50)));
+}
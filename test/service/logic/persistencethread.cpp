@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        test/service/logic/persistencethread.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Tests of PersistenceThread
+ */
+
+#include <poll.h>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <service/logic/PersistenceThread.h>
+
+using namespace Cynara;
+
+namespace {
+
+bool readable(int fd, int timeoutMs) {
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    return poll(&pfd, 1, timeoutMs) == 1;
+}
+
+} // namespace
+
+TEST(PersistenceThread, signals_completion) {
+    PersistenceThread thread;
+    ASSERT_FALSE(thread.busy());
+
+    std::thread::id taskThreadId;
+    thread.run([&taskThreadId] () { taskThreadId = std::this_thread::get_id(); });
+    ASSERT_TRUE(thread.busy());
+
+    ASSERT_TRUE(readable(thread.descriptor(), 5000));
+    ASSERT_TRUE(thread.done());
+    ASSERT_NO_THROW(thread.finish());
+    ASSERT_FALSE(thread.busy());
+    ASSERT_NE(std::this_thread::get_id(), taskThreadId);
+
+    // Notification is consumed by finish()
+    ASSERT_FALSE(readable(thread.descriptor(), 0));
+}
+
+TEST(PersistenceThread, rethrows_task_exception) {
+    PersistenceThread thread;
+
+    thread.run([] () { throw std::runtime_error("save failed"); });
+    ASSERT_THROW(thread.finish(), std::runtime_error);
+    ASSERT_FALSE(thread.busy());
+
+    // Thread is still usable after failed task
+    bool run = false;
+    thread.run([&run] () { run = true; });
+    ASSERT_NO_THROW(thread.finish());
+    ASSERT_TRUE(run);
+}
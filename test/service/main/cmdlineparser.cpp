@@ -21,6 +21,7 @@
  */
 
 #include <string>
+#include <utility>
 
 #include <service/main/CmdlineParser.h>
 
@@ -42,7 +43,16 @@ const std::string helpMessage(
     "  -u, --user=USER              change user to USER "
                  "[by default uid is not changed]\n"
     "  -g, --group=GROUP            change group to GROUP "
-                 "[by default gid is not changed]\n");
+                 "[by default gid is not changed]\n"
+    "  -i, --image                  keep binary image of database for faster loading "
+                 "[by default no image is kept]\n"
+    "  -w, --commit-window=MS       save admin changes in batches of MS milliseconds, "
+                 "0 disables batching [by default 20]\n"
+    "  -o, --commit-operations=N    save admin batch once it has N changes, "
+                 "0 sets no limit [by default 256]\n"
+    "Maintenance mode options [program exits after database maintenance]:\n"
+    "  -c, --compact=DIR            save journaled changes of database in DIR "
+                 "into its files [service must not be running]\n");
 
 } // namespace
 
@@ -161,6 +171,10 @@ TEST_F(CynaraCommandlineTest, noOption) {
     ASSERT_EQ(options.m_mask, static_cast<mode_t>(-1));
     ASSERT_EQ(options.m_uid, static_cast<uid_t>(-1));
     ASSERT_EQ(options.m_gid, static_cast<gid_t>(-1));
+    ASSERT_FALSE(options.m_image);
+    ASSERT_TRUE(options.m_compactDir.empty());
+    ASSERT_EQ(20u, options.m_commitWindow);
+    ASSERT_EQ(256u, options.m_commitOperations);
     ASSERT_TRUE(out.empty());
     ASSERT_TRUE(err.empty());
 }
@@ -195,6 +209,149 @@ TEST_F(CynaraCommandlineTest, daemonOption) {
     }
 }
 
+/**
+ * @brief   Verify if passing image option to commandline succeeds
+ * @test    Expected result:
+ * - call handler indicates success
+ * - image is enabled
+ * - empty output stream
+ * - empty error stream
+ */
+TEST_F(CynaraCommandlineTest, imageOption) {
+    std::string err;
+    std::string out;
+
+    for (const auto &imageOpt : { "-i", "--image" }) {
+        clearOutput();
+        prepare_argv({ execName, imageOpt });
+
+        SCOPED_TRACE(imageOpt);
+        const auto options = Parser::handleCmdlineOptions(this->argc(), this->argv());
+        getOutput(out, err);
+
+        ASSERT_FALSE(options.m_error);
+        ASSERT_FALSE(options.m_exit);
+        ASSERT_TRUE(options.m_image);
+        ASSERT_TRUE(out.empty());
+        ASSERT_TRUE(err.empty());
+    }
+}
+
+/**
+ * @brief   Verify if passing compact option to commandline succeeds
+ * @test    Expected result:
+ * - call handler indicates success
+ * - database directory is returned
+ * - empty output stream
+ * - empty error stream
+ */
+TEST_F(CynaraCommandlineTest, compactOption) {
+    std::string err;
+    std::string out;
+
+    std::string dirParam("/var/cynara/db/");
+
+    for (const auto &compactOpt : { "-c", "--compact" }) {
+        clearOutput();
+        prepare_argv({ execName, compactOpt, dirParam });
+
+        SCOPED_TRACE(compactOpt);
+        const auto options = Parser::handleCmdlineOptions(this->argc(), this->argv());
+        getOutput(out, err);
+
+        ASSERT_FALSE(options.m_error);
+        ASSERT_FALSE(options.m_exit);
+        ASSERT_EQ(dirParam, options.m_compactDir);
+        ASSERT_TRUE(out.empty());
+        ASSERT_TRUE(err.empty());
+    }
+}
+
+/**
+ * @brief   Verify if passing no compact option param to commandline fails
+ * @test    Expected result:
+ * - call handler indicates failure
+ * - help message in output stream
+ * - error message in error stream
+ */
+TEST_F(CynaraCommandlineTest, compactOptionNoParam) {
+    std::string err;
+    std::string out;
+
+    for (const auto &compactOpt : { "-c", "--compact" }) {
+        clearOutput();
+        prepare_argv({ execName, compactOpt });
+
+        SCOPED_TRACE(compactOpt);
+        const auto options = Parser::handleCmdlineOptions(this->argc(), this->argv());
+        getOutput(out, err);
+
+        ASSERT_TRUE(options.m_error);
+        ASSERT_TRUE(options.m_exit);
+        ASSERT_TRUE(options.m_compactDir.empty());
+        ASSERT_EQ(helpMessage, out);
+        ASSERT_EQ(std::string("Missing argument for option: ") + compactOpt + "\n", err);
+    }
+}
+
+/**
+ * @brief   Verify if passing group commit options to commandline succeeds
+ * @test    Expected result:
+ * - call handler indicates success
+ * - group commit window and operation limit are set, 0 is accepted
+ * - empty output stream
+ * - empty error stream
+ */
+TEST_F(CynaraCommandlineTest, commitOptions) {
+    std::string err;
+    std::string out;
+
+    for (const auto &commitOpts : { std::make_pair("-w", "-o"),
+                                    std::make_pair("--commit-window", "--commit-operations") }) {
+        clearOutput();
+        prepare_argv({ execName, commitOpts.first, "0", commitOpts.second, "16" });
+
+        SCOPED_TRACE(commitOpts.first);
+        const auto options = Parser::handleCmdlineOptions(this->argc(), this->argv());
+        getOutput(out, err);
+
+        ASSERT_FALSE(options.m_error);
+        ASSERT_FALSE(options.m_exit);
+        ASSERT_EQ(0u, options.m_commitWindow);
+        ASSERT_EQ(16u, options.m_commitOperations);
+        ASSERT_TRUE(out.empty());
+        ASSERT_TRUE(err.empty());
+    }
+}
+
+/**
+ * @brief   Verify if passing invalid group commit options to commandline fails
+ * @test    Expected result:
+ * - call handler indicates failure
+ * - help message in output stream
+ * - error message in error stream
+ */
+TEST_F(CynaraCommandlineTest, commitOptionsInvalid) {
+    std::string err;
+    std::string out;
+
+    for (const auto &commitOpt : { "-w", "--commit-window", "-o", "--commit-operations" }) {
+        for (const auto &param : { "-1", "20ms", "many" }) {
+            clearOutput();
+            prepare_argv({ execName, commitOpt, param });
+
+            SCOPED_TRACE(std::string(commitOpt) + " " + param);
+            const auto options = Parser::handleCmdlineOptions(this->argc(), this->argv());
+            getOutput(out, err);
+
+            ASSERT_TRUE(options.m_error);
+            ASSERT_TRUE(options.m_exit);
+            ASSERT_EQ(helpMessage, out);
+            ASSERT_EQ(std::string("Invalid param: ") + param + "\n", err);
+        }
+    }
+}
+
 /**
  * @brief   Verify if passing mask option to commandline succeeds
  * @test    Expected result:
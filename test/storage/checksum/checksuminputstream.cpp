@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        test/storage/checksum/checksuminputstream.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Tests of ChecksumInputStream
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+#include <exceptions/ChecksumRecordCorruptedException.h>
+#include <storage/ChecksumInputStream.h>
+#include <storage/ChecksumValidator.h>
+
+using namespace Cynara;
+
+namespace {
+
+class ChecksumInputStreamFixture : public ::testing::Test {
+public:
+    virtual ~ChecksumInputStreamFixture() {}
+
+protected:
+    virtual void SetUp() {
+        char filenameTemplate[] = "/tmp/cynara-chsstream-XXXXXX";
+        int fd = mkstemp(filenameTemplate);
+        ASSERT_LE(0, fd);
+        close(fd);
+        m_filename = filenameTemplate;
+
+        // Contents spanning a few buffer refills
+        for (int i = 0; i < 10000; ++i) {
+            m_contents += "client" + std::to_string(i) + ";user;privilege;0xFFFF;\n";
+        }
+        std::ofstream stream(m_filename);
+        stream << m_contents;
+    }
+
+    virtual void TearDown() {
+        unlink(m_filename.c_str());
+    }
+
+    static std::string readAll(std::istream &stream) {
+        std::string contents;
+        std::string line;
+        while (std::getline(stream, line)) {
+            contents += line + "\n";
+        }
+        return contents;
+    }
+
+    std::string m_filename;
+    std::string m_contents;
+};
+
+} // namespace
+
+/**
+ * @brief   Verify that file with matching checksum is read unchanged
+ * @test    Expected result: no exceptions are thrown and whole contents are read
+ */
+TEST_F(ChecksumInputStreamFixture, matchingChecksum) {
+    ChecksumInputStream stream(m_filename, ChecksumValidator::generate(m_contents));
+    ASSERT_TRUE(stream.is_open());
+
+    std::string contents;
+    ASSERT_NO_THROW(contents = readAll(stream));
+    ASSERT_EQ(m_contents, contents);
+}
+
+/**
+ * @brief   Verify that checksum mismatch is reported when end of file is reached
+ * @test    Expected result: ChecksumRecordCorruptedException is thrown
+ */
+TEST_F(ChecksumInputStreamFixture, checksumMismatch) {
+    ChecksumInputStream stream(m_filename, ChecksumValidator::generate(m_contents + "\n"));
+    ASSERT_TRUE(stream.is_open());
+
+    ASSERT_THROW(readAll(stream), ChecksumRecordCorruptedException);
+}
+
+/**
+ * @brief   Verify that stream of missing file is not opened
+ * @test    Expected result: is_open() returns false
+ */
+TEST_F(ChecksumInputStreamFixture, missingFile) {
+    ChecksumInputStream stream(m_filename + "-missing", ChecksumValidator::generate(""));
+    ASSERT_FALSE(stream.is_open());
+}
@@ -60,6 +60,48 @@ TEST_F(ChecksumValidatorFixture, generateChecksum) {
     }
 }
 
+/**
+ * @brief   Verify if generate() gives CRC32C checksums tagged with their algorithm
+ * @test    Expected result: checksum of check string matches its known value
+ */
+TEST_F(ChecksumValidatorFixture, generateCRC32C) {
+    const auto checksum = ChecksumValidator::generate("123456789",
+                                                      ChecksumValidator::Algorithm::CRC32C);
+    ASSERT_EQ(ChecksumValidator::crc32cTag + "e3069283", checksum);
+    ASSERT_EQ(ChecksumValidator::Algorithm::CRC32C, ChecksumValidator::algorithm(checksum));
+
+    ASSERT_EQ(ChecksumValidator::generate("123456789"),
+              ChecksumValidator::generate("123456789", ChecksumValidator::Algorithm::MD5));
+    ASSERT_EQ(ChecksumValidator::Algorithm::MD5,
+              ChecksumValidator::algorithm(ChecksumValidator::generate("123456789")));
+}
+
+/**
+ * @brief   Verify if compare() checks files against checksums of different algorithms
+ * @test    Expected result: matching contents pass, other contents throw an exception
+ */
+TEST_F(ChecksumValidatorFixture, compareMixedAlgorithms) {
+    FakeChecksumValidator validator(m_dbPath);
+    const std::string contents(";0x0;\n");
+
+    std::istringstream checksums(
+        "buckets" + std::string(1, m_fieldSeparator)
+        + ChecksumValidator::generate(contents, ChecksumValidator::Algorithm::CRC32C)
+        + m_recordSeparator
+        + "_" + m_fieldSeparator + ChecksumValidator::generate(std::string())
+        + m_recordSeparator);
+    validator.load(checksums);
+
+    std::istringstream index(contents);
+    ASSERT_NO_THROW(validator.compare(index, m_dbPath + "buckets", false));
+    std::istringstream bucket("");
+    ASSERT_NO_THROW(validator.compare(bucket, m_dbPath + "_", false));
+
+    std::istringstream corrupted(contents + "\n");
+    ASSERT_THROW(validator.compare(corrupted, m_dbPath + "buckets", false),
+                 ChecksumRecordCorruptedException);
+}
+
 /**
  * @brief   Verify if load() can successfully parse sample checksum record
  * @test    Expected result:
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        test/storage/image/databaseimage.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Tests of DatabaseImage
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <string>
+#include <unistd.h>
+
+#include <exceptions/BucketNotExistsException.h>
+#include <storage/Buckets.h>
+#include <storage/DatabaseImage.h>
+#include <types/Policy.h>
+#include <types/PolicyBucket.h>
+#include <types/PolicyKey.h>
+#include <types/PolicyResult.h>
+#include <types/PolicyType.h>
+#include <types/pointers.h>
+
+using namespace Cynara;
+
+namespace {
+
+const std::string snapshotDigest("0123456789abcdef0123456789abcdef");
+
+class DatabaseImageFixture : public ::testing::Test {
+public:
+    virtual ~DatabaseImageFixture() {}
+
+protected:
+    virtual void SetUp() {
+        char filenameTemplate[] = "/tmp/cynara-image-XXXXXX";
+        int fd = mkstemp(filenameTemplate);
+        ASSERT_LE(0, fd);
+        close(fd);
+        m_filename = filenameTemplate;
+
+        /*
+         * default bucket: (c1,u1,p1) ALLOW, (c1,*,p2) DENY, (*,*,p3) -> "linked", default DENY
+         * "linked" bucket: (c2,u2,*) ALLOW with metadata, (*,u2,p3) DENY, default NONE
+         */
+        addBucket(defaultPolicyBucketId, PredefinedPolicyType::DENY);
+        addBucket("linked", PredefinedPolicyType::NONE);
+        addPolicy(defaultPolicyBucketId, PolicyKey("c1", "u1", "p1"), PredefinedPolicyType::ALLOW);
+        addPolicy(defaultPolicyBucketId, PolicyKey("c1", "*", "p2"), PredefinedPolicyType::DENY);
+        addPolicy(defaultPolicyBucketId, PolicyKey("*", "*", "p3"),
+                  PolicyResult(PredefinedPolicyType::BUCKET, "linked"));
+        addPolicy("linked", PolicyKey("c2", "u2", "*"),
+                  PolicyResult(PredefinedPolicyType::ALLOW, "metadata;with;separators"));
+        addPolicy("linked", PolicyKey("*", "u2", "p3"), PredefinedPolicyType::DENY);
+    }
+
+    virtual void TearDown() {
+        unlink(m_filename.c_str());
+    }
+
+    void addBucket(const PolicyBucketId &bucketId, const PolicyResult &defaultPolicy) {
+        m_buckets.insert({ bucketId, PolicyBucket(bucketId, defaultPolicy) });
+    }
+
+    void addPolicy(const PolicyBucketId &bucketId, const PolicyKey &key,
+                   const PolicyResult &result) {
+        m_buckets.at(bucketId).insertPolicy(std::make_shared<Policy>(key, result));
+    }
+
+    static std::set<std::string> records(const Buckets &buckets) {
+        std::set<std::string> records;
+        for (const auto &bucketIter : buckets) {
+            const auto &bucket = bucketIter.second;
+            records.insert(bucket.id() + "|" + std::to_string(bucket.defaultPolicy().policyType())
+                           + "|" + bucket.defaultPolicy().metadata());
+            for (const auto &policy : bucket) {
+                records.insert(bucket.id() + "|" + policy->key().toString() + "|"
+                               + std::to_string(policy->result().policyType()) + "|"
+                               + policy->result().metadata());
+            }
+        }
+        return records;
+    }
+
+    std::string m_filename;
+    Buckets m_buckets;
+};
+
+} // namespace
+
+/**
+ * @brief   Buckets loaded from image are the same as dumped ones
+ */
+TEST_F(DatabaseImageFixture, dump_load) {
+    DatabaseImage::dump(m_buckets, snapshotDigest, m_filename);
+
+    DatabaseImage image(m_filename);
+    ASSERT_TRUE(image.open(snapshotDigest));
+
+    Buckets loaded;
+    image.load(loaded);
+    ASSERT_EQ(records(m_buckets), records(loaded));
+}
+
+/**
+ * @brief   Image of other snapshot or with corrupted contents is not opened
+ */
+TEST_F(DatabaseImageFixture, open_rejects) {
+    DatabaseImage::dump(m_buckets, snapshotDigest, m_filename);
+
+    DatabaseImage image(m_filename);
+    ASSERT_FALSE(image.open("ffffffffffffffffffffffffffffffff"));
+    ASSERT_FALSE(image.isOpen());
+
+    {
+        std::fstream stream(m_filename, std::ios::in | std::ios::out | std::ios::binary);
+        stream.seekp(-1, std::ios::end);
+        stream.put('X');
+    }
+    ASSERT_FALSE(image.open(snapshotDigest));
+
+    DatabaseImage missing(m_filename + "-missing");
+    ASSERT_FALSE(missing.open(snapshotDigest));
+}
+
+/**
+ * @brief   Checks answered from mapped image follow the same rules as Storage::checkPolicy()
+ */
+TEST_F(DatabaseImageFixture, check) {
+    using PredefinedPolicyType::ALLOW;
+    using PredefinedPolicyType::DENY;
+
+    DatabaseImage::dump(m_buckets, snapshotDigest, m_filename);
+
+    DatabaseImage image(m_filename);
+    ASSERT_TRUE(image.open(snapshotDigest));
+
+    EXPECT_EQ(ALLOW, image.check(PolicyKey("c1", "u1", "p1")).policyType());
+    EXPECT_EQ(DENY, image.check(PolicyKey("c1", "u1", "p2")).policyType());
+    // Not known strings fall back to default policy
+    EXPECT_EQ(DENY, image.check(PolicyKey("c9", "u9", "p9")).policyType());
+
+    // Linked bucket returns its minimal policy, with metadata
+    const auto linked = image.check(PolicyKey("c2", "u2", "p3"));
+    EXPECT_EQ(DENY, linked.policyType());
+    const auto linkedAllow = image.check(PolicyKey("c2", "u2", "p4"), "linked");
+    EXPECT_EQ(ALLOW, linkedAllow.policyType());
+    EXPECT_EQ("metadata;with;separators", linkedAllow.metadata());
+
+    // Bucket without matching policies gives NONE, so default policy of default bucket is used
+    EXPECT_EQ(DENY, image.check(PolicyKey("c3", "u3", "p3")).policyType());
+
+    EXPECT_TRUE(image.hasBucket("linked"));
+    EXPECT_FALSE(image.hasBucket("missing"));
+    EXPECT_THROW(image.check(PolicyKey("c1", "u1", "p1"), "missing"), BucketNotExistsException);
+}
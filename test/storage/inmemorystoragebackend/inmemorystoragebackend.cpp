@@ -20,6 +20,11 @@
  * @brief       Tests of InMemoryStorageBackend
  */
 
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -29,6 +34,7 @@
 #include "exceptions/DefaultBucketDeletionException.h"
 #include "exceptions/FileNotFoundException.h"
 #include "storage/InMemoryStorageBackend.h"
+#include "storage/Storage.h"
 #include "storage/StorageBackend.h"
 #include "types/PolicyCollection.h"
 #include "types/PolicyKey.h"
@@ -70,7 +76,6 @@ TEST_F(InMemoryStorageBackendFixture, deleteLinking) {
 
     FakeInMemoryStorageBackend backend(m_fakeDbPath);
     EXPECT_CALL(backend, buckets())
-        .Times(4)
         .WillRepeatedly(ReturnRef(m_buckets));
 
     const PolicyBucketId testBucket1 = "test-bucket-1";
@@ -90,20 +95,28 @@ TEST_F(InMemoryStorageBackendFixture, deleteLinking) {
         Policy::simpleWithKey(Helpers::generatePolicyKey("2"), PredefinedPolicyType::ALLOW),
     };
 
+    // Policies are inserted through backend, so it knows about their links
+    auto insertPolicies = [&backend] (const PolicyBucketId &bucketId,
+                                      const PolicyCollection &policies) {
+        for (const auto &policy : policies) {
+            backend.insertPolicy(bucketId, policy);
+        }
+    };
+
     // Add some policies to 1st bucket, which link to 2nd bucket
-    addToBucket(testBucket1, {
+    insertPolicies(testBucket1, {
         Policy::bucketWithKey(Helpers::generatePolicyKey("1"), testBucket2), /* 1st */
         Policy::bucketWithKey(Helpers::generatePolicyKey("2"), testBucket2), /* 2nd */
         policiesToStay.at(0)
     });
 
     // Add some policies to 2nd bucket
-    addToBucket(testBucket2, {
+    insertPolicies(testBucket2, {
         policiesToStay.at(1), policiesToStay.at(2)
     });
 
     // Add some policies to 3rd bucket, which link to 2nd bucket
-    addToBucket(testBucket3, {
+    insertPolicies(testBucket3, {
         Policy::bucketWithKey(Helpers::generatePolicyKey("X"), testBucket2),
         Policy::bucketWithKey(Helpers::generatePolicyKey("Y"), testBucket2),
     });
@@ -118,6 +131,50 @@ TEST_F(InMemoryStorageBackendFixture, deleteLinking) {
     ASSERT_THAT(m_buckets.at(testBucket3), IsEmpty());
 }
 
+/**
+ * @brief   Only links still present are deleted, after links were replaced and deleted
+ * @test    Scenario:
+ * - link to "linked" bucket from 2 buckets is replaced or deleted, one link stays
+ * - deleteLinking("linked") deletes only the remaining link
+ * - removal of bucket with a link drops its link, so later deleteLinking does not touch it
+ */
+TEST_F(InMemoryStorageBackendFixture, deleteLinkingAfterChanges) {
+    using ::testing::IsEmpty;
+    using ::testing::ReturnRef;
+    using ::testing::UnorderedElementsAre;
+
+    FakeInMemoryStorageBackend backend(m_fakeDbPath);
+    EXPECT_CALL(backend, buckets())
+        .WillRepeatedly(ReturnRef(m_buckets));
+
+    const PolicyBucketId linked = "linked";
+    const PolicyBucketId replacing = "replacing";
+    const PolicyBucketId deleting = "deleting";
+    const PolicyBucketId removed = "removed";
+    const PolicyKey key = Helpers::generatePolicyKey("1");
+    const PolicyKey otherKey = Helpers::generatePolicyKey("2");
+    const auto replacement = Policy::simpleWithKey(key, PredefinedPolicyType::ALLOW);
+    const auto staying = Policy::bucketWithKey(otherKey, linked);
+
+    for (const auto &bucketId : { linked, replacing, deleting, removed }) {
+        backend.createBucket(bucketId, PredefinedPolicyType::DENY);
+    }
+
+    backend.insertPolicy(replacing, Policy::bucketWithKey(key, linked));
+    backend.insertPolicy(replacing, replacement);
+    backend.insertPolicy(deleting, Policy::bucketWithKey(key, linked));
+    backend.insertPolicy(deleting, staying);
+    backend.deletePolicy(deleting, key);
+    backend.insertPolicy(removed, Policy::bucketWithKey(key, linked));
+    backend.deleteBucket(removed);
+
+    backend.deleteLinking(linked);
+
+    ASSERT_THAT(m_buckets.at(replacing), UnorderedElementsAre(replacement));
+    ASSERT_THAT(m_buckets.at(deleting), IsEmpty());
+    ASSERT_FALSE(m_buckets.at(deleting).linksTo(linked));
+}
+
 TEST_F(InMemoryStorageBackendFixture, insertPolicy) {
     using ::testing::ReturnRef;
     using ::testing::UnorderedElementsAre;
@@ -298,6 +355,397 @@ TEST_F(InMemoryStorageBackendFixture, load_from_backup) {
     }
 }
 
+/**
+ * @brief   Only buckets changed since last save are rewritten
+ * @test    Scenario:
+ * - Database with 2 buckets is saved to an empty directory
+ * - Policy is inserted into one bucket and database is saved again
+ * - File of changed bucket is replaced, file of the other one is the same file as before
+ * - Database loaded from the directory contains the inserted policy
+ */
+TEST_F(InMemoryStorageBackendFixture, save_changed_buckets_only) {
+    using ::testing::IsEmpty;
+    using ::testing::SizeIs;
+
+    const std::string dbPath = makeDatabaseDir();
+    ASSERT_FALSE(dbPath.empty());
+    const PolicyBucketId otherBucketId = "other";
+
+    auto inode = [&dbPath] (const PolicyBucketId &bucketId) -> ino_t {
+        struct stat st;
+        const auto filename = dbPath + PathConfig::StoragePath::bucketFilenamePrefix + bucketId;
+        return stat(filename.c_str(), &st) == 0 ? st.st_ino : 0;
+    };
+
+    {
+        InMemoryStorageBackend backend(dbPath);
+        backend.createBucket(defaultPolicyBucketId, PredefinedPolicyType::DENY);
+        backend.createBucket(otherBucketId, PredefinedPolicyType::DENY);
+        backend.save();
+
+        const auto defaultInode = inode(defaultPolicyBucketId);
+        const auto otherInode = inode(otherBucketId);
+        ASSERT_NE(0u, defaultInode);
+        ASSERT_NE(0u, otherInode);
+
+        backend.insertPolicy(otherBucketId, Policy::simpleWithKey(Helpers::generatePolicyKey(),
+                                                                  PredefinedPolicyType::ALLOW));
+        backend.save();
+
+        EXPECT_EQ(defaultInode, inode(defaultPolicyBucketId));
+        EXPECT_NE(otherInode, inode(otherBucketId));
+    }
+
+    InMemoryStorageBackend backend(dbPath);
+    ASSERT_NO_THROW(backend.load());
+    EXPECT_THAT(backend.searchBucket(defaultPolicyBucketId, Helpers::generatePolicyKey()),
+                IsEmpty());
+    EXPECT_THAT(backend.searchBucket(otherBucketId, Helpers::generatePolicyKey()), SizeIs(1));
+
+    removeDatabaseDir(dbPath);
+}
+
+/**
+ * @brief   Failed save never writes primary files through backup links
+ * @test    Scenario:
+ * - Database with 2 buckets is saved, then only default bucket is changed
+ * - Save fails on existing backup guard, after backup of other bucket was linked to its primary
+ * - Backup links are removed by the failed save
+ * - Other bucket is changed and its stale backup link is recreated, as if left by a crash
+ * - Next save fails the same way; primary file of other bucket keeps its contents
+ * - After guard is removed, save succeeds and loaded database contains all changes
+ */
+TEST_F(InMemoryStorageBackendFixture, failed_save_keeps_primary_files) {
+    using ::testing::SizeIs;
+
+    const std::string dbPath = makeDatabaseDir();
+    ASSERT_FALSE(dbPath.empty());
+    const PolicyBucketId otherBucketId = "other";
+    const std::string guardFilename = dbPath + PathConfig::StoragePath::guardFilename;
+    const std::string otherFilename = dbPath + PathConfig::StoragePath::bucketFilenamePrefix +
+                                      otherBucketId;
+    const std::string otherBackupFilename = otherFilename +
+                                            PathConfig::StoragePath::backupFilenameSuffix;
+    const PolicyKey key = Helpers::generatePolicyKey();
+
+    auto contents = [] (const std::string &filename) -> std::string {
+        std::ifstream stream(filename);
+        std::ostringstream buffer;
+        buffer << stream.rdbuf();
+        return buffer.str();
+    };
+
+    InMemoryStorageBackend backend(dbPath);
+    backend.createBucket(defaultPolicyBucketId, PredefinedPolicyType::DENY);
+    backend.createBucket(otherBucketId, PredefinedPolicyType::DENY);
+    backend.insertPolicy(otherBucketId, Policy::simpleWithKey(Helpers::generatePolicyKey("1"),
+                                                              PredefinedPolicyType::ALLOW));
+    backend.save();
+    const std::string otherContents = contents(otherFilename);
+    ASSERT_FALSE(otherContents.empty());
+
+    std::ofstream(guardFilename).close();
+    backend.insertPolicy(defaultPolicyBucketId,
+                         Policy::simpleWithKey(key, PredefinedPolicyType::ALLOW));
+    ASSERT_ANY_THROW(backend.save());
+    EXPECT_NE(0, access(otherBackupFilename.c_str(), F_OK));
+
+    backend.insertPolicy(otherBucketId, Policy::simpleWithKey(key, PredefinedPolicyType::ALLOW));
+    ASSERT_EQ(0, link(otherFilename.c_str(), otherBackupFilename.c_str()));
+    ASSERT_ANY_THROW(backend.save());
+    EXPECT_EQ(otherContents, contents(otherFilename));
+
+    ASSERT_EQ(0, unlink(guardFilename.c_str()));
+    backend.save();
+
+    InMemoryStorageBackend loaded(dbPath);
+    ASSERT_NO_THROW(loaded.load());
+    EXPECT_THAT(loaded.searchBucket(defaultPolicyBucketId, key), SizeIs(1));
+    EXPECT_THAT(loaded.searchBucket(otherBucketId, key), SizeIs(1));
+
+    removeDatabaseDir(dbPath);
+}
+
+/**
+ * @brief   Changes saved in journal mode are replayed over the snapshot
+ * @test    Scenario:
+ * - Database is saved as a snapshot, then changes are saved with journal enabled
+ * - Bucket files are not rewritten, journal grows instead
+ * - Record torn by a crash is appended to the journal
+ * - Database loaded (with journal disabled) contains all journaled changes
+ * - Its save() writes snapshot and removes journal
+ */
+TEST_F(InMemoryStorageBackendFixture, save_to_journal) {
+    using ::testing::IsEmpty;
+    using ::testing::SizeIs;
+
+    const std::string dbPath = makeDatabaseDir();
+    ASSERT_FALSE(dbPath.empty());
+    const std::string journalFilename = dbPath + PathConfig::StoragePath::journalFilename;
+    const std::string defaultFilename = dbPath + PathConfig::StoragePath::bucketFilenamePrefix;
+    const PolicyBucketId otherBucketId = "other";
+    const PolicyKey key = Helpers::generatePolicyKey();
+
+    auto fileSize = [] (const std::string &filename) -> off_t {
+        struct stat st;
+        return stat(filename.c_str(), &st) == 0 ? st.st_size : -1;
+    };
+
+    {
+        InMemoryStorageBackend backend(dbPath, Journal::DEFAULT_SIZE_LIMIT);
+        backend.createBucket(defaultPolicyBucketId, PredefinedPolicyType::DENY);
+        backend.save();
+        const auto journalSize = fileSize(journalFilename);
+        ASSERT_LT(0, journalSize);
+
+        backend.createBucket(otherBucketId, PredefinedPolicyType::ALLOW);
+        backend.insertPolicy(defaultPolicyBucketId,
+                             Policy::bucketWithKey(key, otherBucketId));
+        backend.insertPolicy(otherBucketId, Policy::simpleWithKey(key,
+                                                                  PredefinedPolicyType::DENY));
+        backend.save();
+        backend.deletePolicy(otherBucketId, key);
+        backend.save();
+
+        EXPECT_EQ(0, fileSize(defaultFilename));
+        EXPECT_LT(journalSize, fileSize(journalFilename));
+    }
+
+    std::ofstream(journalFilename, std::ofstream::app) << "torn record";
+
+    InMemoryStorageBackend backend(dbPath);
+    ASSERT_NO_THROW(backend.load());
+    EXPECT_THAT(backend.searchBucket(defaultPolicyBucketId, key), SizeIs(1));
+    EXPECT_THAT(backend.searchBucket(otherBucketId, key), IsEmpty());
+
+    backend.save();
+    EXPECT_LT(0, fileSize(defaultFilename));
+    EXPECT_EQ(-1, fileSize(journalFilename));
+
+    removeDatabaseDir(dbPath);
+}
+
+/**
+ * @brief   Journal passing its size limit is compacted into a snapshot
+ * @test    Scenario:
+ * - Database is saved with journal limited to hold a single record
+ * - First change is appended to journal, second one causes snapshot to be saved
+ * - Journal of previous snapshot is not replayed when database is loaded
+ */
+TEST_F(InMemoryStorageBackendFixture, compact_journal) {
+    using ::testing::SizeIs;
+
+    const std::string dbPath = makeDatabaseDir();
+    ASSERT_FALSE(dbPath.empty());
+    const std::string defaultFilename = dbPath + PathConfig::StoragePath::bucketFilenamePrefix;
+    // Snapshot record takes 68 bytes, any policy record takes more than 32
+    const std::size_t journalSizeLimit = 100;
+
+    {
+        InMemoryStorageBackend backend(dbPath, journalSizeLimit);
+        backend.createBucket(defaultPolicyBucketId, PredefinedPolicyType::DENY);
+        backend.save();
+
+        backend.insertPolicy(defaultPolicyBucketId,
+                             Policy::simpleWithKey(Helpers::generatePolicyKey("1"),
+                                                   PredefinedPolicyType::ALLOW));
+        backend.save();
+        std::ifstream defaultStream(defaultFilename);
+        ASSERT_EQ(std::ifstream::traits_type::eof(), defaultStream.peek());
+
+        backend.insertPolicy(defaultPolicyBucketId,
+                             Policy::simpleWithKey(Helpers::generatePolicyKey("2"),
+                                                   PredefinedPolicyType::ALLOW));
+        backend.save();
+    }
+
+    InMemoryStorageBackend backend(dbPath, journalSizeLimit);
+    ASSERT_NO_THROW(backend.load());
+    EXPECT_THAT(backend.searchBucket(defaultPolicyBucketId, Helpers::generatePolicyKey("1")),
+                SizeIs(1));
+    EXPECT_THAT(backend.searchBucket(defaultPolicyBucketId, Helpers::generatePolicyKey("2")),
+                SizeIs(1));
+
+    removeDatabaseDir(dbPath);
+}
+
+/**
+ * @brief   Database matching binary image is loaded from the image, without parsing text files
+ * @test    Scenario:
+ * - save database with image enabled
+ * - overwrite default bucket file with contents which could not be parsed
+ * - load database and check that policy saved before is still there
+ */
+TEST_F(InMemoryStorageBackendFixture, load_from_image) {
+    using ::testing::SizeIs;
+
+    const std::string dbPath = makeDatabaseDir();
+    ASSERT_FALSE(dbPath.empty());
+    const std::string defaultFilename = dbPath + PathConfig::StoragePath::bucketFilenamePrefix;
+
+    {
+        InMemoryStorageBackend backend(dbPath, 0, true);
+        backend.createBucket(defaultPolicyBucketId, PredefinedPolicyType::DENY);
+        backend.insertPolicy(defaultPolicyBucketId,
+                             Policy::simpleWithKey(Helpers::generatePolicyKey(),
+                                                   PredefinedPolicyType::ALLOW));
+        backend.save();
+    }
+
+    {
+        std::ofstream defaultStream(defaultFilename, std::ios::trunc);
+        defaultStream << "corrupted";
+    }
+
+    InMemoryStorageBackend backend(dbPath, 0, true);
+    ASSERT_NO_THROW(backend.load());
+    EXPECT_THAT(backend.searchBucket(defaultPolicyBucketId, Helpers::generatePolicyKey()),
+                SizeIs(1));
+
+    removeDatabaseDir(dbPath);
+}
+
+/**
+ * @brief   Checks are answered from loaded image, until database is changed
+ * @test    Scenario:
+ * - save database with image enabled and load it
+ * - check that checks are answered by backend from image, the same way as by Storage
+ * - insert policy and check that Storage answers with it from loaded buckets
+ */
+TEST_F(InMemoryStorageBackendFixture, check_from_image) {
+    using PredefinedPolicyType::ALLOW;
+    using PredefinedPolicyType::DENY;
+
+    const std::string dbPath = makeDatabaseDir();
+    ASSERT_FALSE(dbPath.empty());
+    const PolicyKey allowedKey("c1", "u1", "p1");
+    const PolicyKey otherKey("c2", "u2", "p2");
+
+    {
+        InMemoryStorageBackend backend(dbPath, 0, true);
+        backend.createBucket(defaultPolicyBucketId, DENY);
+        backend.insertPolicy(defaultPolicyBucketId, Policy::simpleWithKey(allowedKey, ALLOW));
+        backend.save();
+    }
+
+    InMemoryStorageBackend backend(dbPath, 0, true);
+    backend.load();
+    Storage storage(backend);
+
+    PolicyResult result;
+    ASSERT_TRUE(backend.check(allowedKey, defaultPolicyBucketId, true, result));
+    EXPECT_EQ(ALLOW, result.policyType());
+    EXPECT_EQ(DENY, storage.checkPolicy(otherKey).policyType());
+    EXPECT_TRUE(backend.hasBucket(defaultPolicyBucketId));
+
+    backend.insertPolicy(defaultPolicyBucketId, Policy::simpleWithKey(otherKey, ALLOW));
+    ASSERT_FALSE(backend.check(otherKey, defaultPolicyBucketId, true, result));
+    EXPECT_EQ(ALLOW, storage.checkPolicy(otherKey).policyType());
+    EXPECT_EQ(ALLOW, storage.checkPolicy(allowedKey).policyType());
+
+    removeDatabaseDir(dbPath);
+}
+
+/**
+ * @brief   Image made by save rewriting some buckets holds policies of all of them
+ * @test    Scenario:
+ * - save database with 2 buckets and image enabled
+ * - overwrite file of the other bucket with contents which could not be parsed
+ * - insert policy into default bucket only and save again
+ * - overwrite default bucket file too
+ * - load database from image and check that policies of both buckets are there
+ */
+TEST_F(InMemoryStorageBackendFixture, image_of_unchanged_buckets) {
+    using ::testing::SizeIs;
+
+    const std::string dbPath = makeDatabaseDir();
+    ASSERT_FALSE(dbPath.empty());
+    const PolicyBucketId otherBucketId = "other";
+    const std::string defaultFilename = dbPath + PathConfig::StoragePath::bucketFilenamePrefix;
+    const PolicyKey firstKey("c1", "u1", "p1");
+    const PolicyKey secondKey("c2", "u2", "p2");
+
+    {
+        InMemoryStorageBackend backend(dbPath, 0, true);
+        backend.createBucket(defaultPolicyBucketId, PredefinedPolicyType::DENY);
+        backend.createBucket(otherBucketId, PredefinedPolicyType::DENY);
+        backend.insertPolicy(otherBucketId,
+                             Policy::simpleWithKey(firstKey, PredefinedPolicyType::ALLOW));
+        backend.save();
+
+        // Image is made of policies in memory, so unchanged bucket file is not read back
+        std::ofstream otherStream(defaultFilename + otherBucketId, std::ios::trunc);
+        otherStream << "corrupted";
+        otherStream.close();
+
+        backend.insertPolicy(defaultPolicyBucketId,
+                             Policy::simpleWithKey(secondKey, PredefinedPolicyType::ALLOW));
+        backend.save();
+    }
+
+    {
+        std::ofstream defaultStream(defaultFilename, std::ios::trunc);
+        defaultStream << "corrupted";
+    }
+
+    InMemoryStorageBackend backend(dbPath, 0, true);
+    ASSERT_NO_THROW(backend.load());
+    EXPECT_THAT(backend.searchBucket(otherBucketId, firstKey), SizeIs(1));
+    EXPECT_THAT(backend.searchBucket(defaultPolicyBucketId, secondKey), SizeIs(1));
+
+    removeDatabaseDir(dbPath);
+}
+
+/**
+ * @brief   Changes made while prepared save is written are saved by the next save
+ * @test    Scenario:
+ * - save is prepared with one policy in default bucket
+ * - other policy and bucket are added before the save task is run
+ * - loaded database contains only the first policy
+ * - after the next save, loaded database contains all changes
+ */
+TEST_F(InMemoryStorageBackendFixture, prepared_save) {
+    using ::testing::SizeIs;
+
+    const std::string dbPath = makeDatabaseDir();
+    ASSERT_FALSE(dbPath.empty());
+    const PolicyBucketId otherBucketId = "other";
+    const PolicyKey firstKey("c1", "u1", "p1");
+    const PolicyKey secondKey("c2", "u2", "p2");
+
+    InMemoryStorageBackend backend(dbPath, 0, true);
+    backend.createBucket(defaultPolicyBucketId, PredefinedPolicyType::DENY);
+    backend.insertPolicy(defaultPolicyBucketId,
+                         Policy::simpleWithKey(firstKey, PredefinedPolicyType::ALLOW));
+
+    auto task = backend.prepareSave();
+    ASSERT_TRUE(static_cast<bool>(task));
+
+    backend.insertPolicy(defaultPolicyBucketId,
+                         Policy::simpleWithKey(secondKey, PredefinedPolicyType::ALLOW));
+    backend.createBucket(otherBucketId, PredefinedPolicyType::ALLOW);
+
+    ASSERT_NO_THROW(task());
+    backend.completeSave(true);
+
+    {
+        InMemoryStorageBackend loaded(dbPath);
+        ASSERT_NO_THROW(loaded.load());
+        EXPECT_THAT(loaded.searchBucket(defaultPolicyBucketId, firstKey), SizeIs(1));
+        EXPECT_THAT(loaded.searchBucket(defaultPolicyBucketId, secondKey), SizeIs(0));
+        EXPECT_FALSE(loaded.hasBucket(otherBucketId));
+    }
+
+    backend.save();
+
+    InMemoryStorageBackend loaded(dbPath);
+    ASSERT_NO_THROW(loaded.load());
+    EXPECT_THAT(loaded.searchBucket(defaultPolicyBucketId, secondKey), SizeIs(1));
+    EXPECT_TRUE(loaded.hasBucket(otherBucketId));
+
+    removeDatabaseDir(dbPath);
+}
+
 /**
  * @brief   Erase from non-exiting bucket should throw BucketNotExistsException
  * @test    Scenario:
@@ -27,8 +27,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cstdlib>
+#include <dirent.h>
 #include <map>
 #include <string>
+#include <unistd.h>
 
 #include <types/PolicyBucket.h>
 #include <types/PolicyCollection.h>
@@ -98,6 +101,27 @@ protected:
 
     virtual ~InMemoryStorageBackendFixture() {}
 
+    // Creates empty database directory for tests using load() and save()
+    static std::string makeDatabaseDir(void) {
+        char dirTemplate[] = "/tmp/cynara-db-XXXXXX";
+        if (mkdtemp(dirTemplate) == nullptr) {
+            return std::string();
+        }
+        return std::string(dirTemplate) + "/";
+    }
+
+    static void removeDatabaseDir(const std::string &dbPath) {
+        DIR *dir = opendir(dbPath.c_str());
+        if (dir == nullptr) {
+            return;
+        }
+        while (struct dirent *entry = readdir(dir)) {
+            unlink((dbPath + entry->d_name).c_str());
+        }
+        closedir(dir);
+        rmdir(dbPath.c_str());
+    }
+
     const Cynara::PolicyCollection &fullPoliciesCollection(void) {
         using Cynara::PredefinedPolicyType::ALLOW;
         if (m_fullPolicyCollection.empty()) {
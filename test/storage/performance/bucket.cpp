@@ -29,6 +29,7 @@
 #include <gtest/gtest.h>
 
 #include <storage/InMemoryStorageBackend.h>
+#include <storage/Storage.h>
 #include <types/Policy.h>
 #include <types/PolicyBucket.h>
 #include <types/PolicyKey.h>
@@ -101,6 +102,133 @@ TEST(Performance, bucket_filtered_100000) {
     RecordProperty(key, value);
 }
 
+TEST(Performance, bucket_match_100000) {
+    using std::chrono::nanoseconds;
+
+    PolicyBucket bucket("test");
+
+    PolicyKeyGenerator generator(100, 10);
+
+    const std::size_t policyNumber = 100000;
+    for (std::size_t i = 0; i < policyNumber; ++i) {
+        bucket.insertPolicy(std::make_shared<Policy>(generator.randomKey(),
+                            PredefinedPolicyType::ALLOW));
+    }
+
+    const unsigned int measureRepeats = 100000;
+    std::vector<PolicyKey> keys;
+    for (auto i = 0u; i < measureRepeats; ++i) {
+        keys.push_back(generator.randomKey());
+    }
+
+    PolicyMatches matches;
+    auto result = Benchmark::measure<nanoseconds>([&bucket, &keys, &matches] () {
+        for (const auto &key : keys) {
+            bucket.match(key, matches);
+        }
+    });
+
+    auto key = std::string("performance_" + std::to_string(policyNumber));
+    auto value = std::to_string(result.count() / measureRepeats) + " [ns]";
+    RecordProperty(key, value);
+}
+
+TEST(Performance, bucket_match_shapes_100000) {
+    using std::chrono::nanoseconds;
+
+    PolicyBucket bucket("test");
+
+    PolicyKeyGenerator generator(100, 10);
+
+    // Only (c,*,p) and (*,*,p) policies, like in typical databases
+    const std::size_t policyNumber = 100000;
+    for (std::size_t i = 0; i < policyNumber; ++i) {
+        const auto key = generator.randomKey();
+        const auto client = (i % 2) ? key.client() : PolicyKeyFeature::createWildcard();
+        bucket.insertPolicy(std::make_shared<Policy>(
+                            PolicyKey(client, PolicyKeyFeature::createWildcard(), key.privilege()),
+                            PredefinedPolicyType::ALLOW));
+    }
+
+    const unsigned int measureRepeats = 100000;
+    std::vector<PolicyKey> keys;
+    for (auto i = 0u; i < measureRepeats; ++i) {
+        keys.push_back(generator.randomKey());
+    }
+
+    PolicyMatches matches;
+    auto result = Benchmark::measure<nanoseconds>([&bucket, &keys, &matches] () {
+        for (const auto &key : keys) {
+            bucket.match(key, matches);
+        }
+    });
+
+    auto key = std::string("performance_" + std::to_string(policyNumber));
+    auto value = std::to_string(result.count() / measureRepeats) + " [ns]";
+    RecordProperty(key, value);
+}
+
+TEST(Performance, bucket_listPolicies_100000) {
+    using std::chrono::microseconds;
+
+    PolicyBucket bucket("test");
+
+    PolicyKeyGenerator generator(100, 10);
+
+    const std::size_t policyNumber = 100000;
+    for (std::size_t i = 0; i < policyNumber; ++i) {
+        bucket.insertPolicy(std::make_shared<Policy>(generator.randomKey(),
+                            PredefinedPolicyType::ALLOW));
+    }
+
+    // Holders of one privilege, like cyad listing with only privilege given
+    const unsigned int measureRepeats = 1000;
+    auto result = Benchmark::measure<microseconds>([&bucket, &generator, measureRepeats] () {
+        for (auto i = 0u; i < measureRepeats; ++i) {
+            const auto privilege = generator.randomKey().privilege();
+            bucket.listPolicies(PolicyKey(PolicyKeyFeature::createAny(),
+                                          PolicyKeyFeature::createAny(), privilege));
+        }
+    });
+
+    auto key = std::string("performance_" + std::to_string(policyNumber));
+    auto value = std::to_string(result.count() / measureRepeats) + " [us]";
+    RecordProperty(key, value);
+}
+
+/*
+ * Latency of inserting policies and memory taken by bucket to keep them (policies themselves
+ * are created beforehand).
+ */
+TEST(Performance, bucket_insert_100000) {
+    using std::chrono::nanoseconds;
+
+    PolicyKeyGenerator generator(100, 10);
+
+    const std::size_t policyNumber = 100000;
+    std::vector<PolicyPtr> policies;
+    for (std::size_t i = 0; i < policyNumber; ++i) {
+        policies.push_back(std::make_shared<Policy>(generator.randomKey(),
+                                                    PredefinedPolicyType::ALLOW));
+    }
+
+    std::unique_ptr<PolicyBucket> bucket;
+    nanoseconds result;
+    auto heapGrowth = Benchmark::measureHeapGrowth([&bucket, &policies, &result] () {
+        bucket.reset(new PolicyBucket("test"));
+        result = Benchmark::measure<nanoseconds>([&bucket, &policies] () {
+            for (const auto &policy : policies) {
+                bucket->insertPolicy(policy);
+            }
+        });
+    });
+
+    RecordProperty("insert_" + std::to_string(policyNumber),
+                   std::to_string(result.count() / policyNumber) + " [ns]");
+    RecordProperty("bytes_per_policy",
+                   std::to_string(heapGrowth / static_cast<std::ptrdiff_t>(bucket->size())));
+}
+
 TEST(Performance, bucket_hasBucket) {
     using std::chrono::microseconds;
 
@@ -138,3 +266,62 @@ TEST(Performance, bucket_createBucket) {
     auto value = std::to_string(result.count() / measureRepeats) + " [us]";
     RecordProperty(key, value);
 }
+
+/*
+ * Default bucket links to a chain of buckets, each with random policies.
+ * Compares allocations made by filtering buckets into new PolicyBucket objects (as check did
+ * before) with allocations made by Storage::checkPolicy() matching policies in place.
+ */
+TEST(Performance, check_allocations) {
+    const std::size_t bucketsNumber = 6;
+    const std::size_t policyNumber = 10000;
+
+    InMemoryStorageBackend backend("/some/fake/path"); // don't use load() or save()
+    Storage storage(backend);
+    PolicyKeyGenerator generator(100, 10);
+
+    backend.createBucket(defaultPolicyBucketId, PredefinedPolicyType::DENY);
+    PolicyBucketId previousId = defaultPolicyBucketId;
+    for (auto i = 0u; i < bucketsNumber; ++i) {
+        PolicyBucketId bucketId = "b" + std::to_string(i);
+        backend.createBucket(bucketId, PredefinedPolicyType::DENY);
+        backend.insertPolicy(previousId, Policy::bucketWithKey(PolicyKey("*", "*", "*"),
+                                                                bucketId));
+        for (auto j = 0u; j < policyNumber; ++j) {
+            backend.insertPolicy(bucketId, Policy::simpleWithKey(generator.randomKey(),
+                                                                 PredefinedPolicyType::ALLOW));
+        }
+        previousId = bucketId;
+    }
+
+    const unsigned int measureRepeats = 1000;
+    std::vector<PolicyKey> keys;
+    for (auto i = 0u; i < measureRepeats; ++i) {
+        keys.push_back(generator.randomKey());
+    }
+
+    // Warm up, so buffers reused between checks are already allocated
+    storage.checkPolicy(keys.front());
+
+    auto filteredAllocations = Benchmark::countAllocations([&backend, &keys] () {
+        for (const auto &key : keys) {
+            backend.searchBucket(defaultPolicyBucketId, key);
+            for (auto i = 0u; i < bucketsNumber; ++i) {
+                backend.searchBucket("b" + std::to_string(i), key);
+            }
+        }
+    });
+
+    auto checkAllocations = Benchmark::countAllocations([&storage, &keys] () {
+        for (const auto &key : keys) {
+            storage.checkPolicy(key);
+        }
+    });
+
+    RecordProperty("allocations_per_check_filtered",
+                   std::to_string(filteredAllocations / measureRepeats));
+    RecordProperty("allocations_per_check",
+                   std::to_string(checkAllocations / measureRepeats));
+
+    ASSERT_EQ(0u, checkAllocations);
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd All Rights Reserved
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ * @file        test/storage/performance/load.cpp
+ * @author      agent <agent@local>
+ * @version     1.0
+ * @brief       Performance tests of database load under different checksum algorithms
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <dirent.h>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <storage/ChecksumValidator.h>
+#include <storage/InMemoryStorageBackend.h>
+#include <types/Policy.h>
+#include <types/PolicyBucketId.h>
+#include <types/PolicyKey.h>
+#include <types/PolicyType.h>
+
+#include "../../Benchmark.h"
+
+using namespace Cynara;
+
+namespace {
+
+std::string makeDatabaseDir(void) {
+    char dirTemplate[] = "/tmp/cynara-perf-XXXXXX";
+    if (mkdtemp(dirTemplate) == nullptr) {
+        return std::string();
+    }
+    return std::string(dirTemplate) + "/";
+}
+
+void removeDatabaseDir(const std::string &dbPath) {
+    DIR *dir = opendir(dbPath.c_str());
+    if (dir == nullptr) {
+        return;
+    }
+    while (struct dirent *entry = readdir(dir)) {
+        unlink((dbPath + entry->d_name).c_str());
+    }
+    closedir(dir);
+    rmdir(dbPath.c_str());
+}
+
+void measureLoad(::testing::Test *test, ChecksumValidator::Algorithm algorithm,
+                 std::size_t bucketNumber, std::size_t policyNumber) {
+    using std::chrono::milliseconds;
+
+    const std::string dbPath = makeDatabaseDir();
+    ASSERT_FALSE(dbPath.empty());
+
+    {
+        InMemoryStorageBackend backend(dbPath, 0, false, algorithm);
+        backend.createBucket(defaultPolicyBucketId, PredefinedPolicyType::DENY);
+        for (std::size_t b = 0; b < bucketNumber; ++b) {
+            const PolicyBucketId bucketId = "bucket" + std::to_string(b);
+            backend.createBucket(bucketId, PredefinedPolicyType::DENY);
+            for (std::size_t p = 0; p < policyNumber; ++p) {
+                backend.insertPolicy(bucketId, Policy::simpleWithKey(
+                    PolicyKey("client" + std::to_string(p), "user" + std::to_string(b),
+                              "http://tizen.org/privilege/privilege" + std::to_string(p)),
+                    PredefinedPolicyType::ALLOW));
+            }
+        }
+        backend.save();
+    }
+
+    InMemoryStorageBackend backend(dbPath);
+    auto result = Benchmark::measure<milliseconds>([&backend] () {
+        backend.load();
+    });
+    removeDatabaseDir(dbPath);
+
+    auto key = std::string("performance_" + std::to_string(bucketNumber) + "x"
+                           + std::to_string(policyNumber));
+    auto value = std::to_string(result.count()) + " [ms]";
+    test->RecordProperty(key, value);
+}
+
+} // namespace
+
+// 100 buckets of 1000 policies each
+TEST(Performance, load_md5_100000) {
+    measureLoad(this, ChecksumValidator::Algorithm::MD5, 100, 1000);
+}
+
+TEST(Performance, load_crc32c_100000) {
+    measureLoad(this, ChecksumValidator::Algorithm::CRC32C, 100, 1000);
+}
+
+// Startup with thousands of small bucket files, loaded in parallel
+TEST(Performance, load_buckets_2000) {
+    measureLoad(this, ChecksumValidator::Algorithm::CRC32C, 2000, 50);
+}
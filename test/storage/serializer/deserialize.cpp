@@ -22,6 +22,8 @@
 
 #include <istream>
 #include <memory>
+#include <sstream>
+#include <string>
 #include <tuple>
 
 #include <gmock/gmock.h>
@@ -197,3 +199,66 @@ TEST_F(StorageDeserializerFixture, load_buckets_io_error) {
 
     ASSERT_THROW(deserializer.loadBuckets(buckets), BucketDeserializationException);
 }
+
+TEST_F(StorageDeserializerFixture, load_buckets_parallel) {
+    Buckets buckets;
+    const std::size_t bucketsCount = 100;
+    for (std::size_t i = 0; i < bucketsCount; ++i) {
+        const PolicyBucketId bucketId = "bucket" + std::to_string(i);
+        buckets.insert({ bucketId, PolicyBucket(bucketId, PredefinedPolicyType::DENY) });
+    }
+
+    auto streamOpener = [] (const std::string &bucketId)
+                        -> std::shared_ptr<Cynara::BucketDeserializer> {
+        return std::make_shared<BucketDeserializer>(std::make_shared<std::istringstream>(
+            "c;" + bucketId + ";p1;0;\nc;" + bucketId + ";p2;0;\n"));
+    };
+    StorageDeserializer deserializer(nullptr, streamOpener, 4);
+
+    deserializer.loadBuckets(buckets);
+
+    ASSERT_EQ(bucketsCount, buckets.size());
+    for (const auto &bucketIter : buckets) {
+        ASSERT_EQ(2u, bucketIter.second.size());
+        for (const auto &policy : bucketIter.second) {
+            ASSERT_EQ(bucketIter.first, policy->key().user().toString());
+        }
+    }
+}
+
+/**
+ * @brief   Error of the first failed bucket is reported, whichever thread found it first
+ */
+TEST_F(StorageDeserializerFixture, load_buckets_parallel_first_error) {
+    Buckets buckets;
+    for (std::size_t i = 0; i < 100; ++i) {
+        const PolicyBucketId bucketId = "bucket" + std::to_string(i);
+        buckets.insert({ bucketId, PolicyBucket(bucketId, PredefinedPolicyType::DENY) });
+    }
+
+    auto streamOpener = [this] (const std::string &bucketId)
+                        -> std::shared_ptr<Cynara::BucketDeserializer> {
+        if (bucketId == "bucket20" || bucketId == "bucket70") {
+            return nullptr;
+        }
+        return emptyBucketStream();
+    };
+    StorageDeserializer deserializer(nullptr, streamOpener, 4);
+
+    PolicyBucketId firstFailed;
+    for (const auto &bucketIter : buckets) {
+        if (bucketIter.first == "bucket20" || bucketIter.first == "bucket70") {
+            firstFailed = bucketIter.first;
+            break;
+        }
+    }
+
+    for (int repeat = 0; repeat < 10; ++repeat) {
+        try {
+            deserializer.loadBuckets(buckets);
+            FAIL() << "BucketDeserializationException not thrown";
+        } catch (const BucketDeserializationException &ex) {
+            ASSERT_EQ(firstFailed, ex.bucketId());
+        }
+    }
+}
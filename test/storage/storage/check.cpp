@@ -41,7 +41,7 @@
 using namespace Cynara;
 
 TEST(storage, checkEmpty) {
-    using ::testing::ReturnPointee;
+    using ::testing::_;
 
     PolicyBucket emptyBucket("empty");
 
@@ -49,8 +49,8 @@ TEST(storage, checkEmpty) {
     Cynara::Storage storage(backend);
     PolicyKey pk = Helpers::generatePolicyKey();
 
-    EXPECT_CALL(backend, searchBucket(defaultPolicyBucketId, pk))
-        .WillOnce(ReturnPointee(&emptyBucket));
+    EXPECT_CALL(backend, matchBucket(defaultPolicyBucketId, VariantsOf(pk), _))
+        .WillOnce(MatchPointee(&emptyBucket));
 
     // Default bucket empty -- return DENY
     auto policyAnswer = storage.checkPolicy(pk);
@@ -58,7 +58,7 @@ TEST(storage, checkEmpty) {
 }
 
 TEST(storage, checkSimple) {
-    using ::testing::ReturnPointee;
+    using ::testing::_;
 
     PolicyBucket bucket(defaultPolicyBucketId);
     FakeStorageBackend backend;
@@ -66,8 +66,8 @@ TEST(storage, checkSimple) {
     Cynara::Storage storage(backend);
     PolicyKey pk = Helpers::generatePolicyKey();
 
-    EXPECT_CALL(backend, searchBucket(defaultPolicyBucketId, pk))
-        .WillRepeatedly(ReturnPointee(&bucket));
+    EXPECT_CALL(backend, matchBucket(defaultPolicyBucketId, VariantsOf(pk), _))
+        .WillRepeatedly(MatchPointee(&bucket));
 
     // Default bucket empty -- return DENY
     ASSERT_EQ(PredefinedPolicyType::DENY, storage.checkPolicy(pk).policyType());
@@ -83,7 +83,7 @@ TEST(storage, checkSimple) {
 
 // TODO: Refactorize to resemble checkNonrecursive()
 TEST(storage, checkBucket) {
-    using ::testing::ReturnPointee;
+    using ::testing::_;
 
     const PolicyBucketId additionalBucketId = "additional-bucket";
 
@@ -98,11 +98,11 @@ TEST(storage, checkBucket) {
 
     PolicyBucket additionalBucket("additional");
 
-    EXPECT_CALL(backend, searchBucket(defaultPolicyBucketId, pk))
-        .WillRepeatedly(ReturnPointee(&defaultBucket));
+    EXPECT_CALL(backend, matchBucket(defaultPolicyBucketId, VariantsOf(pk), _))
+        .WillRepeatedly(MatchPointee(&defaultBucket));
 
-    EXPECT_CALL(backend, searchBucket(additionalBucketId, pk))
-        .WillRepeatedly(ReturnPointee(&additionalBucket));
+    EXPECT_CALL(backend, matchBucket(additionalBucketId, VariantsOf(pk), _))
+        .WillRepeatedly(MatchPointee(&additionalBucket));
 
 
     // Bucket empty -- should return DENY as default bucket value
@@ -120,8 +120,7 @@ TEST(storage, checkBucket) {
 // Catch a bug, where consecutive buckets were filtered with wildcard policies' keys
 // instead of original key being checked
 TEST(storage, checkBucketWildcard) {
-    using ::testing::Return;
-    using ::testing::ReturnPointee;
+    using ::testing::_;
 
     const PolicyBucketId additionalBucketId = "additional-bucket";
     const PolicyKey defaultBucketKey = PolicyKey("c", "*", "p");
@@ -131,22 +130,24 @@ TEST(storage, checkBucketWildcard) {
         Policy::bucketWithKey(defaultBucketKey, additionalBucketId)
     }));
 
+    PolicyBucket emptyBucket("id");
+
     FakeStorageBackend backend;
     Cynara::Storage storage(backend);
 
-    EXPECT_CALL(backend, searchBucket(defaultPolicyBucketId, checkKey))
-        .WillRepeatedly(ReturnPointee(&defaultBucket));
+    EXPECT_CALL(backend, matchBucket(defaultPolicyBucketId, VariantsOf(checkKey), _))
+        .WillRepeatedly(MatchPointee(&defaultBucket));
 
     // Check, if next bucket is filtered with original key
-    EXPECT_CALL(backend, searchBucket(additionalBucketId, checkKey))
-        .WillRepeatedly(Return(PolicyBucket("id")));    // additional bucket would yield no records
+    EXPECT_CALL(backend, matchBucket(additionalBucketId, VariantsOf(checkKey), _))
+        .WillRepeatedly(MatchPointee(&emptyBucket));    // additional bucket would yield no records
 
     // Should return additional bucket's default policy
     ASSERT_EQ(PredefinedPolicyType::DENY, storage.checkPolicy(checkKey));
 }
 
 TEST(storage, checkBucketWildcardOtherDefault) {
-    using ::testing::ReturnPointee;
+    using ::testing::_;
 
     const PolicyBucketId additionalBucketId = "additional-bucket";
     const PolicyKey defaultBucketKey = PolicyKey("c", "*", "p");
@@ -161,19 +162,19 @@ TEST(storage, checkBucketWildcardOtherDefault) {
     FakeStorageBackend backend;
     Cynara::Storage storage(backend);
 
-    EXPECT_CALL(backend, searchBucket(defaultPolicyBucketId, checkKey))
-        .WillRepeatedly(ReturnPointee(&defaultBucket));
+    EXPECT_CALL(backend, matchBucket(defaultPolicyBucketId, VariantsOf(checkKey), _))
+        .WillRepeatedly(MatchPointee(&defaultBucket));
 
     // Check, if next bucket is filtered with original key
-    EXPECT_CALL(backend, searchBucket(additionalBucketId, checkKey))
-        .WillRepeatedly(ReturnPointee(&additionalBucket));
+    EXPECT_CALL(backend, matchBucket(additionalBucketId, VariantsOf(checkKey), _))
+        .WillRepeatedly(MatchPointee(&additionalBucket));
 
     // Should return additional bucket's default policy
     ASSERT_EQ(PredefinedPolicyType::ALLOW, storage.checkPolicy(checkKey));
 }
 
 TEST(storage, checkNonrecursive) {
-    using ::testing::ReturnPointee;
+    using ::testing::_;
 
     PolicyKey pk = Helpers::generatePolicyKey();
     PolicyBucketId bucketId = "a-bucket";
@@ -184,8 +185,8 @@ TEST(storage, checkNonrecursive) {
 
     Cynara::Storage storage(backend);
 
-    EXPECT_CALL(backend, searchBucket(bucketId, pk))
-        .WillOnce(ReturnPointee(&bucket));
+    EXPECT_CALL(backend, matchBucket(bucketId, VariantsOf(pk), _))
+        .WillOnce(MatchPointee(&bucket));
 
     ASSERT_EQ(PredefinedPolicyType::ALLOW, storage.checkPolicy(pk, bucketId, false));
 }
@@ -196,7 +197,7 @@ TEST(storage, checkNonrecursive) {
  * Because NONE policy in bucket2, check should yield default policy of bucket1 and not of bucket2
  */
 TEST(storage, noneBucket) {
-    using ::testing::ReturnPointee;
+    using ::testing::_;
     using PredefinedPolicyType::ALLOW;
     using PredefinedPolicyType::NONE;
 
@@ -208,10 +209,10 @@ TEST(storage, noneBucket) {
     FakeStorageBackend backend;
     Cynara::Storage storage(backend);
 
-    EXPECT_CALL(backend, searchBucket(bucket1.id(), pk))
-        .WillOnce(ReturnPointee(&bucket1));
-    EXPECT_CALL(backend, searchBucket(bucket2.id(), pk))
-        .WillOnce(ReturnPointee(&bucket2));
+    EXPECT_CALL(backend, matchBucket(bucket1.id(), VariantsOf(pk), _))
+        .WillOnce(MatchPointee(&bucket1));
+    EXPECT_CALL(backend, matchBucket(bucket2.id(), VariantsOf(pk), _))
+        .WillOnce(MatchPointee(&bucket2));
 
     ASSERT_EQ(ALLOW, storage.checkPolicy(pk, bucket1.id(), true));
 }
@@ -221,7 +222,7 @@ TEST(storage, noneBucket) {
  * In this case this policy should be returned.
  */
 TEST(storage, noneBucketNotEmpty) {
-    using ::testing::ReturnPointee;
+    using ::testing::_;
     using PredefinedPolicyType::ALLOW;
     using PredefinedPolicyType::DENY;
     using PredefinedPolicyType::NONE;
@@ -234,10 +235,10 @@ TEST(storage, noneBucketNotEmpty) {
     FakeStorageBackend backend;
     Cynara::Storage storage(backend);
 
-    EXPECT_CALL(backend, searchBucket(bucket1.id(), pk))
-        .WillOnce(ReturnPointee(&bucket1));
-    EXPECT_CALL(backend, searchBucket(bucket2.id(), pk))
-        .WillOnce(ReturnPointee(&bucket2));
+    EXPECT_CALL(backend, matchBucket(bucket1.id(), VariantsOf(pk), _))
+        .WillOnce(MatchPointee(&bucket1));
+    EXPECT_CALL(backend, matchBucket(bucket2.id(), VariantsOf(pk), _))
+        .WillOnce(MatchPointee(&bucket2));
 
     ASSERT_EQ(DENY, storage.checkPolicy(pk, bucket1.id(), true));
 }
@@ -247,7 +248,7 @@ TEST(storage, noneBucketNotEmpty) {
  * -- searching for any key should yield NONE
  */
 TEST(storage, singleNoneBucket) {
-    using ::testing::ReturnPointee;
+    using ::testing::_;
     using PredefinedPolicyType::NONE;
 
     auto pk = Helpers::generatePolicyKey();
@@ -257,8 +258,66 @@ TEST(storage, singleNoneBucket) {
     FakeStorageBackend backend;
     Cynara::Storage storage(backend);
 
-    EXPECT_CALL(backend, searchBucket(bucket.id(), pk))
-        .WillOnce(ReturnPointee(&bucket));
+    EXPECT_CALL(backend, matchBucket(bucket.id(), VariantsOf(pk), _))
+        .WillOnce(MatchPointee(&bucket));
 
     ASSERT_EQ(NONE, storage.checkPolicy(pk, bucket.id(), true));
 }
+
+/*
+ * bucket1 links to bucket2 and bucket3, both of them link to bucket4
+ * -- bucket4 should be searched only once
+ */
+TEST(storage, diamondBuckets) {
+    using ::testing::_;
+    using PredefinedPolicyType::ALLOW;
+    using PredefinedPolicyType::NONE;
+
+    auto pk = Helpers::generatePolicyKey();
+    PolicyKey wildcardPk(pk.client(), PolicyKeyFeature::createWildcard(), pk.privilege());
+
+    PolicyBucket bucket4("bucket-4", ALLOW);
+    PolicyBucket bucket3("bucket-3", NONE, { Policy::bucketWithKey(pk, bucket4.id()) });
+    PolicyBucket bucket2("bucket-2", NONE, { Policy::bucketWithKey(pk, bucket4.id()) });
+    PolicyBucket bucket1("bucket-1", NONE, { Policy::bucketWithKey(pk, bucket2.id()),
+                                             Policy::bucketWithKey(wildcardPk, bucket3.id()) });
+
+    FakeStorageBackend backend;
+    Cynara::Storage storage(backend);
+
+    EXPECT_CALL(backend, matchBucket(bucket1.id(), VariantsOf(pk), _))
+        .WillOnce(MatchPointee(&bucket1));
+    EXPECT_CALL(backend, matchBucket(bucket2.id(), VariantsOf(pk), _))
+        .WillOnce(MatchPointee(&bucket2));
+    EXPECT_CALL(backend, matchBucket(bucket3.id(), VariantsOf(pk), _))
+        .WillOnce(MatchPointee(&bucket3));
+    EXPECT_CALL(backend, matchBucket(bucket4.id(), VariantsOf(pk), _))
+        .WillOnce(MatchPointee(&bucket4));
+
+    ASSERT_EQ(ALLOW, storage.checkPolicy(pk, bucket1.id(), true));
+}
+
+/*
+ * bucket1 links to bucket2, which links back to bucket1 (possible only in loaded database)
+ * -- check should end and yield default policy of bucket2
+ */
+TEST(storage, cycledBuckets) {
+    using ::testing::_;
+    using PredefinedPolicyType::ALLOW;
+    using PredefinedPolicyType::NONE;
+
+    auto pk = Helpers::generatePolicyKey();
+
+    PolicyBucket bucket1("bucket-1", NONE, { Policy::bucketWithKey(pk, "bucket-2") });
+    PolicyBucket bucket2("bucket-2", ALLOW, { Policy::bucketWithKey(pk, bucket1.id()) });
+
+    FakeStorageBackend backend;
+    Cynara::Storage storage(backend);
+
+    EXPECT_CALL(backend, matchBucket(bucket1.id(), VariantsOf(pk), _))
+        .WillOnce(MatchPointee(&bucket1));
+    EXPECT_CALL(backend, matchBucket(bucket2.id(), VariantsOf(pk), _))
+        .WillOnce(MatchPointee(&bucket2));
+
+    ASSERT_EQ(ALLOW, storage.checkPolicy(pk, bucket1.id(), true));
+}
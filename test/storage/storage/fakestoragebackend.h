@@ -27,12 +27,23 @@
 
 using namespace Cynara;
 
+MATCHER_P(VariantsOf, key, "") {
+    return arg.key() == key;
+}
+
+// Fills matches from pointed bucket at the time of call, like ReturnPointee() does
+ACTION_P(MatchPointee, bucket) {
+    bucket->match(arg1, arg2);
+}
+
 class FakeStorageBackend : public StorageBackend {
 public:
     MOCK_METHOD0(load, void(void));
     MOCK_METHOD0(save, void(void));
     MOCK_METHOD1(searchDefaultBucket, PolicyBucket(const PolicyKey &key));
     MOCK_METHOD2(searchBucket, PolicyBucket(const PolicyBucketId &bucket, const PolicyKey &key));
+    MOCK_METHOD3(matchBucket, void(const PolicyBucketId &bucket,
+                                   const PolicyKeyVariants &variants, PolicyMatches &matches));
     MOCK_METHOD2(createBucket, void(const PolicyBucketId &bucketId,
                                     const PolicyResult &defaultPolicy));
     MOCK_METHOD2(updateBucket, void(const PolicyBucketId &bucketId,
@@ -41,6 +52,8 @@ public:
     MOCK_METHOD1(hasBucket, bool(const PolicyBucketId &bucketId));
     MOCK_METHOD2(deletePolicy, void(const PolicyBucketId &bucketId, const PolicyKey &key));
     MOCK_METHOD1(deleteLinking, void(const PolicyBucketId &bucket));
+    MOCK_CONST_METHOD1(getSubBuckets, PolicyBucket::BucketIds(const PolicyBucketId &bucketId));
+    MOCK_CONST_METHOD1(listLinks, PolicyBucket::Policies(const PolicyBucketId &bucketId));
     MOCK_METHOD2(insertPolicy, void(const PolicyBucketId &bucketId, PolicyPtr policy));
     MOCK_CONST_METHOD2(listPolicies, PolicyBucket::Policies(const PolicyBucketId &bucketId,
                                                             const PolicyKey &filter));
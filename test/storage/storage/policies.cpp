@@ -28,6 +28,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <exceptions/BucketLinkCycleException.h>
 #include <exceptions/BucketNotExistsException.h>
 #include <storage/Storage.h>
 #include <storage/StorageBackend.h>
@@ -168,6 +169,123 @@ TEST(storage, insertPointingToNonexistentBucket) {
     ASSERT_THROW(storage.insertPolicies(policiesToInsert), BucketNotExistsException);
 }
 
+TEST(storage, insertCreatingCycle) {
+    using ::testing::_;
+    using ::testing::Return;
+    FakeStorageBackend backend;
+    Storage storage(backend);
+
+    PolicyBucketId bucket1 = "test-bucket-1";
+    PolicyBucketId bucket2 = "test-bucket-2";
+    PolicyBucketId bucket3 = "test-bucket-3";
+
+    // bucket3 already links to bucket1, new policies link bucket1 -> bucket2 -> bucket3
+    std::map<PolicyBucketId, std::vector<Policy>> policiesToInsert = {
+        { bucket1, { Policy(Helpers::generatePolicyKey("1"), { PredefinedPolicyType::BUCKET,
+                                                               bucket2 }) } },
+        { bucket2, { Policy(Helpers::generatePolicyKey("2"), { PredefinedPolicyType::BUCKET,
+                                                               bucket3 }) } },
+    };
+
+    EXPECT_CALL(backend, hasBucket(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(backend, getSubBuckets(bucket1)).WillRepeatedly(Return(PolicyBucket::BucketIds()));
+    EXPECT_CALL(backend, getSubBuckets(bucket2)).WillRepeatedly(Return(PolicyBucket::BucketIds()));
+    EXPECT_CALL(backend, getSubBuckets(bucket3))
+        .WillRepeatedly(Return(PolicyBucket::BucketIds({ bucket1 })));
+    EXPECT_CALL(backend, listLinks(_)).WillRepeatedly(Return(PolicyBucket::Policies()));
+    EXPECT_CALL(backend, insertPolicy(_, _)).Times(0);
+
+    ASSERT_THROW(storage.insertPolicies(policiesToInsert), BucketLinkCycleException);
+}
+
+TEST(storage, setReplacingLinkNotCycle) {
+    using ::testing::_;
+    using ::testing::Return;
+    FakeStorageBackend backend;
+    Storage storage(backend);
+
+    PolicyBucketId bucketA = "test-bucket-a";
+    PolicyBucketId bucketB = "test-bucket-b";
+    PolicyBucketId bucketC = "test-bucket-c";
+    PolicyKey keyK = Helpers::generatePolicyKey("k");
+    PolicyKey keyJ = Helpers::generatePolicyKey("j");
+
+    // B:k -> A is replaced by B:k -> C, while A:j -> B is added; A -> B -> C is acyclic
+    std::map<PolicyBucketId, std::vector<Policy>> policiesToInsert = {
+        { bucketA, { Policy(keyJ, { PredefinedPolicyType::BUCKET, bucketB }) } },
+        { bucketB, { Policy(keyK, { PredefinedPolicyType::BUCKET, bucketC }) } },
+    };
+
+    EXPECT_CALL(backend, hasBucket(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(backend, listLinks(bucketA)).WillRepeatedly(Return(PolicyBucket::Policies()));
+    EXPECT_CALL(backend, listLinks(bucketB)).WillRepeatedly(Return(PolicyBucket::Policies({
+        Policy(keyK, { PredefinedPolicyType::BUCKET, bucketA }) })));
+    EXPECT_CALL(backend, getSubBuckets(bucketC))
+        .WillRepeatedly(Return(PolicyBucket::BucketIds()));
+    EXPECT_CALL(backend, insertPolicy(_, _)).Times(2);
+
+    ASSERT_NO_THROW(storage.insertPolicies(policiesToInsert));
+}
+
+TEST(storage, setRemovingLinkNotCycle) {
+    using ::testing::_;
+    using ::testing::Return;
+    FakeStorageBackend backend;
+    Storage storage(backend);
+
+    PolicyBucketId bucketA = "test-bucket-a";
+    PolicyBucketId bucketB = "test-bucket-b";
+    PolicyKey keyK = Helpers::generatePolicyKey("k");
+    PolicyKey keyJ = Helpers::generatePolicyKey("j");
+
+    // B:k -> A is removed by the same request, which adds A:j -> B
+    std::map<PolicyBucketId, std::vector<Policy>> policiesToInsert = {
+        { bucketA, { Policy(keyJ, { PredefinedPolicyType::BUCKET, bucketB }) } },
+    };
+    std::map<PolicyBucketId, std::vector<PolicyKey>> keysToRemove = {
+        { bucketB, { keyK } },
+    };
+
+    EXPECT_CALL(backend, hasBucket(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(backend, listLinks(bucketA)).WillRepeatedly(Return(PolicyBucket::Policies()));
+    EXPECT_CALL(backend, listLinks(bucketB)).WillRepeatedly(Return(PolicyBucket::Policies({
+        Policy(keyK, { PredefinedPolicyType::BUCKET, bucketA }) })));
+    EXPECT_CALL(backend, insertPolicy(bucketA, _));
+    EXPECT_CALL(backend, deletePolicy(bucketB, keyK));
+
+    ASSERT_NO_THROW(storage.setPolicies(policiesToInsert, keysToRemove));
+}
+
+TEST(storage, setKeepingLinkCycle) {
+    using ::testing::_;
+    using ::testing::Return;
+    FakeStorageBackend backend;
+    Storage storage(backend);
+
+    PolicyBucketId bucketA = "test-bucket-a";
+    PolicyBucketId bucketB = "test-bucket-b";
+    PolicyKey keyK = Helpers::generatePolicyKey("k");
+    PolicyKey keyL = Helpers::generatePolicyKey("l");
+    PolicyKey keyJ = Helpers::generatePolicyKey("j");
+
+    // B:k -> A stays, only other policy of B is removed
+    std::map<PolicyBucketId, std::vector<Policy>> policiesToInsert = {
+        { bucketA, { Policy(keyJ, { PredefinedPolicyType::BUCKET, bucketB }) } },
+    };
+    std::map<PolicyBucketId, std::vector<PolicyKey>> keysToRemove = {
+        { bucketB, { keyL } },
+    };
+
+    EXPECT_CALL(backend, hasBucket(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(backend, listLinks(bucketA)).WillRepeatedly(Return(PolicyBucket::Policies()));
+    EXPECT_CALL(backend, listLinks(bucketB)).WillRepeatedly(Return(PolicyBucket::Policies({
+        Policy(keyK, { PredefinedPolicyType::BUCKET, bucketA }) })));
+    EXPECT_CALL(backend, insertPolicy(_, _)).Times(0);
+    EXPECT_CALL(backend, deletePolicy(_, _)).Times(0);
+
+    ASSERT_THROW(storage.setPolicies(policiesToInsert, keysToRemove), BucketLinkCycleException);
+}
+
 TEST(storage, listPolicies) {
     using ::testing::Return;
     using PredefinedPolicyType::DENY;
@@ -49,3 +49,68 @@ TEST(PolicyKey, to_string) {
     PolicyKey pk5(PKF::createWildcard(), PKF::create("u"), PKF::createAny());
     ASSERT_EQ(CYNARA_ADMIN_WILDCARD "\tu\t" CYNARA_ADMIN_ANY, pk5.toString());
 }
+
+TEST(PolicyKey, features_share_symbols) {
+    typedef Cynara::PolicyKeyFeature PKF;
+
+    auto c1 = PKF::create("shared_client");
+    auto c2 = PKF::create("shared_client");
+    auto c3 = PKF::create("other_client");
+
+    ASSERT_EQ(c1.id(), c2.id());
+    ASSERT_EQ(&c1.value(), &c2.value());
+    ASSERT_NE(c1.id(), c3.id());
+    ASSERT_EQ(c1, c2);
+    ASSERT_FALSE(c1 == c3);
+    ASSERT_EQ(c1, "shared_client");
+}
+
+TEST(PolicyKey, symbols_released_with_features) {
+    typedef Cynara::PolicyKeyFeature PKF;
+
+    auto &symbols = SymbolTable::instance();
+    auto sizeBefore = symbols.size();
+    {
+        auto f1 = PKF::create("released_feature");
+        ASSERT_EQ(sizeBefore + 1, symbols.size());
+
+        auto f2 = f1;
+        f1 = PKF::create("another_released_feature");
+        ASSERT_EQ(sizeBefore + 2, symbols.size());
+        ASSERT_EQ("released_feature", f2.value());
+    }
+    ASSERT_EQ(sizeBefore, symbols.size());
+}
+
+TEST(PolicyKey, moved_features_keep_symbols) {
+    typedef Cynara::PolicyKeyFeature PKF;
+
+    auto &symbols = SymbolTable::instance();
+    auto sizeBefore = symbols.size();
+    {
+        auto f1 = PKF::create("moved_feature");
+        auto id = f1.id();
+
+        auto f2 = std::move(f1);
+        ASSERT_EQ(id, f2.id());
+        ASSERT_EQ("", f1.value());
+        ASSERT_EQ(sizeBefore + 1, symbols.size());
+
+        f1 = std::move(f2);
+        ASSERT_EQ("moved_feature", f1.value());
+    }
+    ASSERT_EQ(sizeBefore, symbols.size());
+}
+
+TEST(PolicyKey, uninterned_keys_compare_by_value) {
+    auto &symbols = SymbolTable::instance();
+    auto sizeBefore = symbols.size();
+
+    PolicyKey uninterned("uninterned_client", "u", "p", PolicyKeyFeature::Uninterned());
+    ASSERT_EQ(sizeBefore, symbols.size());
+
+    PolicyKey interned("uninterned_client", "u", "p");
+    ASSERT_EQ(interned, uninterned);
+    ASSERT_EQ(uninterned, PolicyKey(uninterned));
+    ASSERT_FALSE(uninterned == PolicyKey("other_client", "u", "p", PolicyKeyFeature::Uninterned()));
+}